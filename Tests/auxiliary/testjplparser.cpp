@@ -0,0 +1,144 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testjplparser.h"
+
+#include "ksutils.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <stdexcept>
+
+namespace
+{
+QTemporaryDir tempDir;
+}
+
+QString TestJPLParser::writeTemp(const QByteArray &content)
+{
+    static int counter = 0;
+    QString path = tempDir.filePath(QString("jpl%1.json").arg(counter++));
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return QString();
+    file.write(content);
+    return path;
+}
+
+void TestJPLParser::testRows()
+{
+    const QString path = writeTemp(
+                             "{\"signature\":{\"source\":\"NASA/JPL Small-Body Database (SBDB) Query API\",\"version\":\"1.0\"},\n"
+                             " \"count\":2,\n"
+                             " \"fields\":[\"full_name\",\"neo\",\"H\",\"epoch_mjd\",\"extent\"],\n"
+                             " \"data\":[\n"
+                             "  [\"     1 Ceres (A801 AA)\",\"N\",\"3.33\",\"60600\",\"964.4x964.2x891.8\"],\n"
+                             "  [\"  2 \\\"Pallas\\\" \\u00e9\" , \"Y\" , null , \"60600\" , null ]\n"
+                             " ]}");
+
+    KSUtils::JPLParser parser(path);
+    QCOMPARE(parser.count(), 2);
+    QCOMPARE(parser.column("H"), 2);
+    QCOMPARE(parser.column("missing"), -1);
+
+    QStringList names;
+    QVector<double> H;
+    QVector<bool> nullExtent;
+    parser.for_each([&](const auto & get)
+    {
+        names << get(parser.column("full_name")).toString().trimmed();
+        H << get("H").toDouble();
+        nullExtent << get("extent").isNull();
+        QCOMPARE(get("epoch_mjd").toInt(), 60600);
+        QVERIFY(get("missing").isNull());
+    });
+
+    QCOMPARE(names, QStringList({"1 Ceres (A801 AA)", QString("2 \"Pallas\" ") + QChar(0xe9)}));
+    QCOMPARE(H, QVector<double>({3.33, 0.0}));
+    QCOMPARE(nullExtent, QVector<bool>({false, true}));
+
+    // A second pass starts over.
+    int rows = 0;
+    parser.for_each([&](const auto &)
+    {
+        rows++;
+    });
+    QCOMPARE(rows, 2);
+}
+
+void TestJPLParser::testOldFormat()
+{
+    // Older exports put "data" first and wrote some fields as JSON numbers.
+    const QString path = writeTemp("{\"data\":[[\"433 Eros\",59000.0,1.76]],\"fields\":[\"full_name\",\"epoch.mjd\",\"per.y\"]}");
+
+    KSUtils::JPLParser parser(path);
+    int rows = 0;
+    parser.for_each([&](const auto & get)
+    {
+        rows++;
+        QCOMPARE(get("epoch.mjd").toInt(), 59000);
+        QCOMPARE(get("per.y").toFloat(), 1.76f);
+        QCOMPARE(get("full_name").toString(), QString("433 Eros"));
+    });
+    QCOMPARE(rows, 1);
+}
+
+void TestJPLParser::testMalformed_data()
+{
+    QTest::addColumn<QByteArray>("content");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("array") << QByteArray("[1,2]");
+    QTest::newRow("no data") << QByteArray("{\"fields\":[\"a\"]}");
+    QTest::newRow("truncated") << QByteArray("{\"fields\":[\"a\"],\"data\":[[\"1\"],[\"2");
+}
+
+void TestJPLParser::testMalformed()
+{
+    QFETCH(QByteArray, content);
+    const QString path = writeTemp(content);
+
+    bool thrown = false;
+    try
+    {
+        KSUtils::JPLParser parser(path);
+        parser.for_each([](const auto &) {});
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
+
+void TestJPLParser::testMatchesQJsonDocument()
+{
+    QJsonArray fields { "full_name", "a", "e", "class" };
+    QJsonArray data;
+    for (int i = 0; i < 5000; i++)
+        data.append(QJsonArray { QString("%1 Body%1").arg(i), QString::number(2.0 + i * 1e-4, 'g', 17),
+                                 QString::number(i * 1e-5, 'g', 17), i % 3 ? QJsonValue("MBA") : QJsonValue() });
+    QJsonObject root { { "count", static_cast<int>(data.size()) }, { "fields", fields }, { "data", data } };
+    const QString path = writeTemp(QJsonDocument(root).toJson());
+
+    KSUtils::JPLParser parser(path);
+    int i = 0;
+    parser.for_each([&](const auto & get)
+    {
+        const QJsonArray row = data.at(i++).toArray();
+        QCOMPARE(get(0).toString(), row.at(0).toString());
+        QCOMPARE(get(1).toDouble(), row.at(1).toString().toDouble());
+        QCOMPARE(get(2).toDouble(), row.at(2).toString().toDouble());
+        QCOMPARE(get(3).isNull(), row.at(3).isNull());
+        QCOMPARE(get(3).toString(), row.at(3).toString());
+    });
+    QCOMPARE(i, data.size());
+}
+
+QTEST_GUILESS_MAIN(TestJPLParser)
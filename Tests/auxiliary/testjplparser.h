@@ -0,0 +1,31 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QtGlobal>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <QtTest/QTest>
+#else
+#include <QTest>
+#endif
+
+class TestJPLParser : public QObject
+{
+        Q_OBJECT
+    public:
+        TestJPLParser() = default;
+
+    private slots:
+        void testRows();
+        void testOldFormat();
+        void testMalformed_data();
+        void testMalformed();
+        void testMatchesQJsonDocument();
+
+    private:
+        QString writeTemp(const QByteArray &content);
+};
@@ -0,0 +1,163 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for skyobjectnameindex.cpp
+*/
+
+#include "testskyobjectnameindex.h"
+#include "auxiliary/skyobjectnameindex.h"
+
+#include <QtGlobal>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <QtTest/QTest>
+#else
+#include <QTest>
+#endif
+
+namespace
+{
+// The index never touches the objects, any distinct pointer will do
+const SkyObject *object(int i)
+{
+    return reinterpret_cast<const SkyObject *>(quintptr(i + 1));
+}
+
+SkyObjectNameIndex::EntryList entries(const QStringList &names, int offset = 0)
+{
+    SkyObjectNameIndex::EntryList list;
+    for (int i = 0; i < names.size(); ++i)
+        list.append(qMakePair(names[i], object(offset + i)));
+    return list;
+}
+
+QStringList names(const SkyObjectNameIndex::Result &result)
+{
+    QStringList names;
+    for (const auto &entry : result.entries)
+        names << entry.first;
+    return names;
+}
+}
+
+TestSkyObjectNameIndex::TestSkyObjectNameIndex(QObject * parent): QObject(parent)
+{
+}
+
+void TestSkyObjectNameIndex::testFind()
+{
+    SkyObjectNameIndex index;
+    const auto stars   = entries({ "Vega", "Sirius", "alpha Centauri", "Altair" });
+    const auto planets = entries({ "Mars", "Saturn", "Venus" }, 100);
+    index.update(0, stars);
+    index.update(1, planets);
+
+    QCOMPARE(index.size({ 0, 1 }), 7);
+
+    // Everything, merged and sorted ignoring the case
+    auto result = index.find({ 0, 1 }, "");
+    QCOMPARE(names(result), QStringList({ "alpha Centauri", "Altair", "Mars", "Saturn", "Sirius", "Vega", "Venus" }));
+    QCOMPARE(result.prefixMatch, -1);
+
+    // Substrings, ignoring the case
+    result = index.find({ 0, 1 }, "AL");
+    QCOMPARE(names(result), QStringList({ "alpha Centauri", "Altair" }));
+    QCOMPARE(result.prefixMatch, 0);
+    QVERIFY(!result.exactMatch);
+
+    result = index.find({ 0, 1 }, "ur");
+    QCOMPARE(names(result), QStringList({ "alpha Centauri", "Saturn" }));
+    QCOMPARE(result.prefixMatch, -1);
+
+    result = index.find({ 0, 1 }, "venus");
+    QCOMPARE(names(result), QStringList({ "Venus" }));
+    QCOMPARE(result.prefixMatch, 0);
+    QVERIFY(result.exactMatch);
+    QCOMPARE(result.entries[0].second, object(102));
+
+    // Only the given types
+    QCOMPARE(names(index.find({ 1 }, "a")), QStringList({ "Mars", "Saturn" }));
+    QVERIFY(index.find({ 2 }, "a").entries.isEmpty());
+}
+
+void TestSkyObjectNameIndex::testRefine()
+{
+    SkyObjectNameIndex index;
+    index.update(0, entries({ "M 31", "M 33", "M 13", "NGC 3132", "IC 434" }));
+
+    QCOMPARE(names(index.find({ 0 }, "3")), QStringList({ "IC 434", "M 13", "M 31", "M 33", "NGC 3132" }));
+    QCOMPARE(names(index.find({ 0 }, "31")), QStringList({ "M 31", "NGC 3132" }));
+    QCOMPARE(names(index.find({ 0 }, "m 31")), QStringList({ "M 31" }));
+
+    // Not a refinement of the last text, starts over
+    QCOMPARE(names(index.find({ 0 }, "13")), QStringList({ "M 13", "NGC 3132" }));
+    QCOMPARE(names(index.find({ 0 }, "4")), QStringList({ "IC 434" }));
+}
+
+void TestSkyObjectNameIndex::testUpdate()
+{
+    SkyObjectNameIndex index;
+    auto list = entries({ "Mizar", "Alcor" });
+    index.update(0, list);
+    QCOMPARE(names(index.find({ 0 }, "r")), QStringList({ "Alcor", "Mizar" }));
+
+    // Appended names are sorted in
+    list.append(qMakePair(QString("Arcturus"), object(10)));
+    index.update(0, list);
+    QCOMPARE(names(index.find({ 0 }, "r")), QStringList({ "Alcor", "Arcturus", "Mizar" }));
+
+    // Removed names are gone
+    list.removeFirst();
+    index.update(0, list);
+    QCOMPARE(names(index.find({ 0 }, "r")), QStringList({ "Alcor", "Arcturus" }));
+
+    list.clear();
+    index.update(0, list);
+    QVERIFY(index.find({ 0 }, "").entries.isEmpty());
+}
+
+void TestSkyObjectNameIndex::testLargeList()
+{
+    // Numbered asteroids in no particular order, every name twice
+    const int count = 200000;
+    const auto asteroid = [count](int i)
+    {
+        const int number = int((qint64(i) * 7919) % count) / 2 + 1;
+        return qMakePair(QString("(%1) %2").arg(number).arg(i % 2 ? "Minor" : "minor"), object(i));
+    };
+
+    SkyObjectNameIndex::EntryList list;
+    for (int i = 0; i < count; ++i)
+        list.append(asteroid(i));
+
+    const auto verify = [](const SkyObjectNameIndex::Result &result, int size)
+    {
+        QCOMPARE(result.entries.size(), size);
+        for (int i = 1; i < result.entries.size(); ++i)
+        {
+            const auto &previous = result.entries[i - 1];
+            const auto &entry    = result.entries[i];
+            const int order      = previous.first.toCaseFolded().compare(entry.first.toCaseFolded());
+            // Equal names keep the order of the list
+            QVERIFY(order < 0 || (order == 0 && previous.second < entry.second));
+        }
+    };
+
+    SkyObjectNameIndex index;
+    index.update(0, list);
+    verify(index.find({ 0 }, ""), count);
+
+    // A large batch appended out of order is merged in
+    for (int i = count; i < count + count / 4; ++i)
+        list.append(asteroid(i));
+    index.update(0, list);
+    verify(index.find({ 0 }, ""), count + count / 4);
+
+    const auto result = index.find({ 0 }, "(4242) minor");
+    QCOMPARE(result.entries.size(), 2);
+    QCOMPARE(result.prefixMatch, 0);
+    QVERIFY(result.exactMatch);
+}
+
+QTEST_GUILESS_MAIN(TestSkyObjectNameIndex)
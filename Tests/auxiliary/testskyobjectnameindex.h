@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for skyobjectnameindex.cpp
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestSkyObjectNameIndex: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestSkyObjectNameIndex(QObject * parent = nullptr);
+
+    private slots:
+        void testFind();
+        void testRefine();
+        void testUpdate();
+        void testLargeList();
+};
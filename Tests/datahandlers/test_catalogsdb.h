@@ -99,6 +99,42 @@ class TestCatalogsDB_DBManager : public QObject
         QCOMPARE(obj.name(), objs.front().name());
     }
 
+    void find_by_name_substring()
+    {
+        auto success = m_manager.add_object(0, SkyObject::GALAXY, dms{ 0 }, dms{ 0 },
+                                            "Substring Test", 5, "Long Substring");
+        QVERIFY(success.first);
+        success = m_manager.add_object(0, SkyObject::GALAXY, dms{ 1 }, dms{ 0 },
+                                       "Another", 6, "Quoted \"Subs\" Test");
+        QVERIFY(success.first);
+
+        const auto names = [&](const QString &query)
+        {
+            QStringList names;
+            for (const auto &obj : m_manager.find_objects_by_name(query))
+                names << obj.name();
+            return names;
+        };
+
+        // substrings of names and long names, ignoring the case
+        for (const auto &query : { "substring", "STRING TE", "bstr", "ng S" })
+        {
+            QVERIFY2(names(query).contains("Substring Test"), query);
+            QVERIFY2(!names(query).contains("Another"), query);
+        }
+
+        // quotes are part of the name, not of the index query
+        QCOMPARE(names("\"subs\""), QStringList{ "Another" });
+
+        // short queries scan the master catalog instead
+        QVERIFY(m_manager.find_objects_by_name("st").size() > 0);
+
+        success = m_manager.remove_object(0, CatalogObject::getId(SkyObject::GALAXY, 0, 0,
+                                                                  "Substring Test", ""));
+        QVERIFY(success.first);
+        QCOMPARE(m_manager.find_objects_by_name("substring").size(), 0);
+    }
+
     void get_by_id()
     {
         const auto &obj     = some_object();
@@ -384,6 +420,52 @@ class TestCatalogsDB_DBManager : public QObject
         QCOMPARE(m_manager.find_objects_by_name(0, "tester_1", 1).size(), 0);
     }
 
+    void incremental_master_catalog()
+    {
+        const auto master = [&]()
+        {
+            std::vector<std::pair<QByteArray, int>> objs;
+            for (const auto &obj : m_manager.get_objects_all())
+                objs.emplace_back(obj.getObjectId(), obj.catalogId());
+
+            std::sort(objs.begin(), objs.end());
+            return objs;
+        };
+
+        // the incremental updates have to agree with a full rebuild
+        const auto rebuilt = [&]()
+        {
+            const auto objs = master();
+            return m_manager.compile_master_catalog() && objs == master();
+        };
+
+        QVERIFY(m_manager.compile_master_catalog());
+
+        int steps{ 0 };
+        m_manager.set_progress_callback([&](int done, int total) {
+            QVERIFY(done <= total);
+            steps++;
+        });
+
+        for (const auto &cat : m_manager.get_catalogs(true))
+        {
+            for (const auto enable : { !cat.enabled, cat.enabled })
+            {
+                QVERIFY(m_manager.set_catalog_enabled(cat.id, enable).first);
+                QVERIFY(rebuilt());
+            }
+        }
+        QVERIFY(steps > 0);
+
+        const CatalogObject o{ {}, SkyObject::STAR, dms{ 0 }, dms{ 0 }, 0, "incremental" };
+        QVERIFY(m_manager.add_object(0, o).first);
+        QVERIFY(rebuilt());
+
+        QVERIFY(m_manager.remove_object(0, o.getObjectId()).first);
+        QVERIFY(rebuilt());
+        m_manager.set_progress_callback({});
+    }
+
     void add_objects()
     {
         const Catalog cat{ m_manager.find_suitable_catalog_id(),
@@ -436,6 +518,41 @@ class TestCatalogsDB_DBManager : public QObject
         }
     }
 
+    void add_objects_cancelled()
+    {
+        const Catalog cat{ m_manager.find_suitable_catalog_id(),
+                           "test",
+                           1,
+                           "tester",
+                           "test catalog",
+                           "testing catalog",
+                           true,
+                           false,
+                           100 };
+
+        QVERIFY(m_manager.register_catalog(cat).first);
+
+        std::vector<CatalogObject> objects;
+        for (int i = 0; i < 10000; i++)
+            objects.emplace_back(CatalogObject::oid{}, SkyObject::STAR, dms{ i % 360 },
+                                 dms{ 0 }, 1, QString("cancelled_%1").arg(i));
+
+        int reported{ 0 };
+        m_manager.set_progress_callback([&](int done, int total) {
+            QCOMPARE(total, static_cast<int>(objects.size()));
+            reported = done;
+        });
+
+        const auto success =
+            m_manager.add_objects(cat.id, objects, [&]() { return reported > 0; });
+        m_manager.set_progress_callback({});
+
+        QVERIFY(!success.first);
+        QVERIFY(reported > 0);
+        QVERIFY(reported < static_cast<int>(objects.size()));
+        QCOMPARE(m_manager.get_catalog_statistics(cat.id).second.total_count, 0);
+    }
+
     void concurrent_query()
     {
         auto f1 = QtConcurrent::run([&] {
@@ -0,0 +1,195 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QtGlobal>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <QtTest/QTest>
+#else
+#include <QTest>
+#endif
+
+#include <QFile>
+#include <QObject>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include "ekos/analyze/analyzelog.h"
+
+using Ekos::AnalyzeLog;
+
+class TestAnalyzeLog : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestAnalyzeLog();
+
+        /** @short Destructor */
+        ~TestAnalyzeLog() override = default;
+
+    private slots:
+        void initTestCase();
+        void testParse();
+        void testChunks();
+        void testIndex();
+
+    private:
+        bool writeLog(const QString &filename, const QByteArray &contents);
+
+        QTemporaryDir m_Dir;
+};
+
+#include "testanalyzelog.moc"
+
+TestAnalyzeLog::TestAnalyzeLog() : QObject()
+{
+}
+
+void TestAnalyzeLog::initTestCase()
+{
+    // Keep the side indexes out of the user's cache.
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_Dir.isValid());
+}
+
+bool TestAnalyzeLog::writeLog(const QString &filename, const QByteArray &contents)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(contents) == contents.size();
+}
+
+void TestAnalyzeLog::testParse()
+{
+    const QString filename = m_Dir.filePath("parse.analyze");
+    QVERIFY(writeLog(filename,
+                     "#KStars version 3.7.0. Analyze log version 1.0.\n"
+                     "\n"
+                     "AnalyzeStartTime,2026-01-01 20:00:00.000,CET\n"
+                     "GuideStats,1.500,0.25,-0.5,10,-20,35.5,1200,4\r\n"
+                     "MountCoords,2.000,83.82,-5.39,135.2,38.1,1\n"
+                     "MountCoords,2.500,83.82,-5.39,135.2,38.1,0,1.25\n"
+                     "GuideStats,3.000,bad,-0.5,10,-20,35.5,1200,4\n"
+                     "GuideStats,-1,0.25,-0.5,10,-20,35.5,1200,4\n"
+                     "GuideStats,4.000,0.25,-0.5,10,-20,35.5,1200\n"
+                     "CaptureStarting,5.000,60,Red\n"
+                     "GuideStats,6.000,0.1,0.2,3,4,5,6,7"));
+
+    AnalyzeLog log(filename);
+    QVERIFY(log.open(false));
+    QVERIFY(!log.indexLoaded());
+
+    const auto &records = log.records();
+    QCOMPARE(records.size(), 7);
+
+    QCOMPARE(records[0].type, AnalyzeLog::LINE);
+    QCOMPARE(log.line(records[0]), QString("AnalyzeStartTime,2026-01-01 20:00:00.000,CET"));
+
+    QCOMPARE(records[1].type, AnalyzeLog::GUIDE_STATS);
+    const double *guide = log.values(records[1]);
+    const double expectedGuide[] = {1.5, 0.25, -0.5, 10, -20, 35.5, 1200, 4};
+    for (int i = 0; i < AnalyzeLog::GUIDE_STATS_VALUES; i++)
+        QCOMPARE(guide[i], expectedGuide[i]);
+    // The carriage return is not part of the line.
+    QCOMPARE(log.line(records[1]), QString("GuideStats,1.500,0.25,-0.5,10,-20,35.5,1200,4"));
+
+    QCOMPARE(records[2].type, AnalyzeLog::MOUNT_COORDS);
+    QCOMPARE(log.values(records[2])[5], 1.0);
+    QCOMPARE(log.values(records[2])[6], 0.0);
+    QCOMPARE(records[3].type, AnalyzeLog::MOUNT_COORDS);
+    QCOMPARE(log.values(records[3])[6], 1.25);
+
+    // Malformed and out of range stats are dropped, a wrong field count is left to processInputLine().
+    QCOMPARE(records[4].type, AnalyzeLog::LINE);
+    QCOMPARE(log.line(records[4]), QString("GuideStats,4.000,0.25,-0.5,10,-20,35.5,1200"));
+    QCOMPARE(log.line(records[5]), QString("CaptureStarting,5.000,60,Red"));
+
+    // The last line has no line terminator.
+    QCOMPARE(records[6].type, AnalyzeLog::GUIDE_STATS);
+    QCOMPARE(log.values(records[6])[0], 6.0);
+    QCOMPARE(log.values(records[6])[7], 7.0);
+}
+
+void TestAnalyzeLog::testChunks()
+{
+    // Large enough to be parsed in several chunks.
+    const int lines = 100000;
+    QByteArray contents;
+    for (int i = 0; i < lines; i++)
+    {
+        contents += QString("GuideStats,%1,%2,%3,%4,0,30,1000,3\n").arg(i).arg(i * 0.001).arg(-i * 0.002).arg(i % 100).toLatin1();
+        if (i % 1000 == 0)
+            contents += QString("GuideState,%1,Guiding\n").arg(i).toLatin1();
+    }
+    QVERIFY(contents.size() > 2 * 1024 * 1024);
+
+    const QString filename = m_Dir.filePath("chunks.analyze");
+    QVERIFY(writeLog(filename, contents));
+
+    AnalyzeLog log(filename);
+    QVERIFY(log.open(false));
+    QCOMPARE(log.records().size(), lines + lines / 1000);
+
+    int guideStats = 0;
+    double lastTime = -1;
+    for (const auto &record : log.records())
+    {
+        if (record.type == AnalyzeLog::LINE)
+        {
+            QVERIFY(log.line(record).startsWith("GuideState,"));
+            continue;
+        }
+        QCOMPARE(record.type, AnalyzeLog::GUIDE_STATS);
+        const double *values = log.values(record);
+        QCOMPARE(values[0], static_cast<double>(guideStats));
+        QVERIFY(values[0] > lastTime);
+        QCOMPARE(values[3], static_cast<double>(guideStats % 100));
+        lastTime = values[0];
+        guideStats++;
+    }
+    QCOMPARE(guideStats, lines);
+}
+
+void TestAnalyzeLog::testIndex()
+{
+    const QString filename = m_Dir.filePath("index.analyze");
+    QVERIFY(writeLog(filename, "GuideStats,1,0.25,-0.5,10,-20,35.5,1200,4\nGuideState,2,Guiding\nMountCoords,3,1,2,3,4,0,5\n"));
+    QFile::remove(AnalyzeLog::indexPath(filename));
+
+    QVector<AnalyzeLog::Record> parsed;
+    {
+        AnalyzeLog log(filename);
+        QVERIFY(log.open());
+        QVERIFY(!log.indexLoaded());
+        parsed = log.records();
+    }
+    QVERIFY(QFile::exists(AnalyzeLog::indexPath(filename)));
+
+    {
+        AnalyzeLog log(filename);
+        QVERIFY(log.open());
+        QVERIFY(log.indexLoaded());
+        QCOMPARE(log.records().size(), parsed.size());
+        for (int i = 0; i < parsed.size(); i++)
+        {
+            QCOMPARE(log.records()[i].type, parsed[i].type);
+            QCOMPARE(log.records()[i].offset, parsed[i].offset);
+        }
+        QCOMPARE(log.line(log.records()[1]), QString("GuideState,2,Guiding"));
+        QCOMPARE(log.values(log.records()[2])[6], 5.0);
+    }
+
+    // A log that changed is parsed again.
+    QVERIFY(writeLog(filename, "GuideState,2,Guiding\n"));
+    AnalyzeLog log(filename);
+    QVERIFY(log.open());
+    QVERIFY(!log.indexLoaded());
+    QCOMPARE(log.records().size(), 1);
+}
+
+QTEST_GUILESS_MAIN(TestAnalyzeLog)
@@ -0,0 +1,255 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QtGlobal>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <QtTest/QTest>
+#else
+#include <QTest>
+#endif
+
+#include <QCborMap>
+#include <QCborValue>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QObject>
+
+#include "ekos/ekoslive/statechannel.h"
+
+// Replays a recorded EkosLive session through the JSON and the compact state protocols.
+
+class TestStateChannel : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestStateChannel();
+
+        /** @short Destructor */
+        ~TestStateChannel() override = default;
+
+    private slots:
+        void testDelta();
+        void testResync();
+        void testReplay();
+
+    private:
+        struct Event
+        {
+            qint64 ms;
+            QString type;
+            QJsonObject payload;
+            bool throttle;
+        };
+
+        // Apply a frame the way a client does, returns the number of topics in it.
+        static int apply(const QByteArray &frame, QHash<QString, QJsonObject> &states, bool *full = nullptr);
+        static QList<Event> loadSession(const QString &filename);
+};
+
+#include "teststatechannel.moc"
+
+TestStateChannel::TestStateChannel() : QObject()
+{
+}
+
+int TestStateChannel::apply(const QByteArray &frame, QHash<QString, QJsonObject> &states, bool *full)
+{
+    const QCborMap map = QCborValue::fromCbor(frame).toMap();
+    if (full)
+        *full = map.value(QStringLiteral("full")).toBool();
+
+    const QCborMap payload = map.value(QStringLiteral("payload")).toMap();
+    for (auto topic = payload.constBegin(); topic != payload.constEnd(); ++topic)
+    {
+        QJsonObject &state = states[topic.key().toString()];
+        const QJsonObject delta = topic.value().toMap().toJsonObject();
+        for (auto it = delta.constBegin(); it != delta.constEnd(); ++it)
+            state.insert(it.key(), it.value());
+    }
+    return payload.size();
+}
+
+QList<TestStateChannel::Event> TestStateChannel::loadSession(const QString &filename)
+{
+    QList<Event> events;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return events;
+
+    while (!file.atEnd())
+    {
+        const QJsonObject line = QJsonDocument::fromJson(file.readLine()).object();
+        if (line.isEmpty())
+            continue;
+        events.append({line["ms"].toVariant().toLongLong(), line["type"].toString(), line["payload"].toObject(),
+                       line["throttle"].toBool()});
+    }
+    return events;
+}
+
+void TestStateChannel::testDelta()
+{
+    EkosLive::StateChannel channel("new_state_delta");
+    QHash<QString, QJsonObject> states;
+
+    QVERIFY(!channel.hasPending());
+    QVERIFY(channel.flush().isEmpty());
+
+    channel.update("new_mount_state", {{"ra", 10.5}, {"de", -5.0}, {"status", "Tracking"}});
+    channel.update("new_mount_state", {{"ra", 10.6}});
+    QVERIFY(channel.hasPending());
+
+    QByteArray frame = channel.flush();
+    QVERIFY(!frame.isEmpty());
+    QCOMPARE(apply(frame, states), 1);
+    QCOMPARE(states["new_mount_state"], QJsonObject({{"ra", 10.6}, {"de", -5.0}, {"status", "Tracking"}}));
+
+    // Nothing changed, nothing is sent.
+    channel.update("new_mount_state", {{"ra", 10.6}, {"status", "Tracking"}});
+    QVERIFY(!channel.hasPending());
+    QVERIFY(channel.flush().isEmpty());
+
+    // A change that is reverted before the flush is dropped.
+    channel.update("new_mount_state", {{"status", "Slewing"}});
+    channel.update("new_mount_state", {{"status", "Tracking"}});
+    QVERIFY(!channel.hasPending());
+
+    // Only the changed key of the changed topic is sent.
+    channel.update("new_mount_state", {{"de", -5.1}, {"ra", 10.6}});
+    channel.update("new_guide_state", {{"status", "Guiding"}});
+    frame = channel.flush();
+    const QCborMap payload = QCborValue::fromCbor(frame).toMap().value(QStringLiteral("payload")).toMap();
+    QCOMPARE(payload.size(), 2);
+    QCOMPARE(payload.value(QStringLiteral("new_mount_state")).toMap().toJsonObject(), QJsonObject({{"de", -5.1}}));
+
+    QCOMPARE(apply(frame, states), 2);
+    QCOMPARE(states["new_mount_state"]["de"].toDouble(), -5.1);
+    QCOMPARE(states["new_guide_state"]["status"].toString(), QString("Guiding"));
+}
+
+void TestStateChannel::testResync()
+{
+    EkosLive::StateChannel channel("new_state_delta");
+    channel.update("new_mount_state", {{"ra", 10.5}, {"de", -5.0}});
+    channel.update("new_focus_state", {{"status", "Idle"}});
+    channel.flush();
+
+    // A newly connected client gets everything, including topics without changes.
+    channel.resync();
+    channel.update("new_mount_state", {{"ra", 11.0}});
+    QVERIFY(channel.hasPending());
+
+    QHash<QString, QJsonObject> states;
+    bool full = false;
+    QCOMPARE(apply(channel.flush(), states, &full), 2);
+    QVERIFY(full);
+    QCOMPARE(states["new_mount_state"], QJsonObject({{"ra", 11.0}, {"de", -5.0}}));
+    QCOMPARE(states["new_focus_state"], QJsonObject({{"status", "Idle"}}));
+
+    channel.update("new_mount_state", {{"ra", 11.0}});
+    QVERIFY(!channel.hasPending());
+
+    channel.clear();
+    QVERIFY(!channel.hasPending());
+    channel.update("new_mount_state", {{"ra", 11.0}});
+    QVERIFY(channel.hasPending());
+}
+
+void TestStateChannel::testReplay()
+{
+    const QList<Event> events = loadSession("ekoslive-session.jsonl");
+    if (events.isEmpty())
+        QSKIP("Failed to load the recorded session, skipping test.");
+
+    // Same as Message::THROTTLE_INTERVAL and Message::STATE_FLUSH_INTERVAL
+    constexpr qint64 throttleInterval = 1000;
+    constexpr qint64 flushInterval = 250;
+    constexpr int iterations = 20;
+
+    qint64 jsonBytes = 0, jsonMessages = 0, jsonNs = 0;
+    qint64 compactBytes = 0, compactMessages = 0, compactNs = 0;
+    QHash<QString, QJsonObject> expected, received;
+    QElapsedTimer timer;
+
+    for (const auto &event : events)
+    {
+        QJsonObject &state = expected[event.type];
+        for (auto it = event.payload.constBegin(); it != event.payload.constEnd(); ++it)
+            state.insert(it.key(), it.value());
+    }
+
+    for (int i = 0; i < iterations; i++)
+    {
+        // JSON path, as Message::updateMountStatus() and Node::sendResponse() do it
+        qint64 throttleTS = -throttleInterval;
+        timer.start();
+        for (const auto &event : events)
+        {
+            if (event.throttle)
+            {
+                if (event.ms - throttleTS < throttleInterval)
+                    continue;
+                throttleTS = event.ms;
+            }
+
+            const QByteArray message = QJsonDocument({{"type", event.type}, {"payload", event.payload}}).toJson(
+                                           QJsonDocument::Compact);
+            if (i == 0)
+            {
+                jsonBytes += message.size();
+                jsonMessages++;
+            }
+        }
+        jsonNs += timer.nsecsElapsed();
+
+        // Compact path, flushed on the replayed clock
+        EkosLive::StateChannel channel("new_state_delta");
+        QList<QByteArray> frames;
+        qint64 nextFlush = flushInterval;
+        timer.start();
+        for (const auto &event : events)
+        {
+            while (event.ms >= nextFlush)
+            {
+                const QByteArray frame = channel.flush();
+                if (!frame.isEmpty())
+                    frames.append(frame);
+                nextFlush += flushInterval;
+            }
+            channel.update(event.type, event.payload);
+        }
+        const QByteArray frame = channel.flush();
+        if (!frame.isEmpty())
+            frames.append(frame);
+        compactNs += timer.nsecsElapsed();
+
+        if (i == 0)
+        {
+            for (const auto &oneFrame : frames)
+            {
+                compactBytes += oneFrame.size();
+                apply(oneFrame, received);
+            }
+            compactMessages = frames.size();
+        }
+    }
+
+    qInfo() << "JSON:" << jsonMessages << "messages" << jsonBytes << "bytes" << jsonNs / iterations / 1000 << "us";
+    qInfo() << "Compact:" << compactMessages << "frames" << compactBytes << "bytes" << compactNs / iterations / 1000 << "us";
+
+    // Unlike the throttled JSON path the compact one loses no key, the client ends up with the complete state.
+    QCOMPARE(received.keys().size(), expected.keys().size());
+    for (auto it = expected.constBegin(); it != expected.constEnd(); ++it)
+        QCOMPARE(received.value(it.key()), it.value());
+
+    QVERIFY(compactMessages < jsonMessages);
+    QVERIFY(compactBytes < jsonBytes);
+}
+
+QTEST_GUILESS_MAIN(TestStateChannel)
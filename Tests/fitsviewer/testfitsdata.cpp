@@ -10,9 +10,16 @@
 #include <QTest>
 #endif
 
+#include <QTemporaryDir>
+
+#include <cstring>
 #include <memory>
+#include <vector>
 #include "testfitsdata.h"
 #include "Options.h"
+#include "fitsviewer/fitsbufferpool.h"
+#include "fitsviewer/bayerdemosaic.h"
+#include "fitsviewer/fitswritequeue.h"
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
 
@@ -142,6 +149,232 @@ void TestFitsData::testBahtinovFocusHFR()
 #endif
 }
 
+void TestFitsData::testGuideBufferPool()
+{
+    const QString NAME = "m47_sim_stars.fits";
+    if(!QFile::exists(NAME))
+        QSKIP("Skipping buffer pool test because of missing fixture");
+
+    QSharedPointer<FITSBufferPool> pool(new FITSBufferPool());
+
+    // Simulate a guide loop, the previous frame is released once the next one is loaded.
+    std::unique_ptr<FITSData> previous;
+    for (int i = 0; i < 4; i++)
+    {
+        std::unique_ptr<FITSData> d(new FITSData(FITS_GUIDE));
+        d->setBufferPool(pool);
+
+        QFuture<bool> worker = d->loadFromFile(NAME);
+        QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+        QVERIFY(worker.result());
+
+        worker = d->findStars(ALGORITHM_SEP);
+        QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+        QVERIFY(worker.result());
+        QVERIFY(d->getDetectedStars() > 0);
+
+        previous = std::move(d);
+    }
+
+    const auto stats = pool->statistics();
+    // Two frames are alive at once, so only the first two buffers come from the heap.
+    QCOMPARE(stats.allocations, 2ULL);
+    QCOMPARE(stats.reuses, 2ULL);
+    QVERIFY(stats.edgeReuses > 0);
+    QCOMPARE(stats.outstanding, 1);
+}
+
+void TestFitsData::testDebayerBands_data()
+{
+    QTest::addColumn<int>("METHOD");
+
+    QTest::newRow("nearest") << static_cast<int>(DC1394_BAYER_METHOD_NEAREST);
+    QTest::newRow("simple") << static_cast<int>(DC1394_BAYER_METHOD_SIMPLE);
+    QTest::newRow("bilinear") << static_cast<int>(DC1394_BAYER_METHOD_BILINEAR);
+    QTest::newRow("hqlinear") << static_cast<int>(DC1394_BAYER_METHOD_HQLINEAR);
+    QTest::newRow("vng") << static_cast<int>(DC1394_BAYER_METHOD_VNG);
+}
+
+void TestFitsData::testDebayerBands()
+{
+    QFETCH(int, METHOD);
+
+    // Odd width, and tall enough to be split in several bands whatever the thread count.
+    const uint32_t width = 641, height = 1203;
+    std::vector<uint8_t> bayer(width * height);
+    QRandomGenerator generator(42);
+    for (auto &pixel : bayer)
+        pixel = static_cast<uint8_t>(generator.bounded(256));
+
+    BayerParams params;
+    params.method = static_cast<dc1394bayer_method_t>(METHOD);
+    params.filter = DC1394_COLOR_FILTER_GRBG;
+    params.offsetX = params.offsetY = 0;
+
+    std::vector<uint8_t> reference(width * height * 3), banded(width * height * 3);
+    QCOMPARE(dc1394_bayer_decoding_8bit(bayer.data(), reference.data(), width, height, params.filter, params.method),
+             DC1394_SUCCESS);
+
+    BayerDemosaic::Target target;
+    target.layout = BayerDemosaic::Target::Interleaved;
+    QCOMPARE(BayerDemosaic::decode(bayer.data(), banded.data(), width, height, params, target), DC1394_SUCCESS);
+    QVERIFY(reference == banded);
+
+    // Same pixels, rearranged in planes.
+    std::vector<uint8_t> planar(width * height * 3);
+    QCOMPARE(BayerDemosaic::decode(bayer.data(), planar.data(), width, height, params), DC1394_SUCCESS);
+    for (uint32_t i = 0; i < width * height; i += 97)
+    {
+        QCOMPARE(planar[i], reference[3 * i]);
+        QCOMPARE(planar[width * height + i], reference[3 * i + 1]);
+        QCOMPARE(planar[2 * width * height + i], reference[3 * i + 2]);
+    }
+}
+
+void TestFitsData::testDebayerSuperPixel()
+{
+    // RGGB cells with R = 4000, G = 1000 and 1002, B = 250.
+    const uint32_t width = 7, height = 5;
+    std::vector<uint16_t> bayer(width * height);
+    for (uint32_t y = 0; y < height; y++)
+        for (uint32_t x = 0; x < width; x++)
+            bayer[y * width + x] = (y % 2 == 0) ? ((x % 2 == 0) ? 4000 : 1000) : ((x % 2 == 0) ? 1002 : 250);
+
+    BayerParams params;
+    params.method = DC1394_BAYER_METHOD_DOWNSAMPLE;
+    params.filter = DC1394_COLOR_FILTER_RGGB;
+    params.offsetX = params.offsetY = 0;
+
+    std::vector<uint16_t> rgb(width * height * 3, 0);
+    QCOMPARE(BayerDemosaic::decode(bayer.data(), rgb.data(), width, height, params), DC1394_SUCCESS);
+
+    // The odd last row and column reuse the last complete cell.
+    for (uint32_t i = 0; i < width * height; i++)
+    {
+        QCOMPARE(rgb[i], uint16_t(4000));
+        QCOMPARE(rgb[width * height + i], uint16_t(1001));
+        QCOMPARE(rgb[2 * width * height + i], uint16_t(250));
+    }
+}
+
+void TestFitsData::testDebayerBenchmark_data()
+{
+    QTest::addColumn<bool>("BANDED");
+
+    QTest::newRow("dc1394") << false;
+    QTest::newRow("banded") << true;
+}
+
+void TestFitsData::testDebayerBenchmark()
+{
+    QFETCH(bool, BANDED);
+
+    // A 16MP 16bit frame, decoded to FITS planes as FITSData does.
+    const uint32_t width = 4656, height = 3520;
+    std::vector<uint16_t> bayer(width * height);
+    QRandomGenerator generator(42);
+    for (auto &pixel : bayer)
+        pixel = static_cast<uint16_t>(generator.bounded(65536));
+
+    BayerParams params;
+    params.method = DC1394_BAYER_METHOD_BILINEAR;
+    params.filter = DC1394_COLOR_FILTER_RGGB;
+    params.offsetX = params.offsetY = 0;
+
+    std::vector<uint16_t> rgb(width * height * 3);
+
+    if (BANDED)
+    {
+        QBENCHMARK { BayerDemosaic::decode(bayer.data(), rgb.data(), width, height, params); }
+    }
+    else
+    {
+        // What FITSData used to do: decode interleaved, then split into planes.
+        std::vector<uint16_t> interleaved(width * height * 3);
+        QBENCHMARK
+        {
+            dc1394_bayer_decoding_16bit(bayer.data(), interleaved.data(), width, height, params.filter, params.method, 16);
+            for (uint32_t i = 0; i < width * height; i++)
+            {
+                rgb[i] = interleaved[3 * i];
+                rgb[width * height + i] = interleaved[3 * i + 1];
+                rgb[2 * width * height + i] = interleaved[3 * i + 2];
+            }
+        }
+    }
+}
+
+void TestFitsData::testWriteQueue()
+{
+    const QString NAME = "m47_sim_stars.fits";
+    if(!QFile::exists(NAME))
+        QSKIP("Skipping write queue test because of missing fixture");
+
+    QFile source(NAME);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    const QByteArray frame = source.readAll();
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    FITSWriteQueue queue;
+    QAtomicInt failures;
+    connect(&queue, &FITSWriteQueue::writeFailed, this, [&failures]()
+    {
+        failures.ref();
+    }, Qt::DirectConnection);
+
+    // Room for a single frame only, every enqueue() after the first has to wait for a writer.
+    FITSWriteQueue::Settings settings;
+    settings.maxQueuedBytes = frame.size();
+    settings.maxParallelWrites = 2;
+    settings.sync = FITSWriteQueue::SYNC_DATA;
+    queue.setSettings(settings);
+
+    QStringList names;
+    for (int i = 0; i < 4; i++)
+    {
+        names << queue.enqueue(dir.filePath(QString("frame%1.fits").arg(i)), frame);
+        QVERIFY(queue.queuedBytes() <= frame.size());
+    }
+    queue.waitForFinished();
+    QCOMPARE(queue.queuedBytes(), 0);
+    QCOMPARE(failures.loadAcquire(), 0);
+
+    for (const auto &name : names)
+    {
+        QFile file(name);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.readAll(), frame);
+    }
+
+    // Compressed frames get the .fz suffix, are smaller and hold the same pixels.
+    settings.compress = true;
+    queue.setSettings(settings);
+    const QString packed = queue.enqueue(dir.filePath("packed.fits"), frame);
+    QCOMPARE(packed, dir.filePath("packed.fits.fz"));
+    queue.waitForFinished();
+    QCOMPARE(failures.loadAcquire(), 0);
+    QVERIFY(QFileInfo(packed).size() < frame.size());
+
+    FITSData original, unpacked;
+    QVERIFY(original.loadFromBuffer(frame));
+    QFuture<bool> worker = unpacked.loadFromFile(packed);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+
+    QCOMPARE(unpacked.width(), original.width());
+    QCOMPARE(unpacked.height(), original.height());
+    QCOMPARE(unpacked.dataType(), original.dataType());
+    const size_t bytes = size_t(original.samplesPerChannel()) * original.channels() * original.getBytesPerPixel();
+    QVERIFY(memcmp(unpacked.getImageBuffer(), original.getImageBuffer(), bytes) == 0);
+
+    // Failures are reported, not thrown away.
+    queue.enqueue(dir.filePath("missing/frame.fits"), frame);
+    queue.waitForFinished();
+    QCOMPARE(failures.loadAcquire(), 1);
+}
+
 void TestFitsData::initGenericDataFixture()
 {
 #if QT_VERSION < 0x050900
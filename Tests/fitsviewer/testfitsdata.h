@@ -52,6 +52,18 @@ class TestFitsData : public QObject
         void testBahtinovFocusHFR_data();
         void testBahtinovFocusHFR();
 
+        void testGuideBufferPool();
+
+        void testDebayerBands_data();
+        void testDebayerBands();
+
+        void testDebayerSuperPixel();
+
+        void testDebayerBenchmark_data();
+        void testDebayerBenchmark();
+
+        void testWriteQueue();
+
         void testParallelSolvers();
     private:
         void startGuideDetect(const QString &filename);
@@ -13,6 +13,7 @@
 #include <QTest>
 #endif
 
+#include <cmath>
 #include <memory>
 
 #include <QObject>
@@ -36,6 +37,7 @@ class TestFocus : public QObject
         void L1PHyperbolaTest();
         void L1PParabolaTest();
         void L1PQuadraticTest();
+        void curveFitWarmStartTest();
 };
 
 #include "testfocus.moc"
@@ -873,4 +875,53 @@ void TestFocus::L1PQuadraticTest()
     QCOMPARE(focuser->doneReason(), "Solution found.");
 }
 
+void TestFocus::curveFitWarmStartTest()
+{
+    // Datapoints on the hyperbola y = 2 * sqrt(1 + ((x - 5000) / 100)^2) + 1
+    QVector<int> positions;
+    QVector<double> values, weights;
+    QVector<bool> outliers;
+    auto addPoint = [&](int x)
+    {
+        positions.push_back(x);
+        values.push_back(2.0 * std::sqrt(1.0 + std::pow((x - 5000) / 100.0, 2.0)) + 1.0);
+        weights.push_back(1.0);
+        outliers.push_back(false);
+    };
+    for (int x = 4500; x <= 5300; x += 100)
+        addPoint(x);
+
+    Ekos::CurveFitting curveFitting;
+    curveFitting.fitCurve(Ekos::CurveFitting::BEST, positions, values, weights, outliers,
+                          Ekos::CurveFitting::FOCUS_HYPERBOLA, false, Ekos::CurveFitting::OPTIMISATION_MINIMISE);
+    auto stats = curveFitting.lastFitStats();
+    QVERIFY(stats.solved);
+    QVERIFY(!stats.warmStart);
+    QVERIFY(stats.attempts >= 1);
+    QVERIFY(stats.iterations > 0);
+
+    double position = 0, value = 0;
+    QVERIFY(curveFitting.findMinMax(5000, 4500, 5500, &position, &value, Ekos::CurveFitting::FOCUS_HYPERBOLA,
+                                    Ekos::CurveFitting::OPTIMISATION_MINIMISE));
+    QVERIFY(std::abs(position - 5000) < 1.0);
+
+    // A new datapoint, as during autofocus, starts from the previous solution
+    addPoint(5400);
+    curveFitting.fitCurve(Ekos::CurveFitting::BEST, positions, values, weights, outliers,
+                          Ekos::CurveFitting::FOCUS_HYPERBOLA, false, Ekos::CurveFitting::OPTIMISATION_MINIMISE);
+    stats = curveFitting.lastFitStats();
+    QVERIFY(stats.solved);
+    QVERIFY(stats.warmStart);
+
+    // Copies carry the previous solution, as used for the Aberration Inspector tiles
+    Ekos::CurveFitting copy(curveFitting);
+    copy.fitCurve(Ekos::CurveFitting::BEST, positions, values, weights, outliers,
+                  Ekos::CurveFitting::FOCUS_HYPERBOLA, false, Ekos::CurveFitting::OPTIMISATION_MINIMISE);
+    QVERIFY(copy.lastFitStats().solved);
+    QVERIFY(copy.lastFitStats().warmStart);
+    QVERIFY(copy.findMinMax(5000, 4500, 5500, &position, &value, Ekos::CurveFitting::FOCUS_HYPERBOLA,
+                            Ekos::CurveFitting::OPTIMISATION_MINIMISE));
+    QVERIFY(std::abs(position - 5000) < 1.0);
+}
+
 QTEST_GUILESS_MAIN(TestFocus)
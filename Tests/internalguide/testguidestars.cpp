@@ -6,6 +6,8 @@
 
 #include "../indi/indiproperty.h"
 #include "ekos/guide/internalguide/guidestars.h"
+#include "ekos/guide/internalguide/guidealgorithms.h"
+#include "fitsviewer/fitsdata.h"
 
 #include <QtGlobal>
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -15,6 +17,7 @@
 #endif
 
 #include <QObject>
+#include <cmath>
 
 // The high-level methods, selectGuideStar() and findGuideStar() are not yet tested.
 // Neither are the SEP-related EvaluateSEPStars, findTopStars, findAllSEPStars().
@@ -34,6 +37,7 @@ class TestGuideStars : public QObject
         void basicTest();
         void calibrationTest();
         void testFindGuideStar();
+        void testRefineStarPosition();
 };
 
 #include "testguidestars.moc"
@@ -704,4 +708,48 @@ void TestGuideStars::testFindGuideStar()
 #endif
 }
 
+void TestGuideStars::testRefineStarPosition()
+{
+    // Synthetic 16-bit frame with a gaussian star on a flat background.
+    constexpr int width = 64, height = 64;
+    constexpr double background = 100, peak = 5000, sigma = 1.5;
+    constexpr double starX = 30.3, starY = 25.7;
+
+    auto *buffer = new uint8_t[width * height * sizeof(uint16_t)];
+    auto *pixels = reinterpret_cast<uint16_t *>(buffer);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+            const double r2 = (x - starX) * (x - starX) + (y - starY) * (y - starY);
+            pixels[y * width + x] = static_cast<uint16_t>(background + peak * std::exp(-r2 / (2 * sigma * sigma)));
+        }
+
+    FITSImage::Statistic stats;
+    stats.width = width;
+    stats.height = height;
+    stats.samples_per_channel = width * height;
+    stats.channels = 1;
+    stats.dataType = TUSHORT;
+    stats.bytesPerPixel = sizeof(uint16_t);
+
+    QSharedPointer<FITSData> fits(new FITSData(FITS_NORMAL));
+    fits->restoreStatistics(stats);
+    fits->setImageBuffer(buffer);
+
+    SkyBackground bg(background, 5, 1000);
+
+    // The star moved a few pixels since the previous frame.
+    Edge star = makeEdge(27, 28);
+    QVERIFY(GuideAlgorithms::refineStarPosition(fits, bg, 10, &star));
+    QVERIFY(fabs(star.x - starX) < 0.05);
+    QVERIFY(fabs(star.y - starY) < 0.05);
+    QVERIFY(star.sum > 0);
+    QVERIFY(star.numPixels >= 3);
+    QVERIFY(star.HFR > 0 && star.HFR < 3 * sigma);
+
+    // Nothing but background near this position.
+    Edge empty = makeEdge(8, 55);
+    QVERIFY(!GuideAlgorithms::refineStarPosition(fits, bg, 5, &empty));
+}
+
 QTEST_GUILESS_MAIN(TestGuideStars)
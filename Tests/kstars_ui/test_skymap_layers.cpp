@@ -0,0 +1,145 @@
+/*  KStars UI tests
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_skymap_layers.h"
+
+#include "kstars_ui_tests.h"
+#include "test_kstars_startup.h"
+
+#include "Options.h"
+#include "skymap.h"
+#include "skymapqdraw.h"
+
+namespace
+{
+SkyMapQDraw *skyMapDraw()
+{
+    return dynamic_cast<SkyMapQDraw *>(KStars::Instance()->map()->getSkyMapDrawAbstract());
+}
+}
+
+TestSkyMapLayers::TestSkyMapLayers(QObject *parent): QObject(parent)
+{
+
+}
+
+void TestSkyMapLayers::initTestCase()
+{
+    KTELL_BEGIN();
+    KTRY_SHOW_KSTARS();
+
+    m_UseAltAz = Options::useAltAz();
+    m_ShowGround = Options::showGround();
+    m_IsTracking = Options::isTracking();
+    m_ParallelSkyLayers = Options::parallelSkyLayers();
+}
+
+void TestSkyMapLayers::cleanupTestCase()
+{
+    Options::setUseAltAz(m_UseAltAz);
+    Options::setShowGround(m_ShowGround);
+    Options::setIsTracking(m_IsTracking);
+    Options::setParallelSkyLayers(m_ParallelSkyLayers);
+    KStars::Instance()->map()->forceUpdate();
+    KTELL_END();
+}
+
+void TestSkyMapLayers::init()
+{
+    KTELL("Fix the view in equatorial coordinates on Orion");
+    KStarsData::Instance()->clock()->stop();
+    Options::setUseAltAz(false);
+    Options::setShowGround(false);
+    Options::setIsTracking(false);
+
+    SkyMap * const map = KStars::Instance()->map();
+    map->setFocus(dms(83.8), dms(-5.4));
+    map->forceUpdateNow();
+    map->forceUpdateNow();
+    QVERIFY(skyMapDraw() != nullptr);
+}
+
+void TestSkyMapLayers::cleanup()
+{
+    Options::setParallelSkyLayers(m_ParallelSkyLayers);
+    if (KStars::Instance()->isStartedWithClockRunning())
+        KStarsData::Instance()->clock()->start();
+}
+
+void TestSkyMapLayers::testStaticLayersReused()
+{
+    SkyMap * const map = KStars::Instance()->map();
+    SkyMapQDraw * const draw = skyMapDraw();
+
+    KTELL("Updates of the clock reuse the static layers");
+    int const redraws = draw->staticLayerRedraws();
+    int const reuses = draw->staticLayerReuses();
+    for (int i = 0; i < 10; i++)
+        map->forceTimeUpdateNow();
+    QCOMPARE(draw->staticLayerRedraws(), redraws);
+    QCOMPARE(draw->staticLayerReuses(), reuses + 10);
+
+    KTELL("Any other update redraws them");
+    map->forceUpdateNow();
+    QCOMPARE(draw->staticLayerRedraws(), redraws + 1);
+
+    KTELL("A change of the view draws in a single pass");
+    map->setFocus(dms(84.8), dms(-5.4));
+    map->forceTimeUpdateNow();
+    QCOMPARE(draw->staticLayerRedraws(), redraws + 1);
+    QCOMPARE(draw->staticLayerReuses(), reuses + 10);
+
+    KTELL("And rebuilds the layers once the view stays fixed again");
+    map->forceTimeUpdateNow();
+    QCOMPARE(draw->staticLayerRedraws(), redraws + 2);
+}
+
+void TestSkyMapLayers::testParallelStarLayer()
+{
+    SkyMap * const map = KStars::Instance()->map();
+    SkyMapQDraw * const draw = skyMapDraw();
+
+    KTELL("Draw the stars along with the other layers");
+    Options::setParallelSkyLayers(false);
+    map->forceUpdateNow();
+    QImage const serial = draw->grab().toImage();
+
+    KTELL("Draw the stars on a worker thread, the sky map must not change");
+    Options::setParallelSkyLayers(true);
+    map->forceUpdateNow();
+    QImage const parallel = draw->grab().toImage();
+
+    QVERIFY(!serial.isNull());
+    QCOMPARE(parallel, serial);
+}
+
+void TestSkyMapLayers::benchmarkRedraw_data()
+{
+    QTest::addColumn<bool>("clockUpdate");
+    QTest::addColumn<bool>("parallel");
+
+    QTest::newRow("full redraw") << false << false;
+    QTest::newRow("full redraw, parallel stars") << false << true;
+    QTest::newRow("clock update, fixed view") << true << true;
+}
+
+void TestSkyMapLayers::benchmarkRedraw()
+{
+    QFETCH(bool, clockUpdate);
+    QFETCH(bool, parallel);
+    SkyMap * const map = KStars::Instance()->map();
+    Options::setParallelSkyLayers(parallel);
+
+    QBENCHMARK
+    {
+        if (clockUpdate)
+            map->forceTimeUpdateNow();
+        else
+            map->forceUpdateNow();
+    }
+}
+
+QTEST_KSTARS_MAIN(TestSkyMapLayers)
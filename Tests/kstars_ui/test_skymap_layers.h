@@ -0,0 +1,43 @@
+/*  KStars UI tests
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef TEST_SKYMAP_LAYERS_H
+#define TEST_SKYMAP_LAYERS_H
+
+#include "config-kstars.h"
+#include <QObject>
+
+/**
+ * @brief Redraw cost of the sky map on an observatory display: the clock runs while the view stays fixed.
+ *
+ * Run with -tickcounter or -callgrind for a more stable measure than wall time.
+ */
+class TestSkyMapLayers: public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestSkyMapLayers(QObject* parent = nullptr);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void init();
+    void cleanup();
+
+    void testStaticLayersReused();
+    void testParallelStarLayer();
+    void benchmarkRedraw_data();
+    void benchmarkRedraw();
+
+private:
+    bool m_UseAltAz { false };
+    bool m_ShowGround { false };
+    bool m_IsTracking { false };
+    bool m_ParallelSkyLayers { true };
+};
+
+#endif // TEST_SKYMAP_LAYERS_H
@@ -412,6 +412,32 @@ void TestSkyPoint::testApparentCatalogueInversion()
     );
 }
 
+void TestSkyPoint::testApparentCoordNumbers_data()
+{
+    testApparentCatalogueInversion_data();
+}
+
+void TestSkyPoint::testApparentCoordNumbers()
+{
+    Options::setUseRelativistic(false);
+
+    // Reusing a KSNumbers object must give exactly what apparentCoord(jd0, jdf) gives.
+    QFETCH(double, Ra);
+    QFETCH(double, Dec);
+    QFETCH(double, Epoch);
+    long double targetJd = KStarsDateTime::epochToJd(Epoch);
+    KSNumbers num(targetJd);
+
+    SkyPoint byJd(Ra / 15.0, Dec);
+    byJd.apparentCoord(J2000L, targetJd);
+
+    SkyPoint byNum(Ra / 15.0, Dec);
+    byNum.apparentCoord(J2000L, &num);
+
+    QCOMPARE(byNum.ra().Degrees(), byJd.ra().Degrees());
+    QCOMPARE(byNum.dec().Degrees(), byJd.dec().Degrees());
+}
+
 void TestSkyPoint::compareSkyPointLibNova_data()
 {
     QTest::addColumn<double>("Ra");
@@ -63,6 +63,8 @@ class TestSkyPoint : public QObject
         void testApparentCatalogue();
         void testApparentCatalogueInversion_data();
         void testApparentCatalogueInversion();
+        void testApparentCoordNumbers_data();
+        void testApparentCoordNumbers();
 
         void compareSkyPointLibNova_data();
         void compareSkyPointLibNova();
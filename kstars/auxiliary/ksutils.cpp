@@ -34,10 +34,14 @@
 #include <QProcess>
 #endif
 
+#include <QFile>
 #include <QPointer>
 #include <QProcessEnvironment>
 #include <QLoggingCategory>
 
+#include <cstring>
+#include <stdexcept>
+
 #ifdef HAVE_STELLARSOLVER
 #include <stellarsolver.h>
 #endif
@@ -1742,25 +1746,288 @@ double getAvailableRAM()
     return 0;
 }
 
+namespace
+{
+// Minimal JSON scanning helpers for JPLParser. They only validate as much as is needed
+// to walk the structure without running past the end of the buffer.
+
+const char *skipSpace(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+// p points to the opening quote. Returns the position after the closing quote.
+const char *scanString(const char *p, const char *end, bool &hasEscapes)
+{
+    hasEscapes = false;
+    for (++p; p < end; ++p)
+    {
+        if (*p == '\\')
+        {
+            hasEscapes = true;
+            ++p;
+        }
+        else if (*p == '"')
+            return p + 1;
+    }
+    throw std::runtime_error("Unterminated string in JPL data.");
+}
+
+// Returns the position after the value starting at p.
+const char *skipValue(const char *p, const char *end)
+{
+    p = skipSpace(p, end);
+    if (p >= end)
+        throw std::runtime_error("Unexpected end of JPL data.");
+
+    bool escapes;
+    if (*p == '"')
+        return scanString(p, end, escapes);
+
+    if (*p == '[' || *p == '{')
+    {
+        int depth = 0;
+        while (p < end)
+        {
+            if (*p == '"')
+            {
+                p = scanString(p, end, escapes);
+                continue;
+            }
+            if (*p == '[' || *p == '{')
+                ++depth;
+            else if (*p == ']' || *p == '}')
+            {
+                if (--depth == 0)
+                    return p + 1;
+            }
+            ++p;
+        }
+        throw std::runtime_error("Unterminated array in JPL data.");
+    }
+
+    while (p < end && *p != ',' && *p != ']' && *p != '}' && *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t')
+        ++p;
+    return p;
+}
+
+QString unescape(const char *begin, const char *end)
+{
+    QByteArray out;
+    out.reserve(end - begin);
+    for (const char *p = begin; p < end; ++p)
+    {
+        if (*p != '\\' || p + 1 >= end)
+        {
+            out.append(*p);
+            continue;
+        }
+        switch (*++p)
+        {
+            case 'n':
+                out.append('\n');
+                break;
+            case 't':
+                out.append('\t');
+                break;
+            case 'r':
+                out.append('\r');
+                break;
+            case 'b':
+                out.append('\b');
+                break;
+            case 'f':
+                out.append('\f');
+                break;
+            case 'u':
+                if (p + 4 < end)
+                {
+                    out.append(QString(QChar(QByteArray(p + 1, 4).toUShort(nullptr, 16))).toUtf8());
+                    p += 4;
+                }
+                break;
+            default:
+                out.append(*p);
+                break;
+        }
+    }
+    return QString::fromUtf8(out);
+}
+}
+
+QString JPLParser::Value::toString() const
+{
+    if (m_Begin == nullptr)
+        return QString();
+    if (m_Escapes)
+        return unescape(m_Begin, m_End);
+    return QString::fromUtf8(m_Begin, static_cast<int>(m_End - m_Begin));
+}
+
+double JPLParser::Value::toDouble() const
+{
+    if (m_Begin == nullptr || m_Begin == m_End)
+        return 0;
+    return QByteArray::fromRawData(m_Begin, static_cast<int>(m_End - m_Begin)).toDouble();
+}
+
+int JPLParser::Value::toInt() const
+{
+    if (m_Begin == nullptr || m_Begin == m_End)
+        return 0;
+    const QByteArray raw = QByteArray::fromRawData(m_Begin, static_cast<int>(m_End - m_Begin));
+    bool ok = false;
+    const int value = raw.toInt(&ok);
+    // Old exports write the epoch as a JSON number, which may carry a fraction.
+    return ok ? value : static_cast<int>(raw.toDouble());
+}
+
 JPLParser::JPLParser(const QString &path)
 {
-    QFile jpl_file(path);
-    if (!jpl_file.open(QIODevice::ReadOnly))
+    m_file.reset(new QFile(path));
+    if (!m_file->open(QIODevice::ReadOnly))
     {
         throw std::runtime_error("Could not open file.");
     }
 
-    const auto &ast_json = QJsonDocument::fromJson(jpl_file.readAll());
-    const auto &fields   = ast_json["fields"].toArray();
-    m_data               = ast_json["data"].toArray();
+    const qint64 size = m_file->size();
+    const uchar *mapped = size > 0 ? m_file->map(0, size) : nullptr;
+    if (mapped)
+    {
+        m_begin = reinterpret_cast<const char *>(mapped);
+        m_end   = m_begin + size;
+    }
+    else
+    {
+        // Some file systems cannot be mapped, fall back to reading the file.
+        m_buffer = m_file->readAll();
+        m_begin  = m_buffer.constData();
+        m_end    = m_begin + m_buffer.size();
+    }
+
+    // Walk the top level object. Only "fields", "count" and the position of "data" are
+    // needed, the rows are scanned lazily by for_each().
+    const char *p = skipSpace(m_begin, m_end);
+    if (p >= m_end || *p != '{')
+        throw std::runtime_error("JPL data is not a JSON object.");
+    ++p;
+
+    bool escapes;
+    bool haveFields = false;
+    while (true)
+    {
+        p = skipSpace(p, m_end);
+        if (p >= m_end)
+            throw std::runtime_error("Unexpected end of JPL data.");
+        if (*p == '}')
+            break;
+        if (*p == ',')
+        {
+            ++p;
+            continue;
+        }
+        if (*p != '"')
+            throw std::runtime_error("Malformed JPL data.");
+
+        const char *keyEnd = scanString(p, m_end, escapes);
+        const QByteArray key = QByteArray::fromRawData(p + 1, static_cast<int>(keyEnd - p - 2));
+        p = skipSpace(keyEnd, m_end);
+        if (p >= m_end || *p != ':')
+            throw std::runtime_error("Malformed JPL data.");
+        p = skipSpace(p + 1, m_end);
+
+        const char *valueEnd = skipValue(p, m_end);
+        if (key == "fields" && *p == '[')
+        {
+            int i = 0;
+            const char *f = p + 1;
+            while (true)
+            {
+                f = skipSpace(f, valueEnd);
+                if (f >= valueEnd || *f == ']')
+                    break;
+                if (*f == ',')
+                {
+                    ++f;
+                    continue;
+                }
+                if (*f != '"')
+                    throw std::runtime_error("Malformed JPL field list.");
+                const char *fieldEnd = scanString(f, valueEnd, escapes);
+                m_field_map[Value(f + 1, fieldEnd - 1, true, escapes).toString()] = i++;
+                f = fieldEnd;
+            }
+            haveFields = true;
+        }
+        else if (key == "count")
+        {
+            m_count = (*p == '"') ? Value(p + 1, valueEnd - 1, true, false).toInt() : Value(p, valueEnd, false, false).toInt();
+        }
+        else if (key == "data" && *p == '[')
+        {
+            m_rows = p + 1;
+        }
+        p = valueEnd;
+    }
+
+    if (!haveFields || m_rows == nullptr)
+        throw std::runtime_error("JPL data has no fields or no data.");
+}
+
+bool JPLParser::nextRow(std::vector<Value> &cells)
+{
+    cells.clear();
+
+    const char *p = skipSpace(m_cursor, m_end);
+    if (p < m_end && *p == ',')
+        p = skipSpace(p + 1, m_end);
+    if (p >= m_end || *p == ']')
+    {
+        m_cursor = p;
+        return false;
+    }
+    if (*p != '[')
+        throw std::runtime_error("Malformed JPL data row.");
+    ++p;
 
+    bool escapes;
+    while (true)
     {
-        int i = 0;
-        for (const auto &field : fields)
+        p = skipSpace(p, m_end);
+        if (p >= m_end)
+            throw std::runtime_error("Unexpected end of JPL data.");
+        if (*p == ']')
         {
-            m_field_map[field.toString()] = i++;
+            ++p;
+            break;
+        }
+        if (*p == ',')
+        {
+            ++p;
+            continue;
+        }
+
+        if (*p == '"')
+        {
+            const char *stringEnd = scanString(p, m_end, escapes);
+            cells.emplace_back(p + 1, stringEnd - 1, true, escapes);
+            p = stringEnd;
+        }
+        else
+        {
+            const char *tokenEnd = skipValue(p, m_end);
+            if (tokenEnd - p == 4 && strncmp(p, "null", 4) == 0)
+                cells.emplace_back();
+            else
+                cells.emplace_back(p, tokenEnd, false, false);
+            p = tokenEnd;
         }
     }
+
+    m_cursor = p;
+    return true;
 }
 
 MPCParser::MPCParser(const QString &path)
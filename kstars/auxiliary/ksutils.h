@@ -24,6 +24,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <unordered_map>
+#include <vector>
 
 #include "config-kstars.h"
 // N.B. DO not remove, it is required for compilation.
@@ -277,35 +278,111 @@ struct JPLFilter
     QByteArray value;
 };
 
+/**
+ * @class JPLParser
+ * @short Streaming reader for the JSON exported by the JPL small-body database query API.
+ *
+ * The file is memory mapped and scanned one row of "data" at a time, so neither a
+ * QJsonDocument of the whole export nor a QString per field is ever built. The values
+ * handed to for_each() point into the mapping and convert on demand. Resolve the columns
+ * you need with column() once, then read them by index for every row.
+ *
+ * Throws std::runtime_error if the file cannot be opened or is malformed.
+ */
 class JPLParser
 {
     public:
-        JPLParser(const QString &path);
+        /** A single cell of a row. Only valid inside the for_each() callback. */
+        class Value
+        {
+            public:
+                Value() = default;
+                Value(const char *begin, const char *end, bool isString, bool hasEscapes)
+                    : m_Begin(begin), m_End(end), m_String(isString), m_Escapes(hasEscapes) {}
 
-        const QJsonArray &data() const
+                bool isNull() const
+                {
+                    return m_Begin == nullptr;
+                }
+                QString toString() const;
+                double toDouble() const;
+                float toFloat() const
+                {
+                    return static_cast<float>(toDouble());
+                }
+                int toInt() const;
+
+            private:
+                const char *m_Begin { nullptr };
+                const char *m_End { nullptr };
+                bool m_String { false };
+                bool m_Escapes { false };
+        };
+
+        class Row
         {
-            return m_data;
-        }
+            public:
+                Row(const std::unordered_map<QString, int> &fieldMap, const std::vector<Value> &cells)
+                    : m_FieldMap(fieldMap), m_Cells(cells) {}
+
+                Value operator()(int column) const
+                {
+                    return (column >= 0 && column < static_cast<int>(m_Cells.size())) ? m_Cells[column] : Value();
+                }
+                Value operator()(const QString &key) const
+                {
+                    auto it = m_FieldMap.find(key);
+                    return it == m_FieldMap.end() ? Value() : (*this)(it->second);
+                }
+
+            private:
+                const std::unordered_map<QString, int> &m_FieldMap;
+                const std::vector<Value> &m_Cells;
+        };
+
+        JPLParser(const QString &path);
+
         const std::unordered_map<QString, int> &fieldMap() const
         {
             return m_field_map;
         }
 
+        /** @return index of the field named key, or -1 if the export does not have it. */
+        int column(const QString &key) const
+        {
+            auto it = m_field_map.find(key);
+            return it == m_field_map.end() ? -1 : it->second;
+        }
+
+        /** Number of rows announced by the export, 0 if unknown. Useful to reserve. */
+        int count() const
+        {
+            return m_count;
+        }
+
         template <typename Lambda>
         void for_each(const Lambda &fct)
         {
-            for (const auto &item : m_data)
-            {
-                fct([ &, this](const QString & key)
-                {
-                    return item.toArray().at(m_field_map.at(key));
-                });
-            }
+            std::vector<Value> cells;
+            cells.reserve(m_field_map.size());
+            const Row row(m_field_map, cells);
+
+            m_cursor = m_rows;
+            while (nextRow(cells))
+                fct(row);
         };
 
     private:
-        QJsonDocument m_doc;
-        QJsonArray m_data;
+        bool nextRow(std::vector<Value> &cells);
+
+        QSharedPointer<QFile> m_file;
+        QByteArray m_buffer;
+        const char *m_begin { nullptr };
+        const char *m_end { nullptr };
+        // Start of the "data" array and current position within it.
+        const char *m_rows { nullptr };
+        const char *m_cursor { nullptr };
+        int m_count { 0 };
         std::unordered_map<QString, int> m_field_map;
 };
 // TODO: Implement Datatypes//Maps for kind, datafields, filters...
@@ -0,0 +1,171 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "lodgraph.h"
+
+#include <algorithm>
+#include <cmath>
+
+LODGraph::LODGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) : QCPGraph(keyAxis, valueAxis)
+{
+}
+
+LODGraph::Bucket LODGraph::summarize(QCPGraphDataContainer::const_iterator begin,
+                                     QCPGraphDataContainer::const_iterator end)
+{
+    Bucket bucket { qQNaN(), qQNaN(), qQNaN(), qQNaN(), qQNaN() };
+    for (auto it = begin; it != end; ++it)
+    {
+        if (std::isnan(it->value))
+        {
+            if (std::isnan(bucket.gapKey))
+                bucket.gapKey = it->key;
+            continue;
+        }
+        if (std::isnan(bucket.minValue) || it->value < bucket.minValue)
+        {
+            bucket.minKey = it->key;
+            bucket.minValue = it->value;
+        }
+        if (std::isnan(bucket.maxValue) || it->value > bucket.maxValue)
+        {
+            bucket.maxKey = it->key;
+            bucket.maxValue = it->value;
+        }
+    }
+    return bucket;
+}
+
+LODGraph::Bucket LODGraph::merge(const Bucket &first, const Bucket &second)
+{
+    Bucket bucket = first;
+    if (std::isnan(bucket.minValue) || second.minValue < bucket.minValue)
+    {
+        bucket.minKey = second.minKey;
+        bucket.minValue = second.minValue;
+    }
+    if (std::isnan(bucket.maxValue) || second.maxValue > bucket.maxValue)
+    {
+        bucket.maxKey = second.maxKey;
+        bucket.maxValue = second.maxValue;
+    }
+    if (std::isnan(bucket.gapKey))
+        bucket.gapKey = second.gapKey;
+    return bucket;
+}
+
+void LODGraph::appendBucket(int level, const Bucket &bucket) const
+{
+    Bucket current = bucket;
+    while (true)
+    {
+        if (m_Levels.size() <= level)
+            m_Levels.resize(level + 1);
+        auto &buckets = m_Levels[level];
+        buckets.append(current);
+        if (buckets.size() % 2 != 0)
+            return;
+        current = merge(buckets[buckets.size() - 2], buckets.last());
+        level++;
+    }
+}
+
+void LODGraph::updatePyramid() const
+{
+    const QCPGraphDataContainer *container = mDataContainer.data();
+    const int size = container->size();
+    int covered = m_Levels.isEmpty() ? 0 : m_Levels[0].size() * BUCKET_SIZE;
+
+    if (container != m_Container || covered > size ||
+            (covered > 0 && (container->at(0)->key != m_FirstKey || container->at(covered - 1)->key != m_LastKey)))
+    {
+        m_Levels.clear();
+        m_Container = container;
+        covered = 0;
+    }
+
+    const auto begin = container->constBegin();
+    for (; covered + BUCKET_SIZE <= size; covered += BUCKET_SIZE)
+        appendBucket(0, summarize(begin + covered, begin + covered + BUCKET_SIZE));
+
+    if (covered > 0)
+    {
+        m_FirstKey = container->at(0)->key;
+        m_LastKey = container->at(covered - 1)->key;
+    }
+}
+
+void LODGraph::emitBucket(QVector<QCPGraphData> *lineData, const Bucket &bucket)
+{
+    QCPGraphData points[3];
+    int count = 0;
+    if (!std::isnan(bucket.minValue))
+    {
+        points[count++] = QCPGraphData(bucket.minKey, bucket.minValue);
+        if (bucket.maxKey != bucket.minKey)
+            points[count++] = QCPGraphData(bucket.maxKey, bucket.maxValue);
+    }
+    if (!std::isnan(bucket.gapKey))
+        points[count++] = QCPGraphData(bucket.gapKey, qQNaN());
+
+    std::sort(points, points + count, qcpLessThanSortKey<QCPGraphData>);
+    for (int i = 0; i < count; i++)
+        lineData->append(points[i]);
+}
+
+void LODGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin,
+                                    const QCPGraphDataContainer::const_iterator &end) const
+{
+    QCPAxis *keyAxis = mKeyAxis.data();
+    if (!lineData || !keyAxis || !mAdaptiveSampling || begin == end)
+    {
+        QCPGraph::getOptimizedLineData(lineData, begin, end);
+        return;
+    }
+
+    // With fewer than a few points per pixel there is nothing worth decimating.
+    const int count = end - begin;
+    const double pixels = qAbs(keyAxis->coordToPixel(begin->key) - keyAxis->coordToPixel((end - 1)->key)) + 1;
+    const double pointsPerPixel = count / pixels;
+    if (pointsPerPixel < BUCKET_SIZE)
+    {
+        QCPGraph::getOptimizedLineData(lineData, begin, end);
+        return;
+    }
+
+    updatePyramid();
+
+    int level = 0;
+    while (level + 1 < m_Levels.size() && (BUCKET_SIZE << (level + 1)) <= pointsPerPixel)
+        level++;
+
+    const int bucketSize = BUCKET_SIZE << level;
+    const auto dataBegin = mDataContainer->constBegin();
+    const int first = begin - dataBegin;
+    const int last = end - dataBegin;
+    const int firstBucket = (first + bucketSize - 1) / bucketSize;
+    const int lastBucket = std::min<int>(last / bucketSize, m_Levels.isEmpty() ? 0 : m_Levels[level].size());
+    if (firstBucket >= lastBucket)
+    {
+        QCPGraph::getOptimizedLineData(lineData, begin, end);
+        return;
+    }
+
+    lineData->clear();
+    lineData->reserve(3 * (lastBucket - firstBucket + 2));
+
+    // The points before the first and after the last whole bucket are summarized on the fly,
+    // these are less than two buckets, i.e. a couple of pixels worth of points.
+    if (first < firstBucket * bucketSize)
+        emitBucket(lineData, summarize(begin, dataBegin + firstBucket * bucketSize));
+
+    const auto &buckets = m_Levels[level];
+    for (int i = firstBucket; i < lastBucket; i++)
+        emitBucket(lineData, buckets[i]);
+
+    if (lastBucket * bucketSize < last)
+        emitBucket(lineData, summarize(dataBegin + lastBucket * bucketSize, end));
+}
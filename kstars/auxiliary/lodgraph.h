@@ -0,0 +1,64 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "qcustomplot.h"
+
+#include <QVector>
+
+/**
+ * @class LODGraph
+ * @short A QCPGraph for long time series, which draws a level of detail matching the zoom.
+ *
+ * QCPGraph decimates dense data for drawing, but it still visits every point in the
+ * visible range on every replot. For an all-night guide log that is tens of thousands of
+ * points per graph per frame.
+ *
+ * LODGraph keeps a pyramid of min/max summaries of its data. Level 0 summarizes runs of
+ * BUCKET_SIZE points, each further level merges two buckets of the level below. To draw,
+ * the coarsest level with buckets of no more than about one pixel's worth of points is
+ * used, so drawing costs in the order of the plot width rather than the number of points.
+ * Minima and maxima are kept, so spikes never disappear, and NaN gaps still break the line.
+ *
+ * The data itself is untouched, data() still returns every point. The pyramid follows
+ * points appended at the end incrementally, anything else (clearing, inserting earlier
+ * points, removing points) makes it rebuild on the next replot.
+ */
+class LODGraph : public QCPGraph
+{
+    public:
+        LODGraph(QCPAxis *keyAxis, QCPAxis *valueAxis);
+
+    protected:
+        void getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin,
+                                  const QCPGraphDataContainer::const_iterator &end) const override;
+
+    private:
+        struct Bucket
+        {
+            double minKey;
+            double minValue;
+            double maxKey;
+            double maxValue;
+            // Key of the first NaN point, NaN if there is none.
+            double gapKey;
+        };
+
+        void updatePyramid() const;
+        void appendBucket(int level, const Bucket &bucket) const;
+        static Bucket summarize(QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end);
+        static Bucket merge(const Bucket &first, const Bucket &second);
+        static void emitBucket(QVector<QCPGraphData> *lineData, const Bucket &bucket);
+
+        static constexpr int BUCKET_SIZE = 8;
+
+        mutable QVector<QVector<Bucket>> m_Levels;
+        // Used to notice that the data changed in other ways than appending points.
+        mutable const QCPGraphDataContainer *m_Container { nullptr };
+        mutable double m_FirstKey { 0 };
+        mutable double m_LastKey { 0 };
+};
@@ -0,0 +1,155 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "skyobjectnameindex.h"
+
+#include <QMutexLocker>
+#include <QStringMatcher>
+
+#include <algorithm>
+
+void SkyObjectNameIndex::update(int type, const EntryList &list)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    TypeIndex &index = m_Types[type];
+    if (!index.list.isSharedWith(list))
+        index.list = list;
+}
+
+int SkyObjectNameIndex::size(const QVector<int> &types) const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    int count = 0;
+    for (int type : types)
+        count += m_Types.value(type).list.size();
+    return count;
+}
+
+void SkyObjectNameIndex::build(TypeIndex &index)
+{
+    if (index.indexed.isSharedWith(index.list))
+        return;
+
+    const int indexedSize = index.indexed.size();
+    bool appended = indexedSize > 0 && index.list.size() >= indexedSize;
+    for (int i = 0; appended && i < indexedSize; ++i)
+        appended = index.list.at(i) == index.indexed.at(i);
+
+    const auto byName = [&index](int a, int b)
+    {
+        return index.folded.at(a) < index.folded.at(b);
+    };
+
+    index.indexed = index.list;
+    index.lastText.clear();
+    index.lastMatches.clear();
+
+    if (appended)
+    {
+        // Usually just a few objects loaded from the catalog database. Sort them
+        // and merge them in, equal names keep the order of the list.
+        const std::size_t sorted = index.order.size();
+        for (int i = indexedSize; i < index.indexed.size(); ++i)
+        {
+            index.folded.append(index.indexed.at(i).first.toCaseFolded());
+            index.order.push_back(i);
+        }
+        std::stable_sort(index.order.begin() + sorted, index.order.end(), byName);
+        std::inplace_merge(index.order.begin(), index.order.begin() + sorted, index.order.end(), byName);
+        return;
+    }
+
+    index.folded.clear();
+    index.folded.reserve(index.indexed.size());
+    for (const Entry &entry : qAsConst(index.indexed))
+        index.folded.append(entry.first.toCaseFolded());
+
+    index.order.resize(index.indexed.size());
+    for (int i = 0; i < index.indexed.size(); ++i)
+        index.order[i] = i;
+    std::stable_sort(index.order.begin(), index.order.end(), byName);
+}
+
+SkyObjectNameIndex::Result SkyObjectNameIndex::find(const QVector<int> &types, const QString &text)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    struct Match
+    {
+        const QString *name;
+        const Entry *entry;
+    };
+
+    const QString folded = text.toCaseFolded();
+    const QStringMatcher matcher(folded, Qt::CaseSensitive);
+
+    // Every type is sorted already, they only need to be merged
+    const auto byName = [](const Match &a, const Match &b)
+    {
+        return *a.name < *b.name;
+    };
+
+    std::vector<Match> matches;
+    for (int type : types)
+    {
+        auto it = m_Types.find(type);
+        if (it == m_Types.end())
+            continue;
+
+        TypeIndex &index = it.value();
+        build(index);
+
+        const std::size_t begin = matches.size();
+        if (folded.isEmpty())
+        {
+            for (int i : index.order)
+                matches.push_back({ &index.folded.at(i), &index.indexed.at(i) });
+        }
+        else
+        {
+            // Names containing the new text also contain the previous one
+            const bool refine = !index.lastText.isEmpty() && folded.contains(index.lastText);
+            const std::vector<int> &candidates = refine ? index.lastMatches : index.order;
+
+            std::vector<int> found;
+            for (int i : candidates)
+            {
+                if (matcher.indexIn(index.folded.at(i)) >= 0)
+                    found.push_back(i);
+            }
+
+            for (int i : found)
+                matches.push_back({ &index.folded.at(i), &index.indexed.at(i) });
+
+            index.lastText    = folded;
+            index.lastMatches = std::move(found);
+        }
+
+        std::inplace_merge(matches.begin(), matches.begin() + begin, matches.end(), byName);
+    }
+
+    Result result;
+    result.entries.reserve(static_cast<int>(matches.size()));
+    for (const Match &match : matches)
+        result.entries.append(*match.entry);
+
+    if (!folded.isEmpty())
+    {
+        const auto first = std::lower_bound(matches.begin(), matches.end(), folded, [](const Match &match, const QString &name)
+        {
+            return *match.name < name;
+        });
+        if (first != matches.end() && first->name->startsWith(folded))
+        {
+            result.prefixMatch = static_cast<int>(first - matches.begin());
+            result.exactMatch  = *first->name == folded;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+class SkyObject;
+
+/**
+ * @class SkyObjectNameIndex
+ * Index of the object name lists of SkyMapComposite, one per object type, to look up
+ * all names containing a text, ignoring the case.
+ *
+ * The names of each type are case folded and sorted once, so the matches come out
+ * sorted and the first name starting with the text is found by a binary search. A
+ * lookup which refines the previous one of a type (i.e. its text contains the
+ * previous text) only checks the previous matches.
+ *
+ * The index keeps a shallow copy of each list it is given. Whether a list changed
+ * is told by the copy no longer sharing its data with the list, which the
+ * components detach whenever they add or remove names. Names which were only
+ * appended are sorted in, everything else rebuilds the index of that type on the
+ * next lookup.
+ *
+ * All methods are thread safe, find() is meant to run on a worker thread for long
+ * lists. The objects in the lists are never touched.
+ *
+ * @short Name index for the Find Object Dialog
+ */
+class SkyObjectNameIndex
+{
+    public:
+        using Entry     = QPair<QString, const SkyObject *>;
+        using EntryList = QVector<Entry>;
+
+        struct Result
+        {
+            /** Entries whose name contains the text, sorted by name ignoring the case. */
+            EntryList entries;
+            /** Index of the first entry whose name starts with the text, -1 if there is none. */
+            int prefixMatch { -1 };
+            /** Whether the name of an entry equals the text, ignoring the case. */
+            bool exactMatch { false };
+        };
+
+        /**
+         * @short Update the list of names of an object type.
+         * This is cheap if @p list did not change since the last call.
+         */
+        void update(int type, const EntryList &list);
+
+        /** @return the number of names of @p types */
+        int size(const QVector<int> &types) const;
+
+        /** @return the entries of @p types whose name contains @p text, ignoring the case */
+        Result find(const QVector<int> &types, const QString &text);
+
+    private:
+        struct TypeIndex
+        {
+            /** The list as given to update(). */
+            EntryList list;
+            /** The list the index was built from. */
+            EntryList indexed;
+            /** The case folded names of indexed. */
+            QVector<QString> folded;
+            /** Indices into indexed sorted by folded name. */
+            std::vector<int> order;
+            /** The folded text of the last lookup and its matches, in the order of order. */
+            QString lastText;
+            std::vector<int> lastMatches;
+        };
+
+        /** Bring the index of @p index up to date with its list. */
+        static void build(TypeIndex &index);
+
+        mutable QMutex m_Mutex;
+        QHash<int, TypeIndex> m_Types;
+};
@@ -10,6 +10,8 @@
 #include <QSqlRecord>
 #include <QMutexLocker>
 #include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QtConcurrent>
 #include <qsqldatabase.h>
 #include "cachingdms.h"
 #include "catalogsdb.h"
@@ -167,6 +169,21 @@ DBManager::DBManager(const QString &filename) : m_db_file(filename)
                                 m_db.lastError());
         }
     }
+    else
+    {
+        // databases of older versions have no name index yet
+        QSqlQuery index_exists{ m_db };
+        index_exists.exec(SqlStatements::exists_master_name_index);
+        m_name_index = index_exists.next();
+        index_exists.finish();
+
+        if (!m_name_index)
+        {
+            m_db.transaction();
+            m_name_index = create_name_index();
+            m_db.commit();
+        }
+    }
 
     m_q_cat_by_id         = make_query(m_db, SqlStatements::get_catalog_by_id, true);
     m_q_obj_by_trixel     = make_query(m_db, SqlStatements::dso_by_trixel, false);
@@ -343,7 +360,11 @@ bool DBManager::compile_master_catalog()
     QSqlQuery query{ m_db };
     m_db.transaction();
 
-    if (!query.exec(SqlStatements::drop_master))
+    constexpr int steps = 8;
+    report_progress(0, steps);
+
+    if (!query.exec(SqlStatements::drop_master_name_index) ||
+        !query.exec(SqlStatements::drop_master))
     {
         return false;
     }
@@ -352,15 +373,113 @@ bool DBManager::compile_master_catalog()
     {
         return false;
     }
+    report_progress(2, steps);
 
     bool success = true;
     success &= query.exec(SqlStatements::create_master_trixel_index);
+    report_progress(3, steps);
     success &= query.exec(SqlStatements::create_master_mag_index);
+    report_progress(4, steps);
     success &= query.exec(SqlStatements::create_master_type_index);
+    report_progress(5, steps);
     success &= query.exec(SqlStatements::create_master_name_index);
+    report_progress(6, steps);
+    success &= query.exec(SqlStatements::create_master_oid_index);
+    report_progress(7, steps);
+
+    // not fatal, name queries just get slower without it
+    m_name_index = create_name_index();
+    report_progress(steps, steps);
     return success;
 };
 
+bool DBManager::update_master_catalog(const int catalog_id)
+{
+    return update_master_objects(SqlStatements::catalog_oids(catalog_id));
+}
+
+bool DBManager::update_master_objects(const QString &oids, const QVariant &oid)
+{
+    QSqlQuery query{ m_db };
+    m_db.transaction();
+
+    constexpr int steps = 3;
+    report_progress(0, steps);
+
+    // Cheap once they exist. Catalogs imported from files and masters
+    // of older versions come without them.
+    const auto &ids = get_catalog_ids();
+    bool success    = query.exec(SqlStatements::create_master_oid_index);
+    for (const auto id : ids)
+        success = success && query.exec(SqlStatements::create_catalog_oid_index(id));
+
+    if (!success)
+    {
+        m_db.rollback();
+        return false;
+    }
+    report_progress(1, steps);
+
+    // The objects are taken out and merged again from the enabled
+    // catalogs, just like compile_master_catalog does for all of them.
+    // The triggers of the name index follow along. Either both happen
+    // or neither, the objects must not go missing from the master.
+    query.prepare(SqlStatements::remove_master_objects(oids));
+    if (oid.isValid())
+        query.bindValue(":oid", oid);
+
+    if (!query.exec())
+    {
+        m_db.rollback();
+        return false;
+    }
+    report_progress(2, steps);
+
+    if (!ids.empty())
+    {
+        query.prepare(SqlStatements::insert_master_objects(ids, oids));
+        if (oid.isValid())
+            query.bindValue(":oid", oid);
+
+        if (!query.exec())
+        {
+            m_db.rollback();
+            return false;
+        }
+    }
+
+    if (!m_db.commit())
+        return false;
+
+    report_progress(steps, steps);
+    return true;
+}
+
+void DBManager::report_progress(const int done, const int total)
+{
+    if (m_progress)
+        m_progress(done, total);
+}
+
+bool DBManager::create_name_index()
+{
+    QSqlQuery query{ m_db };
+
+    if (!query.exec(SqlStatements::drop_master_name_index) ||
+        !query.exec(SqlStatements::create_master_name_index_table))
+        return false;
+
+    if (query.exec(SqlStatements::fill_master_name_index) &&
+        query.exec(SqlStatements::create_master_name_insert_trigger) &&
+        query.exec(SqlStatements::create_master_name_delete_trigger) &&
+        query.exec(SqlStatements::create_master_name_update_trigger))
+        return true;
+
+    // a partial index would hide objects, rather have none
+    query.exec(SqlStatements::drop_master_name_index);
+    return false;
+}
+
 const Catalog read_catalog(const QSqlQuery &query)
 {
     return { query.value("id").toInt(),
@@ -514,10 +633,21 @@ CatalogObjectList DBManager::find_objects_by_name(const QString &name, const int
 
     Q_ASSERT(objs.size() <= 1);
 
-    m_q_obj_by_name.bindValue(":name", name);
-    m_q_obj_by_name.bindValue(":limit", int(limit - objs.size()));
+    // trigrams can't find shorter substrings, those need a scan
+    const bool indexed =
+        m_name_index && name.size() >= SqlStatements::min_name_index_query;
 
-    CatalogObjectList moreObjects = fetch_objects(m_q_obj_by_name);
+    if (indexed && m_q_obj_by_name_indexed.lastQuery().isEmpty())
+        m_q_obj_by_name_indexed =
+            make_query(m_db, SqlStatements::dso_by_name_indexed, true);
+
+    QSqlQuery &query = indexed ? m_q_obj_by_name_indexed : m_q_obj_by_name;
+    query.bindValue(":name", name);
+    if (indexed)
+        query.bindValue(":match", SqlStatements::name_index_match(name));
+    query.bindValue(":limit", int(limit - objs.size()));
+
+    CatalogObjectList moreObjects = fetch_objects(query);
     moreObjects.splice(moreObjects.begin(), objs);
     return moreObjects;
 
@@ -624,7 +754,7 @@ std::pair<bool, QString> DBManager::set_catalog_enabled(const int id, const bool
     query.bindValue(":enabled", enabled);
     query.bindValue(":id", id);
 
-    return { query.exec() &&update_catalog_views() &&compile_master_catalog(),
+    return { query.exec() &&update_catalog_views() &&update_master_catalog(id),
              query.lastError().text() + m_db.lastError().text() };
 }
 
@@ -686,6 +816,36 @@ inline void bind_catalogobject(QSqlQuery &query, const int catalog_id,
                        trixel, obj.getObjectId());
 };
 
+/**
+ * \returns the values of \p obj in the order of
+ * `SqlStatements::catalog_collumns`, as `bind_catalogobject` binds them.
+ */
+inline std::array<QVariant, SqlStatements::catalog_collumns.size()>
+catalogobject_values(const int catalog_id, const CatalogObject &obj, Trixel trixel)
+{
+    const auto m  = obj.mag();
+    const auto a  = obj.a();
+    const auto b  = obj.b();
+    const auto pa = obj.pa();
+    const auto f  = obj.flux();
+
+    return { obj.getObjectId(),
+             obj.getObjectId(),
+             static_cast<int>(obj.type()),
+             obj.ra0().Degrees(),
+             obj.dec0().Degrees(),
+             (m < 99 && !std::isnan(m)) ? m : QVariant{},
+             obj.name(),
+             obj.longname().length() > 0 ? obj.longname() : QVariant{},
+             obj.catalogIdentifier().length() > 0 ? obj.catalogIdentifier() : QVariant{},
+             a > 0 ? a : QVariant{},
+             b > 0 ? b : QVariant{},
+             pa > 0 ? pa : QVariant{},
+             f > 0 ? f : QVariant{},
+             trixel,
+             catalog_id };
+}
+
 std::pair<bool, QString> DBManager::add_object(const int catalog_id,
         const CatalogObject &obj)
 {
@@ -727,7 +887,7 @@ DBManager::add_object(const int catalog_id, const SkyObject::TYPE t, const Cachi
         return { false, i18n("Could not insert object! %1", err) };
     }
 
-    return { update_catalog_views() &&compile_master_catalog(),
+    return { update_catalog_views() &&update_master_objects(":oid", new_id),
              m_db.lastError().text() };
 }
 
@@ -742,7 +902,7 @@ std::pair<bool, QString> DBManager::remove_object(const int catalog_id,
     if (!query.exec())
         return { false, query.lastError().text() };
 
-    return { update_catalog_views() &&compile_master_catalog(),
+    return { update_catalog_views() &&update_master_objects(":oid", id),
              m_db.lastError().text() };
 }
 
@@ -882,7 +1042,7 @@ std::pair<bool, QString> DBManager::import_catalog(const QString &file_path,
 
     m_db.commit();
 
-    if (!update_catalog_views() || !compile_master_catalog())
+    if (!update_catalog_views() || !update_master_catalog(id))
         return { false, i18n("Could not refresh the master catalog.<br>",
                              m_db.lastError().text()) };
 
@@ -939,6 +1099,9 @@ std::pair<bool, QString> DBManager::copy_objects(const int id_1, const int id_2)
     if (!query.exec(SqlStatements::set_catalog_all_objects(id_2)))
         return { false, query.lastError().text() };
 
+    if (!update_master_catalog(id_2))
+        return { false, m_db.lastError().text() };
+
     return { true, {} };
 }
 
@@ -1054,7 +1217,8 @@ DBManager::get_catalog_statistics(const int catalog_id)
 
 std::pair<bool, QString>
 CatalogsDB::DBManager::add_objects(const int catalog_id,
-                                   const CatalogObjectVector &objects)
+                                   const CatalogObjectVector &objects,
+                                   const std::function<bool()> &cancelled)
 {
     {
         const auto &success = get_catalog(catalog_id);
@@ -1065,26 +1229,87 @@ CatalogsDB::DBManager::add_objects(const int catalog_id,
             return { false, i18n("Catalog is immutable!") };
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
+    // The trixels only depend on the coordinates, the workers share
+    // the mesh which is only read here.
+    const HTMesh *mesh = SkyMesh::Create(m_htmesh_level);
+    const std::size_t count = objects.size();
+    std::vector<Trixel> trixels(count);
+
+    constexpr std::size_t block_size = 4096;
+    std::vector<std::size_t> blocks;
+    for (std::size_t begin = 0; begin < count; begin += block_size)
+        blocks.push_back(begin);
+
+    QtConcurrent::blockingMap(blocks, [&](const std::size_t begin)
+    {
+        const auto end = std::min(begin + block_size, count);
+        for (auto i = begin; i < end; i++)
+            trixels[i] = mesh->index(objects[i].ra0().Degrees(), objects[i].dec0().Degrees());
+    });
+
+    constexpr std::size_t max_rows = SqlStatements::max_insert_rows;
+    constexpr std::size_t progress_rows = 64 * max_rows;
+    const auto columns = static_cast<int>(SqlStatements::catalog_collumns.size());
+
     m_db.transaction();
-    QSqlQuery query{ m_db };
-    for (const auto &object : objects)
+    QSqlQuery bulk_query{ m_db }, tail_query{ m_db };
+    if (!bulk_query.prepare(SqlStatements::insert_dsos(catalog_id, max_rows)))
     {
-        SkyPoint tmp{ object.ra(), object.dec() };
-        const auto trixel = SkyMesh::Create(m_htmesh_level)->index(&tmp);
+        m_db.rollback();
+        return { false, i18n("Could not insert object! %1", bulk_query.lastError().text()) };
+    }
 
-        bind_catalogobject(query, catalog_id, object, trixel);
+    report_progress(0, count);
+    for (std::size_t done = 0; done < count;)
+    {
+        const auto rows = std::min(count - done, max_rows);
+        auto &query     = rows == max_rows ? bulk_query : tail_query;
+        if (rows < max_rows)
+            query.prepare(SqlStatements::insert_dsos(catalog_id, rows));
+
+        for (std::size_t row = 0; row < rows; row++)
+        {
+            const auto &values =
+                catalogobject_values(catalog_id, objects[done + row], trixels[done + row]);
+
+            for (int column = 0; column < columns; column++)
+                query.bindValue(static_cast<int>(row) * columns + column, values[column]);
+        }
 
         if (!query.exec())
         {
             auto err = query.lastError().text();
+            m_db.rollback();
+
             if (err.startsWith("UNIQUE"))
                 err = i18n("The object is already in the catalog!");
 
             return { false, i18n("Could not insert object! %1", err) };
         }
+
+        done += rows;
+        if (done % progress_rows == 0 || done == count)
+        {
+            report_progress(done, count);
+
+            if (cancelled && cancelled())
+            {
+                m_db.rollback();
+                return { false, i18n("The import was cancelled.") };
+            }
+        }
     }
 
-    return { m_db.commit() &&update_catalog_views() &&compile_master_catalog(),
+    if (!m_db.commit())
+        return { false, m_db.lastError().text() };
+
+    qCDebug(KSTARS_CATALOGS) << "Inserted" << count << "objects in" << timer.elapsed()
+                             << "ms";
+
+    return { update_catalog_views() &&update_master_catalog(catalog_id),
              m_db.lastError().text() };
 };
 
@@ -9,6 +9,7 @@
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <exception>
+#include <functional>
 #include <list>
 #include <QString>
 #include <QList>
@@ -206,6 +207,8 @@ class DBManager
         swap(m_q_obj_by_trixel_no_nulls, other.m_q_obj_by_trixel_no_nulls);
         swap(m_q_obj_by_trixel_null_mag, other.m_q_obj_by_trixel_null_mag);
         swap(m_q_obj_by_name, other.m_q_obj_by_name);
+        swap(m_q_obj_by_name_indexed, other.m_q_obj_by_name_indexed);
+        swap(m_name_index, other.m_name_index);
         swap(m_q_obj_by_name_exact, other.m_q_obj_by_name_exact);
         swap(m_q_obj_by_lim, other.m_q_obj_by_lim);
         swap(m_q_obj_by_maglim, other.m_q_obj_by_maglim);
@@ -403,11 +406,17 @@ class DBManager
      * Add the \p `objects` to a table with \p `catalog_id`. For the
      * rest of the arguments see `CatalogObject::CatalogObject`.
      *
+     * The trixels are computed in parallel and the objects are inserted
+     * many at a time in a single transaction. The number of inserted
+     * objects is reported to the progress callback, after which \p
+     * cancelled is asked whether to roll the import back.
+     *
      * \returns wether the operation was successful and if not, an
      * error message
      */
     std::pair<bool, QString> add_objects(const int catalog_id,
-                                         const CatalogObjectVector &objects);
+                                         const CatalogObjectVector &objects,
+                                         const std::function<bool()> &cancelled = {});
 
     /**
      * Remove the catalog object with the \p `oid` from the catalog with the
@@ -507,13 +516,39 @@ class DBManager
     /**
      * Compiles the master catalog by merging the individual catalogs based
      * on `oid` and precedence and creates an index by (trixel, magnitude) on
-     * the master table. **Caution** you may want to call
+     * the master table, as well as a full text index of the names. **Caution** you may want to call
      * `update_catalog_views` beforhand.
      *
+     * This rewrites the whole master table, see `update_master_catalog`
+     * for changes to a single catalog.
+     *
      * @return true in case of success, false in case of an error
      */
     bool compile_master_catalog();
 
+    /**
+     * Updates the master catalog in place after the catalog with \p
+     * catalog_id was enabled, disabled or got new objects. Only the
+     * objects of that catalog are merged again, as
+     * `compile_master_catalog` would merge them. **Caution** you may
+     * want to call `update_catalog_views` beforhand.
+     *
+     * @return true in case of success, false in case of an error
+     */
+    bool update_master_catalog(const int catalog_id);
+
+    /**
+     * Called with the steps done so far and the total number of steps
+     * while the master catalog is compiled or updated.
+     */
+    using ProgressCallback = std::function<void(int done, int total)>;
+
+    /** Sets the function to report progress on the master catalog to. */
+    void set_progress_callback(ProgressCallback callback)
+    {
+        m_progress = std::move(callback);
+    }
+
     /**
      * Updates the all_catalog_view so that it includes all known
      * catalogs.
@@ -571,6 +606,7 @@ class DBManager
     QSqlQuery m_q_obj_by_trixel_null_mag;
     QSqlQuery m_q_obj_by_trixel_no_nulls;
     QSqlQuery m_q_obj_by_name;
+    QSqlQuery m_q_obj_by_name_indexed;
     QSqlQuery m_q_obj_by_name_exact;
     QSqlQuery m_q_obj_by_lim;
     QSqlQuery m_q_obj_by_maglim;
@@ -597,6 +633,15 @@ class DBManager
      */
     int m_db_version = -1;
 
+    /**
+     * Whether the trigram name index of the master catalog is
+     * available. It needs FTS5 support in SQLite.
+     */
+    bool m_name_index = false;
+
+    /** Receives the progress on the master catalog, may be empty. */
+    ProgressCallback m_progress;
+
     /**
      * A simple mutex to be locked when using prepared statements,
      * that are stored in the class.
@@ -619,6 +664,27 @@ class DBManager
      */
     bool initialize_db();
 
+    /**
+     * (Re)creates the trigram index `SqlStatements::master_name_index`
+     * over the names in the master catalog and the triggers that keep
+     * it up to date. Must be called in a transaction.
+     *
+     * @return true if the index is available
+     */
+    bool create_name_index();
+
+    /**
+     * Replaces the objects with the oids selected by the sql expression
+     * \p oids in the master catalog by merging them again from the
+     * enabled catalogs. If \p oids refers to `:oid`, \p oid is bound to
+     * it.
+     *
+     * @return true in case of success, false in case of an error
+     */
+    bool update_master_objects(const QString &oids, const QVariant &oid = {});
+
+    void report_progress(const int done, const int total);
+
     /**
      * Reads the database version and the htmesh level from the
      * database. If the meta table does not exist, the default vaulues
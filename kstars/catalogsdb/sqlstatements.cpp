@@ -6,6 +6,7 @@
 
 #pragma once
 #include <array>
+#include <vector>
 #include <QString>
 #include <QStringList>
 
@@ -32,6 +33,7 @@ constexpr int default_htmesh_level = 3;
 constexpr int user_catalog_id      = 0;
 const QString user_catalog_name    = "user";
 const QString master_catalog       = "master";
+const QString master_name_index    = "master_names";
 const QString all_catalog_view     = "all_catalogs";
 const QString colors_table         = "catalog_colors";
 
@@ -299,6 +301,86 @@ const QString create_master_name_index =
     "COLLATE NOCASE ASC, long_name COLLATE NOCASE ASC, "
     "magnitude ASC)";
 
+/* incremental updates of the master catalog */
+const QString create_master_oid_index =
+    "CREATE INDEX IF NOT EXISTS master_oid ON master(oid)";
+
+inline const QString create_catalog_oid_index(const int id)
+{
+    return QString("CREATE INDEX IF NOT EXISTS cat_%1_oid ON cat_%1(oid)").arg(id);
+}
+
+inline const QString catalog_oids(const int id)
+{
+    return QString("SELECT oid FROM cat_%1").arg(id);
+}
+
+inline const QString remove_master_objects(const QString &oids)
+{
+    return QString("DELETE FROM master WHERE oid IN (%1)").arg(oids);
+}
+
+// The filter has to go into every catalog, sqlite does not push it
+// down into the all_catalogs view.
+inline const QString insert_master_objects(const std::vector<int> &ids,
+                                           const QString &oids)
+{
+    const auto fields =
+        create_field_list(catalog_collumns.begin(), catalog_collumns.end(), "c.");
+
+    QStringList catalogs;
+    for (const auto id : ids)
+        catalogs << all_catalog_view_body(fields, catalog_prefix, id) +
+                        QString(" WHERE c.oid IN (%1)").arg(oids);
+
+    return QString("INSERT INTO master (%1) SELECT %1 FROM (%2) GROUP BY oid "
+                   "ORDER BY MAX(precedence)")
+        .arg(master_catalog_fields)
+        .arg(catalogs.join(" UNION ALL "));
+}
+
+/* full text index of the names in the master catalog */
+// The trigram tokenizer needs SQLite 3.34 with FTS5, without it the
+// name queries fall back to a scan of the master catalog.
+const QString drop_master_name_index = "DROP TABLE IF EXISTS master_names";
+
+const QString create_master_name_index_table =
+    "CREATE VIRTUAL TABLE master_names USING fts5(name, long_name, "
+    "catalog_identifier, content='master', tokenize='trigram')";
+
+const QString fill_master_name_index =
+    "INSERT INTO master_names(master_names) VALUES('rebuild')";
+
+// keeps the index in sync with rows inserted into or removed from master
+const QString create_master_name_insert_trigger =
+    "CREATE TRIGGER master_names_insert AFTER INSERT ON master BEGIN "
+    "INSERT INTO master_names(rowid, name, long_name, catalog_identifier) "
+    "VALUES (new.rowid, new.name, new.long_name, new.catalog_identifier); END";
+
+const QString create_master_name_delete_trigger =
+    "CREATE TRIGGER master_names_delete AFTER DELETE ON master BEGIN "
+    "INSERT INTO master_names(master_names, rowid, name, long_name, catalog_identifier) "
+    "VALUES ('delete', old.rowid, old.name, old.long_name, old.catalog_identifier); END";
+
+const QString create_master_name_update_trigger =
+    "CREATE TRIGGER master_names_update AFTER UPDATE ON master BEGIN "
+    "INSERT INTO master_names(master_names, rowid, name, long_name, catalog_identifier) "
+    "VALUES ('delete', old.rowid, old.name, old.long_name, old.catalog_identifier); "
+    "INSERT INTO master_names(rowid, name, long_name, catalog_identifier) "
+    "VALUES (new.rowid, new.name, new.long_name, new.catalog_identifier); END";
+
+const QString exists_master_name_index =
+    "SELECT name FROM sqlite_master WHERE type='table' AND name='master_names';";
+
+/** Trigrams can only find substrings at least this long. */
+constexpr int min_name_index_query = 3;
+
+/** \returns the fts5 query for \p name as a substring of name or long_name */
+inline QString name_index_match(QString name)
+{
+    return QString("{name long_name} : \"%1\"").arg(name.replace('"', "\"\""));
+}
+
 const QString get_first_catalog = "SELECT id, name, precedence, author, source, "
                                   "description, mut, enabled, version, color, license, "
                                   "maintainer, timestamp FROM catalogs LIMIT 1";
@@ -353,10 +435,20 @@ const QString _dso_by_name =
     "ORDER BY name, long_name, "
     "%2 LIMIT :limit";
 
+// same as _dso_by_name but the candidates come from the name index
+const QString _dso_by_name_indexed =
+    "SELECT %1, name like \"%\" || :name || \"%\" AS in_name, long_name like "
+    "\"%\" || :name || \"%\" AS in_lname FROM master WHERE rowid IN "
+    "(SELECT rowid FROM master_names WHERE master_names MATCH :match) "
+    "ORDER BY name, long_name, "
+    "%2 LIMIT :limit";
+
 const QString _dso_by_name_exact = "SELECT %1 FROM master WHERE name = :name LIMIT 1";
 
 const QString dso_by_name       = QString(_dso_by_name).arg(object_fields).arg(mag_asc);
 const QString dso_by_name_exact = QString(_dso_by_name_exact).arg(object_fields);
+const QString dso_by_name_indexed =
+    QString(_dso_by_name_indexed).arg(object_fields).arg(mag_asc);
 
 inline const QString dso_by_name_and_catalog(const int id)
 {
@@ -433,6 +525,33 @@ inline const QString insert_dso(int catalog_id)
     return _insert_dso.arg(catalog_id);
 }
 
+/**
+ * The most objects inserted by a single `insert_dsos` statement. SQLite
+ * before 3.32 allows no more than 999 parameters per statement.
+ */
+constexpr int max_insert_rows = 999 / catalog_collumns.size();
+
+/**
+ * Inserts \p rows objects at once into the catalog with \p catalog_id.
+ * The values are bound by position, row by row, in the order of
+ * `catalog_collumns`.
+ */
+inline const QString insert_dsos(int catalog_id, int rows)
+{
+    QStringList placeholders;
+    for (std::size_t i = 0; i < catalog_collumns.size(); i++)
+        placeholders << "?";
+
+    QStringList values;
+    for (int i = 0; i < rows; i++)
+        values << placeholders.join(", ");
+
+    return QString(_insert_dso_template)
+        .arg(catalog_fields)
+        .arg(values.join("), ("))
+        .arg(catalog_id);
+}
+
 const QString _remove_dso{ "DELETE FROM cat_%1 WHERE oid = :oid" };
 inline const QString remove_dso(const int id)
 {
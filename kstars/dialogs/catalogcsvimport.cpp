@@ -13,6 +13,9 @@
 #include <QLabel>
 #include <QComboBox>
 #include <QFormLayout>
+#include <QFutureWatcher>
+#include <QProgressDialog>
+#include <QtConcurrent>
 
 /**
  * Maps the name of the field to a tuple [Tooltip, Unit, Can be ignored?]
@@ -298,7 +301,6 @@ void CatalogCSVImport::read_n_objects(size_t n)
     const CatalogObject defaults{};
 
     m_objects.clear();
-    m_objects.reserve(std::min(m_doc.GetRowCount(), n));
 
     //  pure magic, it's like LISP macros
     const auto make_getter = [this, &column_map](const QString &field, auto def) {
@@ -383,26 +385,75 @@ void CatalogCSVImport::read_n_objects(size_t n)
     const auto get_pa         = make_getter("Position Angle", defaults.pa());
     const auto get_flux       = make_getter("Flux", defaults.flux());
 
-    for (size_t i = 0; i < std::min(m_doc.GetRowCount(), n); i++)
+    // The document is only read from here on, so the rows are
+    // converted in parallel chunks which are joined in order.
+    struct row_chunk
     {
-        const auto &raw_type = get_type(i);
-
-        const auto type = parse_type(raw_type, type_map);
-
-        const auto ra         = get_ra(i);
-        const auto dec        = get_dec(i);
-        const auto mag        = get_mag(i);
-        const auto name       = get_name(i);
-        const auto long_name  = get_long_name(i);
-        const auto identifier = get_identifier(i);
-        const auto a          = get_a(i);
-        const auto b          = get_b(i);
-        const auto pa         = get_pa(i);
-        const auto flux       = get_flux(i);
-
-        m_objects.emplace_back(CatalogObject::oid{}, type, ra, dec, mag, name, long_name,
-                               identifier, -1, a, b, pa, flux);
+        size_t begin;
+        std::vector<CatalogObject> objects;
+    };
+
+    const auto count = std::min(m_doc.GetRowCount(), n);
+    std::vector<row_chunk> chunks;
+    for (size_t begin = 0; begin < count; begin += chunk_size)
+        chunks.push_back({ begin, {} });
+
+    const auto read_chunk = [&](row_chunk &chunk) {
+        const auto end = std::min(chunk.begin + chunk_size, count);
+        chunk.objects.reserve(end - chunk.begin);
+
+        for (size_t i = chunk.begin; i < end; i++)
+        {
+            const auto &raw_type = get_type(i);
+
+            const auto type = parse_type(raw_type, type_map);
+
+            const auto ra         = get_ra(i);
+            const auto dec        = get_dec(i);
+            const auto mag        = get_mag(i);
+            const auto name       = get_name(i);
+            const auto long_name  = get_long_name(i);
+            const auto identifier = get_identifier(i);
+            const auto a          = get_a(i);
+            const auto b          = get_b(i);
+            const auto pa         = get_pa(i);
+            const auto flux       = get_flux(i);
+
+            chunk.objects.emplace_back(CatalogObject::oid{}, type, ra, dec, mag, name,
+                                       long_name, identifier, -1, a, b, pa, flux);
+        }
+    };
+
+    QFutureWatcher<void> watcher;
+    watcher.setFuture(QtConcurrent::map(chunks, read_chunk));
+
+    // only worth a progress dialog if there is more than one chunk
+    if (chunks.size() > 1)
+    {
+        QProgressDialog progress(i18n("Reading the objects..."), i18n("Cancel"), 0, 0,
+                                 this);
+        progress.setWindowModality(Qt::WindowModal);
+
+        connect(&watcher, &QFutureWatcherBase::progressRangeChanged, &progress,
+                &QProgressDialog::setRange);
+        connect(&watcher, &QFutureWatcherBase::progressValueChanged, &progress,
+                &QProgressDialog::setValue);
+        connect(&watcher, &QFutureWatcherBase::finished, &progress,
+                &QProgressDialog::reset);
+        connect(&progress, &QProgressDialog::canceled, &watcher,
+                &QFutureWatcherBase::cancel);
+
+        progress.exec();
     }
+    watcher.waitForFinished();
+
+    if (watcher.isCanceled())
+        return;
+
+    m_objects.reserve(count);
+    for (auto &chunk : chunks)
+        std::move(chunk.objects.begin(), chunk.objects.end(),
+                  std::back_inserter(m_objects));
 };
 
 SkyObject::TYPE CatalogCSVImport::parse_type(const std::string &type,
@@ -92,6 +92,10 @@ class CatalogCSVImport : public QDialog
     using column_pair = std::pair<int, QString>;
     using column_map  = std::unordered_map<QString, column_pair>;
 
+    /**
+     * \returns the objects read from the csv, empty if reading them
+     * was cancelled
+     */
     inline const std::vector<CatalogObject> &get_objects() const { return m_objects; };
   private slots:
     /** Selects a CSV file and opens it. Calls `init_mapping_selectors`. */
@@ -162,6 +166,9 @@ class CatalogCSVImport : public QDialog
     static const char default_separator = ',';
     static const char default_comment     = '#';
     static const int default_preview_size = 10;
+
+    /** How many rows are converted by a worker thread at a time. */
+    static constexpr size_t chunk_size = 4096;
 };
 
 #endif // CATALOGCSVIMPORT_H
@@ -5,6 +5,8 @@
 */
 
 #include <QMessageBox>
+#include <QElapsedTimer>
+#include <QProgressDialog>
 #include "catalogdetails.h"
 #include "detaildialog.h"
 #include "kstarsdata.h"
@@ -15,6 +17,7 @@
 #include "catalogcsvimport.h"
 #include "skymapcomposite.h"
 #include "catalogscomponent.h"
+#include "final_action.h"
 
 constexpr int CatalogDetails::list_size;
 
@@ -207,9 +210,48 @@ void CatalogDetails::import_csv()
     if (dialog.exec() != QDialog::Accepted)
         return;
 
-    const auto &success_add = m_manager.add_objects(m_catalog.id, dialog.get_objects());
+    const auto &objects = dialog.get_objects();
+    if (objects.empty())
+        return;
+
+    const auto count = static_cast<int>(objects.size());
+    QProgressDialog progress(i18n("Importing the objects..."), i18n("Cancel"), 0, count,
+                             this);
+    progress.setWindowModality(Qt::WindowModal);
+
+    // modal progress dialogs process events in setValue, so the
+    // cancel button works while the objects are inserted. The sky
+    // map must not read the master catalog in the meantime, its
+    // connection fails while the import holds the write lock.
+    auto *component = KStarsData::Instance()->skyComposite()->catalogsComponent();
+    component->suspendLoading();
+    auto _ = gsl::finally([&]() { component->resumeLoading(); });
+
+    QElapsedTimer timer;
+    timer.start();
+    m_manager.set_progress_callback([&](int done, int total) {
+        progress.setMaximum(total);
+        progress.setValue(done);
+
+        // the master catalog is updated after the objects are inserted
+        if (total != count)
+        {
+            progress.setLabelText(i18n("Updating the master catalog..."));
+            return;
+        }
+
+        const auto elapsed = std::max<qint64>(timer.elapsed(), 1);
+        progress.setLabelText(i18n("Importing the objects... (%1 objects per second)",
+                                   static_cast<qint64>(done) * 1000 / elapsed));
+    });
+
+    const auto &success_add = m_manager.add_objects(
+        m_catalog.id, objects, [&]() { return progress.wasCanceled(); });
+    m_manager.set_progress_callback({});
+    const auto cancelled = progress.wasCanceled();
+    progress.reset();
 
-    if (!success_add.first)
+    if (!success_add.first && !cancelled)
         QMessageBox::warning(this, i18n("Warning"),
                              i18n("Could not add the objects.<br>%1", success_add.second));
 
@@ -7,11 +7,17 @@
 #include <QCheckBox>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFutureWatcher>
+#include <QProgressDialog>
+#include <QtConcurrent>
 #include "catalogsdbui.h"
 #include "ui_catalogsdbui.h"
 #include "catalogeditform.h"
 #include "catalogdetails.h"
 #include "catalogcoloreditor.h"
+#include "kstarsdata.h"
+#include "skymapcomposite.h"
+#include "catalogscomponent.h"
 
 CatalogsDBUI::CatalogsDBUI(QWidget *parent, const QString &db_path)
     : QDialog(parent), ui{ new Ui::CatalogsDBUI }, m_manager{ db_path }, m_last_dir{
@@ -61,6 +67,9 @@ CatalogsDBUI::CatalogsDBUI(QWidget *parent, const QString &db_path)
 
 CatalogsDBUI::~CatalogsDBUI()
 {
+    // the worker reports its progress through this dialog
+    m_task.waitForFinished();
+    suspend_sky_map_loading(false);
     delete ui;
 }
 
@@ -146,15 +155,98 @@ void CatalogsDBUI::enable_disable_catalog()
     if (!catalog.first)
         return;
 
-    const auto success =
-        m_manager.set_catalog_enabled(catalog.second.id, !catalog.second.enabled);
-    if (!success.first)
-        QMessageBox::warning(
-            this, i18n("Warning"),
-            i18n("Could not enable/disable the catalog.<br>%1", success.second));
+    const auto id      = catalog.second.id;
+    const auto enabled = !catalog.second.enabled;
+    run_in_background(
+        [=](CatalogsDB::DBManager &manager) {
+            return manager.set_catalog_enabled(id, enabled);
+        },
+        [=](const Result &success) {
+            if (!success.first)
+                QMessageBox::warning(
+                    this, i18n("Warning"),
+                    i18n("Could not enable/disable the catalog.<br>%1", success.second));
+
+            const auto items = ui->objectsTable->selectedItems();
+            if (items.length() > 0)
+                row_selected(items.first()->row(), 0);
+        });
+}
 
-    refresh_db_table();
-    row_selected(ui->objectsTable->selectedItems().first()->row(), 0);
+void CatalogsDBUI::run_in_background(
+    const std::function<Result(CatalogsDB::DBManager &)> &task,
+    const std::function<void(const Result &)> &done)
+{
+    // only one writer at a time
+    if (m_task.isRunning())
+        return;
+
+    auto *progress = new QProgressDialog(i18n("Updating the catalog database..."),
+                                         QString(), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+
+    // the task can't be cancelled, so the dialog must not be dismissed
+    // with Esc or by closing it
+    disconnect(progress, &QProgressDialog::canceled, progress, &QProgressDialog::cancel);
+    connect(progress, &QProgressDialog::rejected, progress, &QProgressDialog::show);
+    connect(this, &CatalogsDBUI::masterCatalogProgress, progress,
+            [progress](int value, int maximum) {
+                progress->setMaximum(maximum);
+                progress->setValue(value);
+            });
+
+    // the sky map reads the master catalog through its own connection,
+    // which fails once the task holds the write lock
+    suspend_sky_map_loading(true);
+
+    auto *watcher = new QFutureWatcher<Result>(this);
+    connect(watcher, &QFutureWatcher<Result>::finished, this, [=]() {
+        progress->deleteLater();
+        watcher->deleteLater();
+        suspend_sky_map_loading(false);
+
+        refresh_db_table();
+        done(watcher->result());
+    });
+
+    // a DBManager is bound to the thread it was created in
+    const auto path = m_manager.db_file_name();
+    m_task          = QtConcurrent::run([this, path, task]() -> Result {
+        // an exception would only be rethrown by result() on the GUI thread
+        try
+        {
+            CatalogsDB::DBManager manager{ path };
+            manager.set_progress_callback([this](int value, int maximum) {
+                emit masterCatalogProgress(value, maximum);
+            });
+
+            return task(manager);
+        }
+        catch (const CatalogsDB::DatabaseError &e)
+        {
+            return { false, e.what() };
+        }
+    });
+    watcher->setFuture(m_task);
+}
+
+void CatalogsDBUI::suspend_sky_map_loading(const bool suspend)
+{
+    if (suspend == m_sky_map_loading_suspended)
+        return;
+
+    auto *data = KStarsData::Instance();
+    if (!data || !data->skyComposite())
+        return;
+
+    auto *component = data->skyComposite()->catalogsComponent();
+    if (suspend)
+        component->suspendLoading();
+    else
+        component->resumeLoading();
+
+    m_sky_map_loading_suspended = suspend;
 }
 
 const std::pair<bool, CatalogsDB::Catalog> CatalogsDBUI::get_selected_catalog()
@@ -202,20 +294,25 @@ void CatalogsDBUI::import_catalog(bool force)
         return;
 
     const auto fileName = dialog.selectedUrls().value(0).toLocalFile();
-    const auto success  = m_manager.import_catalog(fileName, force);
     m_last_dir          = QFileInfo(fileName).absolutePath();
 
-    if (!success.first && !force)
-    {
-        QMessageBox::warning(this, i18n("Warning"),
-                             i18n("Could not import the catalog.<br>%1", success.second));
-
-        if (QMessageBox::question(this, "Retry", "Retry and overwrite?",
-                                  QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes)
-            import_catalog(true);
-    }
-
-    refresh_db_table();
+    run_in_background(
+        [=](CatalogsDB::DBManager &manager) {
+            return manager.import_catalog(fileName, force);
+        },
+        [=](const Result &success) {
+            if (success.first || force)
+                return;
+
+            QMessageBox::warning(
+                this, i18n("Warning"),
+                i18n("Could not import the catalog.<br>%1", success.second));
+
+            if (QMessageBox::question(this, "Retry", "Retry and overwrite?",
+                                      QMessageBox::Yes | QMessageBox::No) ==
+                QMessageBox::Yes)
+                import_catalog(true);
+        });
 }
 
 void CatalogsDBUI::remove_catalog()
@@ -224,13 +321,15 @@ void CatalogsDBUI::remove_catalog()
     if (!cat.first)
         return;
 
-    const auto success = m_manager.remove_catalog(cat.second.id);
-
-    if (!success.first)
-        QMessageBox::warning(this, i18n("Warning"),
-                             i18n("Could not remove the catalog.<br>%1", success.second));
-
-    refresh_db_table();
+    const auto id = cat.second.id;
+    run_in_background(
+        [=](CatalogsDB::DBManager &manager) { return manager.remove_catalog(id); },
+        [=](const Result &success) {
+            if (!success.first)
+                QMessageBox::warning(
+                    this, i18n("Warning"),
+                    i18n("Could not remove the catalog.<br>%1", success.second));
+        });
 }
 
 std::pair<bool, int> CatalogsDBUI::create_new_catalog(const CatalogsDB::Catalog &catalog)
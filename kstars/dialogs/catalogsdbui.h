@@ -8,6 +8,8 @@
 #define CATALOGSDBUI_H
 
 #include <QDialog>
+#include <QFuture>
+#include <functional>
 #include "catalogsdb.h"
 
 namespace Ui
@@ -22,6 +24,11 @@ class CatalogsDBUI;
  * export, delete, enable, disable and clone catalogs. On request it
  * spawns a `CatalogDetails` dialog which can be be used to edit
  * `mutable` catalogs.
+ *
+ * Enabling, disabling, importing and removing catalogs changes the
+ * master catalog, which can take a while for large catalogs. These
+ * run on a worker thread with a connection of their own while the
+ * dialog shows their progress.
  */
 class CatalogsDBUI : public QDialog
 {
@@ -30,6 +37,13 @@ class CatalogsDBUI : public QDialog
     explicit CatalogsDBUI(QWidget *parent, const QString &db_path);
     ~CatalogsDBUI();
 
+  signals:
+    /**
+     * Emitted from the worker thread while the master catalog is
+     * updated, \sa CatalogsDB::DBManager::set_progress_callback
+     */
+    void masterCatalogProgress(int done, int total);
+
   private slots:
     /**
      * Activates the apropriate buttons.
@@ -117,6 +131,28 @@ class CatalogsDBUI : public QDialog
      */
     const std::pair<bool, CatalogsDB::Catalog> get_selected_catalog();
 
+    using Result = std::pair<bool, QString>;
+
+    /**
+     * Runs \p task on a worker thread and calls \p done with its result
+     * once it is finished. A modal progress dialog blocks the dialog
+     * in the meantime. Does nothing while another task is running.
+     */
+    void run_in_background(const std::function<Result(CatalogsDB::DBManager &)> &task,
+                           const std::function<void(const Result &)> &done);
+
+    /**
+     * Stops or resumes the loading of objects of the sky map's
+     * `CatalogsComponent` while a task writes to the database.
+     */
+    void suspend_sky_map_loading(const bool suspend);
+
+    /** The task started by `run_in_background`. */
+    QFuture<Result> m_task;
+
+    /** Whether `suspend_sky_map_loading` suspended the loading. */
+    bool m_sky_map_loading_suspended = false;
+
     /** Remeber the directory where we last loaded a catalog from */
     QString m_last_dir;
 };
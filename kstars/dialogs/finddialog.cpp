@@ -26,6 +26,13 @@
 #include <QComboBox>
 #include <QLineEdit>
 #include <QPointer>
+#include <QtConcurrent>
+
+namespace
+{
+// Lookups in more names than this run on a worker thread while typing
+const int backgroundSearchSize = 20000;
+}
 
 FindDialog *FindDialog::m_Instance = nullptr;
 
@@ -96,16 +103,21 @@ FindDialog::FindDialog(QWidget *parent)
 
     fModel = new SkyObjectListModel(this);
     connect(KStars::Instance()->map(), &SkyMap::removeSkyObject, fModel, &SkyObjectListModel::removeSkyObject);
+    // The name index hands over the matching names sorted already
     sortModel = new QSortFilterProxyModel(ui->SearchList);
-    sortModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
     sortModel->setSourceModel(fModel);
-    sortModel->setSortRole(Qt::DisplayRole);
-    sortModel->setFilterRole(Qt::DisplayRole);
-    sortModel->setDynamicSortFilter(true);
-    sortModel->sort(0);
+    sortModel->setDynamicSortFilter(false);
 
     ui->SearchList->setModel(sortModel);
 
+    connect(&m_SearchWatcher, &QFutureWatcherBase::finished, this, [this]()
+    {
+        if (m_SearchPending)
+            search(true);
+        else if (m_SearchSequence == m_currentSearchSequence)
+            showResult(m_SearchWatcher.result());
+    });
+
     // Connect signals to slots
     connect(ui->clearHistoryB, &QPushButton::clicked, [&]()
     {
@@ -148,6 +160,11 @@ FindDialog::FindDialog(QWidget *parent)
     listFiltered = false;
 }
 
+FindDialog::~FindDialog()
+{
+    m_SearchWatcher.waitForFinished();
+}
+
 void FindDialog::init()
 {
     const auto &objs = m_dbManager.get_objects(Options::magLimitDrawDeepSky(), 100);
@@ -157,9 +174,7 @@ void FindDialog::init()
             obj);
     }
     ui->SearchBox->clear();
-    filterByType();
-    sortModel->sort(0);
-    initSelection();
+    search(true);
     m_targetObject = nullptr;
 }
 
@@ -224,76 +239,64 @@ void FindDialog::initSelection()
     listFiltered = true;
 }
 
-void FindDialog::filterByType()
+QVector<int> FindDialog::selectedTypes() const
 {
-    KStarsData *data = KStarsData::Instance();
-
     switch (ui->FilterType->currentIndex())
     {
         case 0: // All object types
         {
-            QVector<QPair<QString, const SkyObject *>> allObjects;
-            foreach (int type, data->skyComposite()->objectLists().keys())
-            {
-                allObjects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
-            }
-            fModel->setSkyObjectsList(allObjects);
-            break;
+            QVector<int> types;
+            foreach (int type, KStarsData::Instance()->skyComposite()->objectLists().keys())
+                types.append(type);
+            return types;
         }
         case 1: //Stars
-        {
-            QVector<QPair<QString, const SkyObject *>> starObjects;
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-            fModel->setSkyObjectsList(starObjects);
-            break;
-        }
+            return { SkyObject::STAR, SkyObject::CATALOG_STAR };
         case 2: //Solar system
-        {
-            QVector<QPair<QString, const SkyObject *>> ssObjects;
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::PLANET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::COMET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::MOON));
-
-            fModel->setSkyObjectsList(ssObjects);
-            break;
-        }
+            return { SkyObject::PLANET, SkyObject::COMET, SkyObject::ASTEROID, SkyObject::MOON };
         case 3: //Open Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::OPEN_CLUSTER));
-            break;
+            return { SkyObject::OPEN_CLUSTER };
         case 4: //Globular Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GLOBULAR_CLUSTER));
-            break;
+            return { SkyObject::GLOBULAR_CLUSTER };
         case 5: //Gaseous nebulae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GASEOUS_NEBULA));
-            break;
+            return { SkyObject::GASEOUS_NEBULA };
         case 6: //Planetary nebula
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::PLANETARY_NEBULA));
-            break;
+            return { SkyObject::PLANETARY_NEBULA };
         case 7: //Galaxies
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GALAXY));
-            break;
+            return { SkyObject::GALAXY };
         case 8: //Comets
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::COMET));
-            break;
+            return { SkyObject::COMET };
         case 9: //Asteroids
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            break;
+            return { SkyObject::ASTEROID };
         case 10: //Constellations
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::CONSTELLATION));
-            break;
+            return { SkyObject::CONSTELLATION };
         case 11: //Supernovae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SUPERNOVA));
-            break;
+            return { SkyObject::SUPERNOVA };
         case 12: //Satellites
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SATELLITE));
-            break;
+            return { SkyObject::SATELLITE };
     }
+    return {};
 }
 
 void FindDialog::filterList()
 {
+    search(false);
+}
+
+void FindDialog::search(bool background)
+{
+    if (m_SearchWatcher.isRunning())
+    {
+        // Start over with the latest text once the running lookup is done
+        if (background)
+        {
+            m_SearchPending = true;
+            return;
+        }
+        m_SearchWatcher.waitForFinished();
+    }
+    m_SearchPending = false;
+
     QString SearchText = processSearchText();
     //const std::size_t searchId = m_currentSearchSequence;
 
@@ -321,23 +324,45 @@ void FindDialog::filterList()
             obj);
     }
 
-    sortModel->setFilterFixedString(SearchText);
     ui->InternetSearchButton->setText(i18n("Search the Internet for %1", SearchText.isEmpty() ? i18nc("no text to search for",
                                            "(nothing)") : SearchText));
-    filterByType();
+
+    m_SearchText           = SearchText;
+    m_EnableInternetSearch = (!exactMatchExists) && (ui->FilterType->currentIndex() == 0);
+
+    // Cheap for the lists which did not change since the last lookup
+    const QVector<int> types = selectedTypes();
+    SkyMapComposite *composite = KStarsData::Instance()->skyComposite();
+    for (int type : types)
+        m_NameIndex.update(type, composite->objectLists(type));
+
+    // Any running lookup is outdated now
+    const std::size_t sequence = ++m_currentSearchSequence;
+
+    if (!background || m_NameIndex.size(types) < backgroundSearchSize)
+    {
+        showResult(m_NameIndex.find(types, SearchText));
+        return;
+    }
+
+    m_SearchSequence = sequence;
+    m_SearchWatcher.setFuture(QtConcurrent::run([this, types, SearchText]()
+    {
+        return m_NameIndex.find(types, SearchText);
+    }));
+}
+
+void FindDialog::showResult(const SkyObjectNameIndex::Result &result)
+{
+    fModel->setSkyObjectsList(result.entries);
     initSelection();
 
-    bool enableInternetSearch = (!exactMatchExists) && (ui->FilterType->currentIndex() == 0);
     //Select the first item in the list that begins with the filter string
-    if (!SearchText.isEmpty())
+    if (!m_SearchText.isEmpty())
     {
-        QStringList mItems =
-            fModel->filter(QRegularExpression('^' + SearchText, QRegularExpression::CaseInsensitiveOption));
-        mItems.sort();
-
-        if (mItems.size())
+        if (result.prefixMatch >= 0)
         {
-            QModelIndex qmi        = fModel->index(fModel->indexOf(mItems[0]));
+            QModelIndex qmi        = fModel->index(result.prefixMatch);
             QModelIndex selectItem = sortModel->mapFromSource(qmi);
 
             if (selectItem.isValid())
@@ -348,8 +373,8 @@ void FindDialog::filterList()
                 ui->SearchList->setCurrentIndex(selectItem);
             }
         }
-        ui->InternetSearchButton->setEnabled(enableInternetSearch && !mItems.contains(
-                SearchText, Qt::CaseInsensitive)); // Disable searching the internet when an exact match for SearchText exists in KStars
+        ui->InternetSearchButton->setEnabled(m_EnableInternetSearch &&
+                                             !result.exactMatch); // Disable searching the internet when an exact match for SearchText exists in KStars
     }
     else
         ui->InternetSearchButton->setEnabled(false);
@@ -393,8 +418,7 @@ void FindDialog::enqueueSearch()
         timer->setSingleShot(true);
         connect(timer, &QTimer::timeout, [&]()
         {
-            this->m_currentSearchSequence++;
-            this->filterList();
+            this->search(true);
         });
     }
     timer->start(500);
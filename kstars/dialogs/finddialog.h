@@ -8,8 +8,10 @@
 
 #include "ui_finddialog.h"
 #include "catalogsdb.h"
+#include "skyobjectnameindex.h"
 
 #include <QDialog>
+#include <QFutureWatcher>
 #include <QKeyEvent>
 
 class QTimer;
@@ -33,6 +35,9 @@ class FindDialogUI : public QFrame, public Ui::FindDialog
  * a QListBox showing the list of named objects, a QLineEdit for filtering
  * the list by name, and a QCombobox for filtering the list by object type.
  *
+ * The names are looked up in a SkyObjectNameIndex. While typing, lookups in
+ * long lists run on a worker thread.
+ *
  * 2018-12 JM: The dialog is a singleton since we need a single instance in KStars.
  * @short Find Object Dialog
  * @author Jason Harris
@@ -45,6 +50,8 @@ class FindDialog : public QDialog
   public:
     static FindDialog *Instance();
 
+    ~FindDialog() override;
+
     /**
      * @return the target object (need not be the same as currently selected object!)
      *
@@ -147,8 +154,17 @@ class FindDialog : public QDialog
     /** @short Finishes the processing towards closing the dialog initiated by slotOk() or slotResolve() */
     void finishProcessing(SkyObject *selObj = nullptr, bool resolve = true);
 
-    /** @short pre-filter the list of objects according to the selected object type. */
-    void filterByType();
+    /** @return the object types selected by the type filter. */
+    QVector<int> selectedTypes() const;
+
+    /**
+     * @short Look up the search text in the names of the selected types.
+     * @param background run the lookup on a worker thread if the lists are long
+     */
+    void search(bool background);
+
+    /** @short Show the result of a lookup of m_SearchText in the list. */
+    void showResult(const SkyObjectNameIndex::Result &result);
 
     FindDialogUI *ui { nullptr };
     SkyObjectListModel *fModel { nullptr };
@@ -156,6 +172,16 @@ class FindDialog : public QDialog
     QTimer *timer { nullptr };
     bool listFiltered { false };
     std::size_t m_currentSearchSequence { 0 };
+
+    // Name lookup
+    SkyObjectNameIndex m_NameIndex;
+    QFutureWatcher<SkyObjectNameIndex::Result> m_SearchWatcher;
+    /** The sequence number of the lookup on the worker thread. */
+    std::size_t m_SearchSequence { 0 };
+    /** The search text changed while a lookup was running. */
+    bool m_SearchPending { false };
+    QString m_SearchText;
+    bool m_EnableInternetSearch { false };
     QPushButton *okB { nullptr };
     SkyObject *m_targetObject { nullptr };
     QPushButton *m_DetailsB { nullptr };
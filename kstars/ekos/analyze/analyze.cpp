@@ -5,6 +5,7 @@
 */
 
 #include "analyze.h"
+#include "analyzelog.h"
 
 #include <knotification.h>
 #include <QDateTime>
@@ -13,6 +14,7 @@
 #include <QColor>
 
 #include "auxiliary/kspaths.h"
+#include "auxiliary/lodgraph.h"
 #include "dms.h"
 #include "ekos/manager.h"
 #include "ekos/focus/curvefit.h"
@@ -798,12 +800,12 @@ void Analyze::addGuideStats(double raDrift, double decDrift, int raPulse, int de
                 (time - lastCaptureRmsTime > MAX_GUIDE_STATS_GAP))
         {
             // this is the first sample in a series with a gap behind us.
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(lastCaptureRmsTime + .0001, qQNaN());
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time - .0001, qQNaN());
+            addStatsData(CAPTURE_RMS_GRAPH, lastCaptureRmsTime + .0001, qQNaN());
+            addStatsData(CAPTURE_RMS_GRAPH, time - .0001, qQNaN());
             captureRms->resetFilter();
         }
         const double rmsC = captureRms->newSample(raDrift, decDrift);
-        statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time, rmsC);
+        addStatsData(CAPTURE_RMS_GRAPH, time, rmsC);
         lastCaptureRmsTime = time;
     }
 
@@ -815,12 +817,12 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
                                     double numStars, double skyBackground,
                                     double drift, double rms, double time)
 {
-    statsPlot->graph(RA_GRAPH)->addData(time, raDrift);
-    statsPlot->graph(DEC_GRAPH)->addData(time, decDrift);
-    statsPlot->graph(RA_PULSE_GRAPH)->addData(time, raPulse);
-    statsPlot->graph(DEC_PULSE_GRAPH)->addData(time, decPulse);
-    statsPlot->graph(DRIFT_GRAPH)->addData(time, drift);
-    statsPlot->graph(RMS_GRAPH)->addData(time, rms);
+    addStatsData(RA_GRAPH, time, raDrift);
+    addStatsData(DEC_GRAPH, time, decDrift);
+    addStatsData(RA_PULSE_GRAPH, time, raPulse);
+    addStatsData(DEC_PULSE_GRAPH, time, decPulse);
+    addStatsData(DRIFT_GRAPH, time, drift);
+    addStatsData(RMS_GRAPH, time, rms);
 
     // Set the SNR axis' maximum to 95% of the way up from the middle to the top.
     if (!qIsNaN(snr))
@@ -830,9 +832,9 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
     if (!qIsNaN(numStars))
         numStarsMax = std::max(numStars, static_cast<double>(numStarsMax));
 
-    statsPlot->graph(SNR_GRAPH)->addData(time, snr);
-    statsPlot->graph(NUMSTARS_GRAPH)->addData(time, numStars);
-    statsPlot->graph(SKYBG_GRAPH)->addData(time, skyBackground);
+    addStatsData(SNR_GRAPH, time, snr);
+    addStatsData(NUMSTARS_GRAPH, time, numStars);
+    addStatsData(SKYBG_GRAPH, time, skyBackground);
 }
 
 void Analyze::addTemperature(double temperature, double time)
@@ -840,12 +842,12 @@ void Analyze::addTemperature(double temperature, double time)
     // The HFR corresponds to the last capture
     // If there is no temperature sensor, focus sends a large negative value.
     if (temperature > -200)
-        statsPlot->graph(TEMPERATURE_GRAPH)->addData(time, temperature);
+        addStatsData(TEMPERATURE_GRAPH, time, temperature);
 }
 
 void Analyze::addFocusPosition(double focusPosition, double time)
 {
-    statsPlot->graph(FOCUS_POSITION_GRAPH)->addData(time, focusPosition);
+    addStatsData(FOCUS_POSITION_GRAPH, time, focusPosition);
 }
 
 void Analyze::addTargetDistance(double targetDistance, double time)
@@ -855,10 +857,10 @@ void Analyze::addTargetDistance(double targetDistance, double time)
             previousCaptureStartedTime < previousCaptureCompletedTime &&
             previousCaptureCompletedTime <= time)
     {
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureStartedTime - .0001, qQNaN());
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureStartedTime, targetDistance);
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureCompletedTime, targetDistance);
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureCompletedTime + .0001, qQNaN());
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureStartedTime - .0001, qQNaN());
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureStartedTime, targetDistance);
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureCompletedTime, targetDistance);
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureCompletedTime + .0001, qQNaN());
     }
 }
 
@@ -867,25 +869,25 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
                      double time, double startTime)
 {
     // The HFR corresponds to the last capture
-    statsPlot->graph(HFR_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(HFR_GRAPH)->addData(startTime, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time + .0001, qQNaN());
+    addStatsData(HFR_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(HFR_GRAPH, startTime, hfr);
+    addStatsData(HFR_GRAPH, time, hfr);
+    addStatsData(HFR_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, startTime, numCaptureStars);
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, time, numCaptureStars);
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(MEDIAN_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(MEDIAN_GRAPH, startTime, median);
+    addStatsData(MEDIAN_GRAPH, time, median);
+    addStatsData(MEDIAN_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(ECCENTRICITY_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(ECCENTRICITY_GRAPH, startTime, eccentricity);
+    addStatsData(ECCENTRICITY_GRAPH, time, eccentricity);
+    addStatsData(ECCENTRICITY_GRAPH, time + .0001, qQNaN());
 
     medianMax = std::max(median, medianMax);
     numCaptureStarsMax = std::max(numCaptureStars, numCaptureStarsMax);
@@ -896,31 +898,76 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
 void Analyze::addMountCoords(double ra, double dec, double az,
                              double alt, int pierSide, double ha, double time)
 {
-    statsPlot->graph(MOUNT_RA_GRAPH)->addData(time, ra);
-    statsPlot->graph(MOUNT_DEC_GRAPH)->addData(time, dec);
-    statsPlot->graph(MOUNT_HA_GRAPH)->addData(time, ha);
-    statsPlot->graph(AZ_GRAPH)->addData(time, az);
-    statsPlot->graph(ALT_GRAPH)->addData(time, alt);
-    statsPlot->graph(PIER_SIDE_GRAPH)->addData(time, double(pierSide));
+    addStatsData(MOUNT_RA_GRAPH, time, ra);
+    addStatsData(MOUNT_DEC_GRAPH, time, dec);
+    addStatsData(MOUNT_HA_GRAPH, time, ha);
+    addStatsData(AZ_GRAPH, time, az);
+    addStatsData(ALT_GRAPH, time, alt);
+    addStatsData(PIER_SIDE_GRAPH, time, double(pierSide));
+}
+
+// Adds a point to one of the statsPlot graphs, or buffers it while a file is read.
+void Analyze::addStatsData(int graph, double time, double value)
+{
+    if (bulkStatsLoading)
+        bulkStatsData[graph].append(QCPGraphData(time, value));
+    else
+        statsPlot->graph(graph)->addData(time, value);
+}
+
+// Hands the points buffered while reading a file to the statsPlot graphs in one go.
+void Analyze::flushBulkStatsData()
+{
+    for (int i = 0; i < bulkStatsData.size() && i < statsPlot->graphCount(); ++i)
+    {
+        auto &points = bulkStatsData[i];
+        if (points.isEmpty())
+            continue;
+        // Like addData() one point at a time, keep the order of points with the same time.
+        std::stable_sort(points.begin(), points.end(), qcpLessThanSortKey<QCPGraphData>);
+        statsPlot->graph(i)->data()->add(points, true);
+    }
+    bulkStatsData.clear();
+    bulkStatsLoading = false;
 }
 
 // Read a .analyze file, and setup all the graphics.
 double Analyze::readDataFromFile(const QString &filename)
 {
     double lastTime = 10;
-    QFile inputFile(filename);
-    if (inputFile.open(QIODevice::ReadOnly))
+    AnalyzeLog log(filename);
+    // The log of the current session is still growing, an index of it would be stale at once.
+    if (!log.open(filename != logFilename))
+        return lastTime;
+
+    bulkStatsLoading = true;
+    bulkStatsData.resize(statsPlot->graphCount());
+
+    for (const auto &record : log.records())
     {
-        QTextStream in(&inputFile);
-        while (!in.atEnd())
+        double time = 0;
+        const double *values = log.values(record);
+        switch (record.type)
         {
-            QString line = in.readLine();
-            double time = processInputLine(line);
-            if (time > lastTime)
-                lastTime = time;
+            case AnalyzeLog::GUIDE_STATS:
+                time = values[0];
+                processGuideStats(time, values[1], values[2], static_cast<int>(values[3]), static_cast<int>(values[4]),
+                                  values[5], values[6], static_cast<int>(values[7]), true);
+                break;
+            case AnalyzeLog::MOUNT_COORDS:
+                time = values[0];
+                processMountCoords(time, values[1], values[2], values[3], values[4], static_cast<int>(values[5]),
+                                   values[6], true);
+                break;
+            default:
+                time = processInputLine(log.line(record));
+                break;
         }
-        inputFile.close();
+        if (time > lastTime)
+            lastTime = time;
     }
+
+    flushBulkStatsData();
     return lastTime;
 }
 
@@ -2304,7 +2351,11 @@ int Analyze::initGraph(QCustomPlot * plot, QCPAxis * yAxis, QCPGraph::LineStyle
                        const QColor &color, const QString &name)
 {
     int num = plot->graphCount();
-    plot->addGraph(plot->xAxis, yAxis);
+    // The stats graphs grow with the session, draw them at a level of detail matching the zoom.
+    if (plot == statsPlot)
+        new LODGraph(plot->xAxis, yAxis);
+    else
+        plot->addGraph(plot->xAxis, yAxis);
     plot->graph(num)->setLineStyle(lineStyle);
     plot->graph(num)->setPen(QPen(color));
     plot->graph(num)->setName(name);
@@ -386,6 +386,8 @@ class Analyze : public QWidget, public Ui::Analyze
         void addTemperature(double temperature, const double time);
         void addFocusPosition(double focusPosition, double time);
         void addTargetDistance(double targetDistance, const double time);
+        void addStatsData(int graph, double time, double value);
+        void flushBulkStatsData();
 
         // Initialize the graphs (axes, linestyle, pen, name, checkbox callbacks).
         // Returns the graph index.
@@ -495,6 +497,10 @@ class Analyze : public QWidget, public Ui::Analyze
         double plotWidth { 10.0 };
         double maxXValue { 10.0 };
 
+        // While a file is read, statsPlot points are collected here and added to the graphs at the end.
+        bool bulkStatsLoading { false };
+        QVector<QVector<QCPGraphData>> bulkStatsData;
+
         // Data are displayed in seconds since the session started.
         // analyzeStartTime is when the session started, used to translate to clock time.
         QDateTime analyzeStartTime;
@@ -0,0 +1,334 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "analyzelog.h"
+
+#include "auxiliary/kspaths.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QLocale>
+#include <QSaveFile>
+#include <QStringView>
+#include <QVarLengthArray>
+#include <QtConcurrent>
+
+#include <ekos_analyze_debug.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ekos
+{
+
+namespace
+{
+
+constexpr quint32 INDEX_MAGIC = 0x4941534b; // "KSAI"
+constexpr quint32 INDEX_VERSION = 1;
+
+// Logs smaller than this are parsed in one go.
+constexpr qint64 MIN_CHUNK_SIZE = 1 << 20;
+
+struct IndexHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 recordSize;
+    quint32 reserved;
+    qint64 fileSize;
+    qint64 modified;
+    quint64 records;
+    quint64 values;
+};
+
+struct Span
+{
+    const char *begin;
+    const char *end;
+    bool operator==(const char *text) const
+    {
+        const size_t length = strlen(text);
+        return static_cast<size_t>(end - begin) == length && memcmp(begin, text, length) == 0;
+    }
+};
+
+// The numbers are parsed like QString::toDouble() and toInt() would, but without
+// allocating a QString for each field.
+const QLocale &cLocale()
+{
+    static const QLocale locale = QLocale::c();
+    return locale;
+}
+
+bool toDouble(const Span &span, double *value)
+{
+    QVarLengthArray<QChar, 32> text(span.end - span.begin);
+    for (int i = 0; i < text.size(); i++)
+        text[i] = QLatin1Char(span.begin[i]);
+    bool ok = false;
+    *value = cLocale().toDouble(QStringView(text.constData(), text.size()), &ok);
+    return ok;
+}
+
+bool toInt(const Span &span, double *value)
+{
+    QVarLengthArray<QChar, 32> text(span.end - span.begin);
+    for (int i = 0; i < text.size(); i++)
+        text[i] = QLatin1Char(span.begin[i]);
+    bool ok = false;
+    *value = cLocale().toInt(QStringView(text.constData(), text.size()), &ok);
+    return ok;
+}
+
+}
+
+AnalyzeLog::AnalyzeLog(const QString &filename) : m_File(filename)
+{
+}
+
+AnalyzeLog::~AnalyzeLog()
+{
+    if (m_Data)
+        m_File.unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_Data)));
+}
+
+QString AnalyzeLog::indexPath(const QString &filename)
+{
+    const QByteArray key = QCryptographicHash::hash(QFileInfo(filename).absoluteFilePath().toUtf8(),
+                           QCryptographicHash::Sha1).toHex();
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("analyze/" + QString::fromLatin1(
+                key) + ".idx");
+}
+
+bool AnalyzeLog::open(bool useIndex)
+{
+    if (!m_File.open(QIODevice::ReadOnly))
+        return false;
+
+    m_Size = m_File.size();
+    if (m_Size == 0)
+        return true;
+
+    m_Data = reinterpret_cast<const char *>(m_File.map(0, m_Size));
+    if (m_Data == nullptr)
+    {
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Unable to map" << m_File.fileName() << m_File.errorString();
+        return false;
+    }
+
+    if (useIndex && loadIndex())
+    {
+        m_IndexLoaded = true;
+        return true;
+    }
+
+    parse();
+
+    if (useIndex)
+        saveIndex();
+    return true;
+}
+
+QString AnalyzeLog::line(const Record &record) const
+{
+    return QString::fromUtf8(m_Data + record.offset, record.length);
+}
+
+void AnalyzeLog::parse()
+{
+    // Split the log into chunks of whole lines.
+    const int count = m_Size < 2 * MIN_CHUNK_SIZE ? 1 :
+                      static_cast<int>(std::min<qint64>(QThread::idealThreadCount() * 4, m_Size / MIN_CHUNK_SIZE));
+    QVector<Chunk> chunks;
+    chunks.reserve(count);
+    qint64 begin = 0;
+    for (int i = 1; i <= count && begin < m_Size; i++)
+    {
+        qint64 end = (i == count) ? m_Size : std::max(begin, m_Size * i / count);
+        if (end < m_Size)
+        {
+            const void *newline = memchr(m_Data + end, '\n', m_Size - end);
+            end = newline ? static_cast<const char *>(newline) - m_Data + 1 : m_Size;
+        }
+        Chunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.append(chunk);
+        begin = end;
+    }
+
+    if (chunks.size() == 1)
+        parseChunk(chunks[0]);
+    else
+        QtConcurrent::blockingMap(chunks, [this](Chunk & chunk)
+    {
+        parseChunk(chunk);
+    });
+
+    int records = 0, values = 0;
+    for (const auto &chunk : chunks)
+    {
+        records += chunk.records.size();
+        values += chunk.values.size();
+    }
+    m_Records.clear();
+    m_Records.reserve(records);
+    m_Values.clear();
+    m_Values.reserve(values);
+    for (auto &chunk : chunks)
+    {
+        const quint32 base = m_Values.size();
+        for (auto record : chunk.records)
+        {
+            record.values += base;
+            m_Records.append(record);
+        }
+        m_Values.append(chunk.values);
+    }
+}
+
+void AnalyzeLog::parseChunk(Chunk &chunk) const
+{
+    const char *p = m_Data + chunk.begin;
+    const char *end = m_Data + chunk.end;
+    while (p < end)
+    {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (eol == nullptr)
+            eol = end;
+        const char *lineEnd = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+        const char *lineBegin = p;
+        p = eol + 1;
+
+        // Empty lines and comments are ignored by processInputLine() too.
+        if (lineEnd == lineBegin || *lineBegin == '#')
+            continue;
+
+        Record record;
+        record.offset = lineBegin - m_Data;
+        record.length = lineEnd - lineBegin;
+        record.values = chunk.values.size();
+        record.type = LINE;
+
+        // Split into at most 9 fields, longer lines are no GuideStats or MountCoords.
+        Span fields[9];
+        int numFields = 0;
+        const char *field = lineBegin;
+        for (const char *c = lineBegin; numFields < 9; c++)
+        {
+            if (c == lineEnd || *c == ',')
+            {
+                fields[numFields++] = {field, c};
+                field = c + 1;
+                if (c == lineEnd)
+                    break;
+            }
+        }
+        if (field <= lineEnd && numFields == 9)
+            numFields = 10;
+
+        double numbers[GUIDE_STATS_VALUES];
+        bool ok = false;
+        if (numFields == 9 && fields[0] == "GuideStats")
+        {
+            ok = toDouble(fields[1], &numbers[0]) && toDouble(fields[2], &numbers[1]) && toDouble(fields[3], &numbers[2]) &&
+                 toInt(fields[4], &numbers[3]) && toInt(fields[5], &numbers[4]) && toDouble(fields[6], &numbers[5]) &&
+                 toDouble(fields[7], &numbers[6]) && toInt(fields[8], &numbers[7]);
+            record.type = GUIDE_STATS;
+        }
+        else if ((numFields == 7 || numFields == 8) && fields[0] == "MountCoords")
+        {
+            numbers[6] = 0;
+            ok = toDouble(fields[1], &numbers[0]) && toDouble(fields[2], &numbers[1]) && toDouble(fields[3], &numbers[2]) &&
+                 toDouble(fields[4], &numbers[3]) && toDouble(fields[5], &numbers[4]) && toInt(fields[6], &numbers[5]) &&
+                 (numFields == 7 || toDouble(fields[7], &numbers[6]));
+            record.type = MOUNT_COORDS;
+        }
+
+        if (record.type != LINE)
+        {
+            // Malformed or out of range lines are dropped, as processInputLine() would do.
+            if (!ok || numbers[0] < 0 || numbers[0] > 3600 * 24 * 10)
+                continue;
+            const int size = record.type == GUIDE_STATS ? GUIDE_STATS_VALUES : MOUNT_COORDS_VALUES;
+            for (int i = 0; i < size; i++)
+                chunk.values.append(numbers[i]);
+        }
+        chunk.records.append(record);
+    }
+}
+
+bool AnalyzeLog::loadIndex()
+{
+    QFile index(indexPath(m_File.fileName()));
+    if (!index.open(QIODevice::ReadOnly))
+        return false;
+
+    IndexHeader header;
+    if (index.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header))
+        return false;
+
+    if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION || header.recordSize != sizeof(Record) ||
+            header.fileSize != m_Size || header.modified != QFileInfo(m_File).lastModified().toMSecsSinceEpoch() ||
+            header.records > static_cast<quint64>(m_Size) || header.values > static_cast<quint64>(m_Size))
+        return false;
+
+    m_Records.resize(header.records);
+    m_Values.resize(header.values);
+    const qint64 recordBytes = header.records * sizeof(Record);
+    const qint64 valueBytes = header.values * sizeof(double);
+    if (index.read(reinterpret_cast<char *>(m_Records.data()), recordBytes) != recordBytes ||
+            index.read(reinterpret_cast<char *>(m_Values.data()), valueBytes) != valueBytes)
+    {
+        m_Records.clear();
+        m_Values.clear();
+        return false;
+    }
+
+    // Never trust a cache file blindly.
+    const bool valid = std::all_of(m_Records.cbegin(), m_Records.cend(), [this](const Record & record)
+    {
+        const int size = record.type == GUIDE_STATS ? GUIDE_STATS_VALUES : record.type == MOUNT_COORDS ? MOUNT_COORDS_VALUES : 0;
+        return record.type <= MOUNT_COORDS && record.offset + record.length <= static_cast<quint64>(m_Size) &&
+               record.values + size <= static_cast<quint32>(m_Values.size());
+    });
+    if (!valid)
+    {
+        m_Records.clear();
+        m_Values.clear();
+    }
+    return valid;
+}
+
+void AnalyzeLog::saveIndex() const
+{
+    const QString path = indexPath(m_File.fileName());
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    IndexHeader header;
+    header.magic = INDEX_MAGIC;
+    header.version = INDEX_VERSION;
+    header.recordSize = sizeof(Record);
+    header.reserved = 0;
+    header.fileSize = m_Size;
+    header.modified = QFileInfo(m_File).lastModified().toMSecsSinceEpoch();
+    header.records = m_Records.size();
+    header.values = m_Values.size();
+
+    QSaveFile index(path);
+    if (!index.open(QIODevice::WriteOnly))
+        return;
+    index.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    index.write(reinterpret_cast<const char *>(m_Records.constData()), m_Records.size() * sizeof(Record));
+    index.write(reinterpret_cast<const char *>(m_Values.constData()), m_Values.size() * sizeof(double));
+    if (!index.commit())
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Unable to write the index of" << m_File.fileName() << "to" << path;
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+namespace Ekos
+{
+/**
+ * @class AnalyzeLog
+ * @short Fast reader for .analyze session logs.
+ *
+ * The log is memory mapped and split into chunks of whole lines which are parsed in
+ * parallel. The high-rate lines (GuideStats, MountCoords) are parsed into numbers
+ * straight from the mapped bytes. All other lines are rare and stay byte spans, Analyze
+ * hands them to processInputLine() as before. Records are kept in file order, so
+ * replaying them gives the same result as reading the file line by line.
+ *
+ * The records and numbers can be saved in a side index in the cache directory. It is
+ * reused as long as the log keeps its size and modification time, so re-opening a
+ * log does not even have to scan it.
+ */
+class AnalyzeLog
+{
+    public:
+        enum RecordType : quint8
+        {
+            // A line to be parsed by Analyze::processInputLine()
+            LINE,
+            // time, ra, dec, raPulse, decPulse, snr, skyBg, numStars
+            GUIDE_STATS,
+            // time, ra, dec, az, alt, pierSide, ha
+            MOUNT_COORDS
+        };
+
+        struct Record
+        {
+            // Byte span of the line, without the line terminator.
+            quint64 offset;
+            quint32 length;
+            // Index of the first number of GUIDE_STATS and MOUNT_COORDS records.
+            quint32 values;
+            RecordType type;
+        };
+
+        static constexpr int GUIDE_STATS_VALUES = 8;
+        static constexpr int MOUNT_COORDS_VALUES = 7;
+
+        explicit AnalyzeLog(const QString &filename);
+        ~AnalyzeLog();
+
+        /**
+         * @brief open Map the log and parse it, or load its side index.
+         * @param useIndex Use and update the side index. Pass false for a log that is still being written.
+         * @return false if the log cannot be read.
+         */
+        bool open(bool useIndex = true);
+
+        const QVector<Record> &records() const
+        {
+            return m_Records;
+        }
+        /** @brief values First of the numbers of a GUIDE_STATS or MOUNT_COORDS record. */
+        const double *values(const Record &record) const
+        {
+            return m_Values.constData() + record.values;
+        }
+        /** @brief line Text of a record. */
+        QString line(const Record &record) const;
+
+        /** @brief indexLoaded True if open() used the side index instead of parsing the log. */
+        bool indexLoaded() const
+        {
+            return m_IndexLoaded;
+        }
+
+        /** @brief indexPath Where the side index of filename is kept. */
+        static QString indexPath(const QString &filename);
+
+    private:
+        struct Chunk
+        {
+            qint64 begin;
+            qint64 end;
+            QVector<Record> records;
+            QVector<double> values;
+        };
+
+        void parse();
+        void parseChunk(Chunk &chunk) const;
+        bool loadIndex();
+        void saveIndex() const;
+
+        QFile m_File;
+        const char *m_Data { nullptr };
+        qint64 m_Size { 0 };
+        QVector<Record> m_Records;
+        QVector<double> m_Values;
+        bool m_IndexLoaded { false };
+};
+}
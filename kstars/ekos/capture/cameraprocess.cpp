@@ -36,6 +36,43 @@
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 #endif
 
+#include <QElapsedTimer>
+
+namespace
+{
+// Collects how long each post-processing step of a received frame took and logs them as one
+// line once the frame leaves processFITSData(), whichever return it takes.
+class StageLatency
+{
+    public:
+        explicit StageLatency(const QString &receiveLatency) : m_ReceiveLatency(receiveLatency)
+        {
+            m_Timer.start();
+        }
+        ~StageLatency()
+        {
+            if (m_Stages.isEmpty())
+                return;
+            qCDebug(KSTARS_EKOS_CAPTURE) << "Frame processing latency:" << m_Stages.join(", ")
+                                         << "total" << m_Timer.elapsed() << "ms"
+                                         << (m_ReceiveLatency.isEmpty() ? QString() : QString("(received: %1)").arg(m_ReceiveLatency));
+        }
+
+        void mark(const QString &stage)
+        {
+            const qint64 now = m_Timer.elapsed();
+            m_Stages << QString("%1 %2ms").arg(stage).arg(now - m_Last);
+            m_Last = now;
+        }
+
+    private:
+        QElapsedTimer m_Timer;
+        QString m_ReceiveLatency;
+        QStringList m_Stages;
+        qint64 m_Last { 0 };
+};
+}
+
 namespace Ekos
 {
 CameraProcess::CameraProcess(QSharedPointer<CameraState> newModuleState,
@@ -1059,6 +1096,7 @@ bool Ekos::CameraProcess::checkSavingReceivedImage(const QSharedPointer<FITSData
 void CameraProcess::processFITSData(const QSharedPointer<FITSData> &data, const QString &extension)
 {
     ISD::CameraChip * tChip = nullptr;
+    StageLatency latency(data ? data->property("receiveLatency").toString() : QString());
 
     QString blobInfo;
     if (data)
@@ -1149,6 +1187,7 @@ void CameraProcess::processFITSData(const QSharedPointer<FITSData> &data, const
                 FITSScale captureFilter = tChip->getCaptureFilter();
                 updateFITSViewer(data, captureMode, captureFilter, filename, data->property("device").toString());
             }
+            latency.mark("preview");
         }
 
         // If dark is selected, perform dark substraction.
@@ -1167,12 +1206,14 @@ void CameraProcess::processFITSData(const QSharedPointer<FITSData> &data, const
             else
                 qWarning(KSTARS_EKOS_CAPTURE) << "Invalid train ID for darks substraction:" << trainID.toUInt();
 
+            latency.mark("dark");
         }
         if (currentJobType == SequenceJob::JOBTYPE_PREVIEW)
         {
             // Set image metadata and emit captureComplete
             // Need to do this now for previews as the activeJob() will be set to null.
             updateImageMetadataAction(state()->imageData());
+            latency.mark("metadata");
         }
     }
 
@@ -1206,7 +1247,10 @@ void CameraProcess::processFITSData(const QSharedPointer<FITSData> &data, const
             if (thejob->getFlatFieldDuration() == DURATION_ADU
                     && thejob->getCoreProperty(SequenceJob::SJ_TargetADU).toDouble() > 0)
             {
-                if (checkFlatCalibration(state()->imageData(), state()->exposureRange().min, state()->exposureRange().max) == false)
+                const bool calibrated = checkFlatCalibration(state()->imageData(), state()->exposureRange().min,
+                                        state()->exposureRange().max);
+                latency.mark("flat ADU");
+                if (calibrated == false)
                 {
                     updateFITSViewer(data, tChip, filename);
                     return; /* calibration not completed */
@@ -1242,15 +1286,21 @@ void CameraProcess::processFITSData(const QSharedPointer<FITSData> &data, const
     {
         // Check to save and show the new image in the FITS viewer
         if (alreadySaved || checkSavingReceivedImage(data, extension, filename))
+        {
+            latency.mark("save");
             updateFITSViewer(data, tChip, filename);
+            latency.mark("viewer");
+        }
 
         // Set image metadata and emit captureComplete
         updateImageMetadataAction(state()->imageData());
+        latency.mark("metadata");
     }
 
     // JM 2020-06-17: Emit newImage for LOCAL images (stored on remote host)
     //if (m_Camera->getUploadMode() == ISD::Camera::UPLOAD_LOCAL)
     emit newImage(thejob, state()->imageData());
+    latency.mark("newImage");
 
     // Check if we need to execute post capture script first
     if (runCaptureScript(SCRIPT_POST_CAPTURE) == IPS_BUSY)
@@ -106,6 +106,14 @@ void Capture::setupOptions()
     m_OpsMiscSettings = new OpsMiscSettings();
     KPageWidgetItem *page = dialog->addPage(m_OpsMiscSettings, i18n("Misc"));
     page->setIcon(QIcon::fromTheme("configure"));
+    connect(m_OpsMiscSettings, &OpsMiscSettings::settingsUpdated, this, [this]()
+    {
+        for (auto &cam : cameras())
+        {
+            if (cam->activeCamera())
+                cam->activeCamera()->updateWriteSettings();
+        }
+    });
 
     m_OpsDslrSettings = new OpsDslrSettings();
     page = dialog->addPage(m_OpsDslrSettings, i18n("DSLR"));
@@ -27,7 +27,7 @@
 #include "kstars.h"
 #include "version.h"
 
-#include <QtConcurrent>
+#include <QFutureWatcher>
 #include <KFormat>
 #include <QImageWriter>
 
@@ -53,6 +53,7 @@ Media::Media(Ekos::Manager * manager, QVector<QSharedPointer<NodeManager>> &node
     {
         uploadImage(image);
     });
+    connect(&m_Encoder, &MediaEncoder::encoded, this, &Media::uploadPreview);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -99,6 +100,8 @@ void Media::onDisconnected()
             QFile::remove(oneFile);
         temporaryFiles.clear();
 
+        m_Encoder.clear();
+
         emit disconnected();
     }
 }
@@ -288,10 +291,17 @@ void Media::sendData(const QSharedPointer<FITSData> &data, const QString &uuid)
     if (Options::ekosLiveImageTransfer() == false || m_sendBlobs == false || isConnected() == false)
         return;
 
-    StretchParams params;
-    QImage image;
-    stretch(data, image, params);
-    upload(data, image, params, uuid);
+    auto fastImage = (!Options::ekosLiveHighBandwidth() || uuid[0] == '+');
+
+    MediaEncoder::Frame frame;
+    frame.uuid = uuid;
+    frame.metadata = imageMetadata(data, uuid);
+    frame.data = data;
+    frame.maxWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
+    frame.fast = fastImage;
+    frame.quality = HB_IMAGE_QUALITY;
+    m_Encoder.setWebP(Options::ekosLiveWebP());
+    m_Encoder.encode(frame);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -302,13 +312,15 @@ void Media::sendFile(const QString &filename, const QString &uuid)
     if (Options::ekosLiveImageTransfer() == false || m_sendBlobs == false || isConnected() == false)
         return;
 
-    QSharedPointer<FITSData> data(new FITSData());
-    data->loadFromFile(filename);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    QtConcurrent::run(&Media::dispatch, this, data, uuid);
-#else
-    QtConcurrent::run(this, &Media::dispatch, data, uuid);
-#endif
+    QSharedPointer<FITSData> data(new FITSData(), &QObject::deleteLater);
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, data, uuid]()
+    {
+        watcher->deleteLater();
+        if (watcher->result())
+            sendData(data, uuid);
+    });
+    watcher->setFuture(data->loadFromFile(filename));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -325,139 +337,8 @@ void Media::sendView(const QSharedPointer<FITSView> &view, const QString &uuid)
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
-void Media::dispatch(const QSharedPointer<FITSData> &data, const QString &uuid)
-{
-    QSharedPointer<FITSView> previewImage(new FITSView());
-    previewImage->loadData(data);
-    upload(previewImage, uuid);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////////
-void Media::stretch(const QSharedPointer<FITSData> &data, QImage &image, StretchParams &params) const
-{
-    double min = 0, max = 0;
-    data->getMinMax(&min, &max);
-    auto width = data->width();
-    auto height = data->height();
-    auto channels = data->channels();
-    auto dataType = data->dataType();
-
-    if (min == max)
-    {
-        image.fill(Qt::white);
-    }
-
-    if (channels == 1)
-    {
-        image = QImage(width, height, QImage::Format_Indexed8);
-
-        image.setColorCount(256);
-        for (int i = 0; i < 256; i++)
-            image.setColor(i, qRgb(i, i, i));
-    }
-    else
-    {
-        image = QImage(width, height, QImage::Format_RGB32);
-    }
-
-    Stretch stretch(width, height, channels, dataType);
-
-    // Compute new auto-stretch params.
-    params = stretch.computeParams(data->getImageBuffer());
-    stretch.setParams(params);
-    stretch.run(data->getImageBuffer(), &image, 1);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////////
-void Media::upload(const QSharedPointer<FITSView> &view, const QString &uuid)
+QJsonObject Media::imageMetadata(const QSharedPointer<FITSData> &data, const QString &uuid)
 {
-    const QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
-
-    const QSharedPointer<FITSData> imageData = view->imageData();
-    QString resolution = QString("%1x%2").arg(imageData->width()).arg(imageData->height());
-    QString sizeBytes = KFormat().formatByteSize(imageData->size());
-    QVariant xbin(1), ybin(1), exposure(0), focal_length(0), gain(0), pixel_size(0), aperture(0);
-    imageData->getRecordValue("XBINNING", xbin);
-    imageData->getRecordValue("YBINNING", ybin);
-    imageData->getRecordValue("EXPTIME", exposure);
-    imageData->getRecordValue("GAIN", gain);
-    imageData->getRecordValue("PIXSIZE1", pixel_size);
-    imageData->getRecordValue("FOCALLEN", focal_length);
-    imageData->getRecordValue("APTDIA", aperture);
-
-    auto stretchParameters = view->getStretchParams();
-
-    // Account for binning
-    const double binned_pixel = pixel_size.toDouble() * xbin.toInt();
-
-    // Send everything as strings
-    QJsonObject metadata =
-    {
-        {"resolution", resolution},
-        {"size", sizeBytes},
-        {"channels", imageData->channels()},
-        {"mean", imageData->getAverageMean()},
-        {"median", imageData->getAverageMedian()},
-        {"stddev", imageData->getAverageStdDev()},
-        {"min", imageData->getMin()},
-        {"max", imageData->getMax()},
-        {"bin", QString("%1x%2").arg(xbin.toString(), ybin.toString())},
-        {"bpp", QString::number(imageData->bpp())},
-        {"uuid", uuid},
-        {"exposure", exposure.toString()},
-        {"focal_length", focal_length.toString()},
-        {"aperture", aperture.toString()},
-        {"gain", gain.toString()},
-        {"pixel_size", QString::number(binned_pixel, 'f', 4)},
-        {"shadows", stretchParameters.grey_red.shadows},
-        {"midtones", stretchParameters.grey_red.midtones},
-        {"highlights", stretchParameters.grey_red.highlights},
-        {"hasWCS", imageData->hasWCS()},
-        {"hfr", imageData->getHFR()},
-        {"view", view->objectName()},
-        {"ext", ext}
-    };
-
-    // First METADATA_PACKET bytes of the binary data is always allocated
-    // to the metadata
-    // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
-
-    auto fastImage = (!Options::ekosLiveHighBandwidth() || uuid[0] == '+');
-    auto scaleWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
-
-    // For low bandwidth images
-    // Except for dark frames +D
-    QPixmap scaledImage = view->getDisplayPixmap().width() > scaleWidth ?
-                          view->getDisplayPixmap().scaledToWidth(scaleWidth, fastImage ? Qt::FastTransformation : Qt::SmoothTransformation) :
-                          view->getDisplayPixmap();
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
-
-    buffer.close();
-
-    emit newImage(jpegData);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////////
-void Media::upload(const QSharedPointer<FITSData> &data, const QImage &image, const StretchParams &params,
-                   const QString &uuid)
-{
-    const QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
-
     QString resolution = QString("%1x%2").arg(data->width()).arg(data->height());
     QString sizeBytes = KFormat().formatByteSize(data->size());
     QVariant xbin(1), ybin(1), exposure(0), focal_length(0), gain(0), pixel_size(0), aperture(0);
@@ -473,7 +354,7 @@ void Media::upload(const QSharedPointer<FITSData> &data, const QImage &image, co
     const double binned_pixel = pixel_size.toDouble() * xbin.toInt();
 
     // Send everything as strings
-    QJsonObject metadata =
+    return
     {
         {"resolution", resolution},
         {"size", sizeBytes},
@@ -491,34 +372,43 @@ void Media::upload(const QSharedPointer<FITSData> &data, const QImage &image, co
         {"aperture", aperture.toString()},
         {"gain", gain.toString()},
         {"pixel_size", QString::number(binned_pixel, 'f', 4)},
-        {"shadows", params.grey_red.shadows},
-        {"midtones", params.grey_red.midtones},
-        {"highlights", params.grey_red.highlights},
         {"hasWCS", data->hasWCS()},
-        {"hfr", data->getHFR()},
-        {"ext", ext}
+        {"hfr", data->getHFR()}
     };
+}
 
-    // First METADATA_PACKET bytes of the binary data is always allocated
-    // to the metadata
-    // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::upload(const QSharedPointer<FITSView> &view, const QString &uuid)
+{
+    const QSharedPointer<FITSData> imageData = view->imageData();
+    if (!imageData)
+        return;
 
     auto fastImage = (!Options::ekosLiveHighBandwidth() || uuid[0] == '+');
-    auto scaleWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
 
     // For low bandwidth images
     // Except for dark frames +D
-    QImage scaledImage = image.width() > scaleWidth ?
-                         image.scaledToWidth(scaleWidth, fastImage ? Qt::FastTransformation : Qt::SmoothTransformation) :
-                         image;
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
-
-    buffer.close();
-
-    emit newImage(jpegData);
+    MediaEncoder::Frame frame;
+    frame.uuid = uuid;
+    frame.maxWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
+    frame.fast = fastImage;
+
+    // Render the preview from the data with the stretch of the viewer instead of scaling its
+    // full size pixmap. Only the sampled pixels are stretched, so this is cheap enough to do
+    // here, where the viewer cannot change the data underneath. Scaling and compression are
+    // left to the encoder threads.
+    const StretchParams stretchParameters = view->isImageStretched() ? view->getStretchParams() : StretchParams();
+    frame.image = MediaEncoder::render(*imageData, stretchParameters, frame.maxWidth);
+    frame.metadata = imageMetadata(imageData, uuid);
+    frame.metadata["view"] = view->objectName();
+    frame.metadata["shadows"] = stretchParameters.grey_red.shadows;
+    frame.metadata["midtones"] = stretchParameters.grey_red.midtones;
+    frame.metadata["highlights"] = stretchParameters.grey_red.highlights;
+    frame.quality = HB_IMAGE_QUALITY;
+    m_Encoder.setWebP(Options::ekosLiveWebP());
+    m_Encoder.encode(frame);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -529,11 +419,6 @@ void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
     if (isConnected() == false)
         return;
 
-    QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
-
     const QSharedPointer<FITSData> imageData = view->imageData();
 
     if (!imageData)
@@ -570,23 +455,19 @@ void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
         {"focal_length", focal_length.toString()},
         {"aperture", aperture.toString()},
         {"gain", gain.toString()},
-        {"pixel_size", QString::number(binned_pixel, 'f', 4)},
-        {"ext", ext}
+        {"pixel_size", QString::number(binned_pixel, 'f', 4)}
     };
 
-    // First METADATA_PACKET bytes of the binary data is always allocated
-    // to the metadata
-    // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
+    MediaEncoder::Frame frame;
+    frame.uuid = "+A";
+    frame.metadata = metadata;
+    frame.quality = HB_IMAGE_QUALITY;
 
     // For low bandwidth images
-    QPixmap scaledImage;
     // Align images
     if (correctionVector.isNull() == false)
     {
-        scaledImage = view->getDisplayPixmap();
+        QPixmap scaledImage;
         const double currentZoom = view->getCurrentZoom();
         const double normalizedZoom = currentZoom / 100;
         // If zoom level is not 100%, then scale.
@@ -606,19 +487,21 @@ void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
 
         emit newBoundingRect(boundingRectable, scaledImage.size(), currentZoom);
 
-        scaledImage = scaledImage.copy(boundingRectable);
+        // Only the small crop around the correction vector is copied here.
+        frame.image = scaledImage.copy(boundingRectable).toImage();
     }
     else
     {
-        scaledImage = view->getDisplayPixmap().width() > HB_IMAGE_WIDTH / 2 ?
-                      view->getDisplayPixmap().scaledToWidth(HB_IMAGE_WIDTH / 2, Qt::FastTransformation) :
-                      view->getDisplayPixmap();
+        frame.maxWidth = HB_IMAGE_WIDTH / 2;
+        frame.fast = true;
+        frame.image = MediaEncoder::render(*imageData,
+                                           view->isImageStretched() ? view->getStretchParams() : StretchParams(),
+                                           frame.maxWidth);
         emit newBoundingRect(QRect(), QSize(), 100);
     }
 
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
-    buffer.close();
-    emit newImage(jpegData);
+    m_Encoder.setWebP(Options::ekosLiveWebP());
+    m_Encoder.encode(frame);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -717,6 +600,22 @@ void Media::uploadImage(const QByteArray &image)
     }
 }
 
+void Media::uploadPreview(const QString &uuid, const QByteArray &image)
+{
+    for (auto &nodeManager : m_NodeManagers)
+    {
+        // When the link is slower than capture, skip previews rather than queueing them
+        // behind each other. The next frame of the channel will be sent instead.
+        if (nodeManager->media()->pendingBytes() > MAX_PENDING_UPLOAD)
+        {
+            qCDebug(KSTARS_EKOS) << "Media: link to" << nodeManager->media()->url().toDisplayString()
+                                 << "is busy, skipping preview" << uuid;
+            continue;
+        }
+        nodeManager->media()->sendBinaryMessage(image);
+    }
+}
+
 void Media::processNewBLOB(IBLOB * bp)
 {
     Q_UNUSED(bp)
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "ekos/manager.h"
+#include "mediaencoder.h"
 #include "nodemanager.h"
 
 class FITSView;
@@ -77,13 +78,11 @@ class Media : public QObject
         // Metadata and Image upload
         void uploadMetadata(const QByteArray &metadata);
         void uploadImage(const QByteArray &image);
+        void uploadPreview(const QString &uuid, const QByteArray &image);
 
     private:
-        void dispatch(const QSharedPointer<FITSData> &data, const QString &uuid);
         void upload(const QSharedPointer<FITSView> &view, const QString &uuid);
-
-        void upload(const QSharedPointer<FITSData> &data, const QImage &image, const StretchParams &params, const QString &uuid);
-        void stretch(const QSharedPointer<FITSData> &data, QImage &image, StretchParams &params) const;
+        static QJsonObject imageMetadata(const QSharedPointer<FITSData> &data, const QString &uuid);
 
         Ekos::Manager * m_Manager { nullptr };
         QVector<QSharedPointer<NodeManager>> m_NodeManagers;
@@ -93,6 +92,9 @@ class Media : public QObject
 
         bool m_sendBlobs { true};
 
+        // Stretches, scales and compresses previews in worker threads
+        MediaEncoder m_Encoder;
+
         // Image width for high-bandwidth setting
         static const uint16_t HB_IMAGE_WIDTH = 1920;
         // Video width for high-bandwidth setting
@@ -112,7 +114,9 @@ class Media : public QObject
         static const uint16_t RECONNECT_MAX_TRIES = 720;
 
         // Binary Metadata Size
-        static const uint16_t METADATA_PACKET = 512;
+        static const uint16_t METADATA_PACKET = MediaEncoder::METADATA_PACKET;
+        // Previews are dropped while this many bytes are still waiting to go out on a node
+        static const uint32_t MAX_PENDING_UPLOAD = 8 * 1024 * 1024;
 
         // HIPS Tile Width and Height
         static const uint16_t HIPS_TILE_WIDTH = 512;
@@ -0,0 +1,217 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    Media Channel image encoder
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "mediaencoder.h"
+
+#include "fitsviewer/fitsdata.h"
+
+#include "ekos_debug.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QImageWriter>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace EkosLive
+{
+
+MediaEncoder::MediaEncoder(QObject *parent) : QObject(parent)
+{
+    // Encoding is bursty and should not compete with the capture pipeline for the global pool.
+    m_Pool.setMaxThreadCount(std::max(1, std::min(2, QThread::idealThreadCount() / 2)));
+}
+
+MediaEncoder::~MediaEncoder()
+{
+    clear();
+    m_Pool.waitForDone();
+}
+
+void MediaEncoder::encode(const Frame &frame)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    if (m_Waiting.contains(frame.uuid))
+    {
+        m_Dropped++;
+        qCDebug(KSTARS_EKOS) << "Media: dropping stale frame on channel" << frame.uuid << "(" << m_Dropped << "dropped so far)";
+    }
+    m_Waiting.insert(frame.uuid, frame);
+
+    if (m_Busy.contains(frame.uuid))
+        return;
+
+    m_Busy.insert(frame.uuid);
+    const QString uuid = frame.uuid;
+    QtConcurrent::run(&m_Pool, [this, uuid]()
+    {
+        run(uuid);
+    });
+}
+
+void MediaEncoder::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Waiting.clear();
+    m_StretchCache.clear();
+}
+
+void MediaEncoder::setWebP(bool enabled)
+{
+    const bool available = QImageWriter::supportedImageFormats().contains("webp");
+    if (enabled && !available)
+        qCWarning(KSTARS_EKOS) << "Media: WebP image plugin is not available, falling back to JPEG.";
+
+    QMutexLocker locker(&m_Mutex);
+    m_Format = (enabled && available) ? "webp" : "jpg";
+}
+
+void MediaEncoder::run(const QString &uuid)
+{
+    while (true)
+    {
+        Frame frame;
+        {
+            QMutexLocker locker(&m_Mutex);
+            auto it = m_Waiting.find(uuid);
+            if (it == m_Waiting.end())
+            {
+                m_Busy.remove(uuid);
+                return;
+            }
+            frame = it.value();
+            m_Waiting.erase(it);
+        }
+
+        const QByteArray result = process(frame);
+        if (!result.isEmpty())
+            emit encoded(uuid, result);
+    }
+}
+
+QByteArray MediaEncoder::process(Frame &frame)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray format;
+    {
+        QMutexLocker locker(&m_Mutex);
+        format = m_Format;
+    }
+
+    QImage image;
+    int sampling = 1;
+    if (frame.data)
+    {
+        StretchParams params = frame.hasStretchParams ? frame.stretchParams : autoStretch(frame.uuid, *frame.data);
+        image = render(*frame.data, params, frame.maxWidth, &sampling);
+        frame.metadata["shadows"] = params.grey_red.shadows;
+        frame.metadata["midtones"] = params.grey_red.midtones;
+        frame.metadata["highlights"] = params.grey_red.highlights;
+    }
+    else
+        image = frame.image;
+
+    if (image.isNull())
+        return QByteArray();
+
+    const qint64 stretchTime = timer.restart();
+
+    if (frame.maxWidth > 0 && image.width() > frame.maxWidth)
+        image = image.scaledToWidth(frame.maxWidth, frame.fast ? Qt::FastTransformation : Qt::SmoothTransformation);
+
+    const qint64 scaleTime = timer.restart();
+
+    QByteArray encodedImage;
+    QBuffer buffer(&encodedImage);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, format.constData(), frame.quality);
+    buffer.close();
+
+    frame.metadata["ext"] = QString::fromLatin1(format);
+
+    qCDebug(KSTARS_EKOS) << "Media: encoded" << frame.uuid << image.width() << "x" << image.height()
+                         << "sampling" << sampling << "stretch" << stretchTime << "ms scale" << scaleTime
+                         << "ms" << format << timer.elapsed() << "ms" << encodedImage.size() << "bytes";
+
+    return packet(frame.metadata, encodedImage);
+}
+
+StretchParams MediaEncoder::autoStretch(const QString &uuid, const FITSData &data)
+{
+    QVariant exposure(0);
+    data.getRecordValue("EXPTIME", exposure);
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        auto it = m_StretchCache.find(uuid);
+        if (it != m_StretchCache.end() && it->width == data.width() && it->height == data.height()
+                && it->channels == data.channels() && it->dataType == static_cast<int>(data.dataType())
+                && it->exposure == exposure.toDouble() && it->frames < STRETCH_REFRESH_FRAMES)
+        {
+            it->frames++;
+            return it->params;
+        }
+    }
+
+    Stretch stretch(data.width(), data.height(), data.channels(), data.dataType());
+    CachedStretch cached;
+    cached.width = data.width();
+    cached.height = data.height();
+    cached.channels = data.channels();
+    cached.dataType = data.dataType();
+    cached.exposure = exposure.toDouble();
+    cached.frames = 1;
+    cached.params = stretch.computeParams(data.getImageBuffer());
+
+    QMutexLocker locker(&m_Mutex);
+    m_StretchCache.insert(uuid, cached);
+    return cached.params;
+}
+
+QImage MediaEncoder::render(const FITSData &data, const StretchParams &params, int maxWidth, int *sampling)
+{
+    const int width = data.width();
+    const int height = data.height();
+    const int channels = data.channels();
+    if (width == 0 || height == 0 || data.getImageBuffer() == nullptr)
+        return QImage();
+
+    // Stretch only the pixels the preview needs, what remains is done by a cheap rescale.
+    const int step = maxWidth > 0 ? std::max(1, width / maxWidth) : 1;
+    if (sampling)
+        *sampling = step;
+
+    QImage image((width + step - 1) / step, (height + step - 1) / step,
+                 channels == 1 ? QImage::Format_Indexed8 : QImage::Format_RGB32);
+    if (channels == 1)
+    {
+        image.setColorCount(256);
+        for (int i = 0; i < 256; i++)
+            image.setColor(i, qRgb(i, i, i));
+    }
+
+    Stretch stretch(width, height, channels, data.dataType());
+    stretch.setParams(params);
+    stretch.run(data.getImageBuffer(), &image, step);
+    return image;
+}
+
+QByteArray MediaEncoder::packet(const QJsonObject &metadata, const QByteArray &image)
+{
+    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
+    meta = meta.leftJustified(METADATA_PACKET, 0);
+    return meta + image;
+}
+
+}
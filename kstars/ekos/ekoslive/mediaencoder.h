@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    Media Channel image encoder
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "fitsviewer/stretch.h"
+
+#include <QHash>
+#include <QImage>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+class FITSData;
+
+namespace EkosLive
+{
+/**
+ * @class MediaEncoder
+ * @brief Turns frames into the compressed previews sent over the Media channel, off the GUI thread.
+ *
+ * A frame is either raw FITSData, which is stretched straight to the preview size, or an
+ * image that has already been rendered. Stretching samples every n-th pixel so a 60MP
+ * frame never has to be stretched at full resolution only to be scaled down afterwards.
+ *
+ * Stretch parameters are either given by the caller (e.g. those of the FITS viewer showing
+ * the frame) or computed automatically. Automatic parameters are cached per channel and
+ * reused while the frames keep the same geometry and exposure, they are refreshed every
+ * few frames.
+ *
+ * Each channel (the uuid of the frame, e.g. "+A" for align) is encoded in order by at most
+ * one worker. If a newer frame arrives on a channel before the worker got to the previous
+ * one, the previous one is dropped, so a slow link or a slow encode never builds a backlog.
+ */
+class MediaEncoder : public QObject
+{
+        Q_OBJECT
+
+    public:
+        struct Frame
+        {
+            QString uuid;
+            /** Sent as the header of the packet. The encoder adds ext and, when it stretches, the stretch parameters. */
+            QJsonObject metadata;
+            /**
+             * Raw frame to stretch, or a null pointer if image is set. It is read from a worker
+             * thread, so frames that a viewer may still change are rendered by the caller with render().
+             */
+            QSharedPointer<FITSData> data;
+            /** Rendered frame, used if data is not set. */
+            QImage image;
+            /** Use stretchParams instead of automatic ones. */
+            bool hasStretchParams { false };
+            StretchParams stretchParams;
+            /** Frames wider than this are scaled down, 0 keeps the size. */
+            int maxWidth { 0 };
+            /** Prefer speed over quality when scaling. */
+            bool fast { false };
+            int quality { 90 };
+        };
+
+        explicit MediaEncoder(QObject *parent = nullptr);
+        ~MediaEncoder() override;
+
+        /** @brief encode Queue a frame. Replaces a frame of the same channel that is still waiting. */
+        void encode(const Frame &frame);
+
+        /** @brief clear Drop waiting frames and cached stretch parameters. */
+        void clear();
+
+        /** @brief setWebP Encode to WebP instead of JPEG when the image plugin is available. */
+        void setWebP(bool enabled);
+
+        /**
+         * @brief render Stretch data to an 8bit image no wider than about maxWidth.
+         * @param sampling Set to the sampling factor that was used.
+         */
+        static QImage render(const FITSData &data, const StretchParams &params, int maxWidth, int *sampling = nullptr);
+
+        /** @brief packet Pack metadata and image the way the Media channel expects them. */
+        static QByteArray packet(const QJsonObject &metadata, const QByteArray &image);
+
+        // First METADATA_PACKET bytes of a binary message are always the metadata
+        static const uint16_t METADATA_PACKET = 512;
+
+    signals:
+        /** @brief Emitted from a worker thread with a complete Media packet. */
+        void encoded(const QString &uuid, const QByteArray &packet);
+
+    private:
+        struct CachedStretch
+        {
+            int width { 0 };
+            int height { 0 };
+            int channels { 0 };
+            int dataType { 0 };
+            double exposure { 0 };
+            int frames { 0 };
+            StretchParams params;
+        };
+
+        void run(const QString &uuid);
+        QByteArray process(Frame &frame);
+        StretchParams autoStretch(const QString &uuid, const FITSData &data);
+
+        QMutex m_Mutex;
+        QThreadPool m_Pool;
+        QHash<QString, Frame> m_Waiting;
+        QSet<QString> m_Busy;
+        QHash<QString, CachedStretch> m_StretchCache;
+        QByteArray m_Format { "jpg" };
+        quint64 m_Dropped { 0 };
+
+        // Automatic stretch parameters are recomputed after this many frames.
+        static const int STRETCH_REFRESH_FRAMES = 10;
+};
+}
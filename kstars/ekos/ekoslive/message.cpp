@@ -44,7 +44,8 @@
 namespace EkosLive
 {
 Message::Message(Ekos::Manager *manager, QVector<QSharedPointer<NodeManager>> &nodeManagers):
-    m_Manager(manager), m_NodeManagers(nodeManagers), m_DSOManager(CatalogsDB::dso_db_path())
+    m_Manager(manager), m_NodeManagers(nodeManagers), m_StateChannel(commands[NEW_STATE_DELTA]),
+    m_DSOManager(CatalogsDB::dso_db_path())
 {
     for (auto &nodeManager : m_NodeManagers)
     {
@@ -74,6 +75,10 @@ Message::Message(Ekos::Manager *manager, QVector<QSharedPointer<NodeManager>> &n
 
     m_DebouncedSend.setInterval(500);
     connect(&m_DebouncedSend, &QTimer::timeout, this, &Message::dispatchDebounceQueue);
+
+    m_StateFlush.setInterval(STATE_FLUSH_INTERVAL);
+    m_StateFlush.setSingleShot(true);
+    connect(&m_StateFlush, &QTimer::timeout, this, &Message::dispatchStateChannel);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +93,12 @@ void Message::onConnected()
     qCInfo(KSTARS_EKOS) << "Connected to Message Websocket server at" << node->url().toDisplayString();
 
     m_PendingPropertiesTimer.start();
+    // The new client knows nothing yet, send it the complete state of every module.
+    if (Options::ekosLiveCompactStates())
+    {
+        m_StateChannel.resync();
+        m_StateFlush.start();
+    }
     sendConnection();
     sendProfiles();
     emit connected();
@@ -2465,7 +2476,10 @@ void Message::autofocusAborted()
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateMountStatus(const QJsonObject &status, bool throttle)
 {
-    if (throttle)
+    // The compact channel coalesces updates, which limits their rate without dropping any key.
+    if (Options::ekosLiveCompactStates())
+        sendState(commands[NEW_MOUNT_STATE], status);
+    else if (throttle)
     {
         QDateTime now = QDateTime::currentDateTime();
         if (m_ThrottleTS.msecsTo(now) >= THROTTLE_INTERVAL)
@@ -2483,7 +2497,7 @@ void Message::updateMountStatus(const QJsonObject &status, bool throttle)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateCaptureStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_CAPTURE_STATE], status);
+    sendState(commands[NEW_CAPTURE_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2491,7 +2505,7 @@ void Message::updateCaptureStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateFocusStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_FOCUS_STATE], status);
+    sendState(commands[NEW_FOCUS_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2499,7 +2513,7 @@ void Message::updateFocusStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateGuideStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_GUIDE_STATE], status);
+    sendState(commands[NEW_GUIDE_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2507,7 +2521,7 @@ void Message::updateGuideStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateDomeStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_DOME_STATE], status);
+    sendState(commands[NEW_DOME_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2515,7 +2529,7 @@ void Message::updateDomeStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateCapStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_CAP_STATE], status);
+    sendState(commands[NEW_CAP_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2523,7 +2537,38 @@ void Message::updateCapStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateAlignStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_ALIGN_STATE], status);
+    sendState(commands[NEW_ALIGN_STATE], status);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::sendState(const QString &topic, const QJsonObject &status)
+{
+    if (Options::ekosLiveCompactStates() == false)
+    {
+        sendResponse(topic, status);
+        return;
+    }
+
+    m_StateChannel.update(topic, status);
+    if (!m_StateFlush.isActive())
+        m_StateFlush.start();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::dispatchStateChannel()
+{
+    const QByteArray frame = m_StateChannel.flush();
+    if (frame.isEmpty())
+        return;
+
+    for (auto &nodeManager : m_NodeManagers)
+    {
+        nodeManager->message()->sendBinaryMessage(frame);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2534,7 +2579,8 @@ void Message::sendConnection()
     QJsonObject connectionState =
     {
         {"connected", true},
-        {"online", m_Manager->getEkosStartingStatus() == Ekos::Success}
+        {"online", m_Manager->getEkosStartingStatus() == Ekos::Success},
+        {"compactStates", Options::ekosLiveCompactStates()}
     };
 
     sendResponse(commands[NEW_CONNECTION_STATE], connectionState);
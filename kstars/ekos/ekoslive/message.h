@@ -16,6 +16,7 @@
 #include "ekos/manager.h"
 #include "catalogsdb.h"
 #include "nodemanager.h"
+#include "statechannel.h"
 #include <QQueue>
 
 namespace EkosLive
@@ -213,6 +214,10 @@ class Message : public QObject
 
         void dispatchDebounceQueue();
 
+        // Send a module state, as JSON or through the compact state channel
+        void sendState(const QString &topic, const QJsonObject &status);
+        void dispatchStateChannel();
+
         KStarsDateTime getNextDawn();
 
         void sendResponse(const QString &command, const QJsonObject &payload);
@@ -254,6 +259,8 @@ class Message : public QObject
         QTimer m_PendingPropertiesTimer;
         QTimer m_DebouncedSend;
         QMap<QString, QVariantMap> m_DebouncedMap;
+        StateChannel m_StateChannel;
+        QTimer m_StateFlush;
 
         QDateTime m_ThrottleTS;
         CatalogsDB::DBManager m_DSOManager;
@@ -269,6 +276,8 @@ class Message : public QObject
 
         // Throttle interval
         static const uint16_t THROTTLE_INTERVAL = 1000;
+        // Compact state channel flush interval
+        static const uint16_t STATE_FLUSH_INTERVAL = 250;
 };
 
 inline uint qHash(const Message::PendingProperty &key, uint seed = 0) noexcept
@@ -21,6 +21,8 @@
 #include <basedevice.h>
 #include <QUuid>
 
+#include <algorithm>
+
 namespace EkosLive
 {
 Node::Node(const QString &name) : m_Name(name)
@@ -29,6 +31,11 @@ Node::Node(const QString &name) : m_Name(name)
     connect(&m_WebSocket, &QWebSocket::disconnected, this, &Node::onDisconnected);
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this,
             &Node::onError);
+    connect(&m_WebSocket, &QWebSocket::bytesWritten, this, [this](qint64 bytes)
+    {
+        // Frame headers are counted too, so this may overshoot.
+        m_PendingBytes = std::max<qint64>(0, m_PendingBytes - bytes);
+    });
 
     m_Path = "/" + m_Name + "/ekos";
 }
@@ -84,6 +91,7 @@ void Node::onDisconnected()
 {
     qCInfo(KSTARS_EKOS) << "Disconnected from" << m_Name << "Websocket server at" << m_URL.toDisplayString();
     m_isConnected = false;
+    m_PendingBytes = 0;
 
     disconnect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextReceived);
     disconnect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryReceived);
@@ -165,7 +173,7 @@ void Node::sendBinaryMessage(const QByteArray &message)
 {
     if (m_isConnected == false)
         return;
-    m_WebSocket.sendBinaryMessage(message);
+    m_PendingBytes += m_WebSocket.sendBinaryMessage(message);
 }
 
 }
@@ -32,7 +32,9 @@ class Node : public QObject
 
         void sendTextMessage(const QString &message);
         void sendBinaryMessage(const QByteArray &message);
-        bool isConnected() const {return m_isConnected;}        
+        bool isConnected() const {return m_isConnected;}
+        // Bytes handed to sendBinaryMessage() that the socket has not written yet.
+        qint64 pendingBytes() const {return m_PendingBytes;}
 
         void setAuthResponse(const QJsonObject &response)
         {
@@ -64,6 +66,7 @@ class Node : public QObject
         QString m_Path;
 
         bool m_isConnected { false };
+        qint64 m_PendingBytes { 0 };
         bool m_sendBlobs { true};
 
         QMap<int, bool> m_Options;        
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    Message Channel compact state encoder
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "statechannel.h"
+
+#include <QCborValue>
+
+namespace EkosLive
+{
+
+StateChannel::StateChannel(const QString &type) : m_Type(type)
+{
+}
+
+void StateChannel::update(const QString &topic, const QJsonObject &state)
+{
+    const QCborMap sent = m_Sent.value(topic);
+    QCborMap &pending = m_Pending[topic];
+
+    for (auto it = state.constBegin(); it != state.constEnd(); ++it)
+    {
+        const QCborValue value = QCborValue::fromJsonValue(it.value());
+        // A key that went back to the value the client already has needs no update anymore.
+        if (sent.contains(it.key()) && sent.value(it.key()) == value)
+            pending.remove(it.key());
+        else
+            pending.insert(it.key(), value);
+    }
+
+    if (pending.isEmpty())
+        m_Pending.remove(topic);
+}
+
+bool StateChannel::hasPending() const
+{
+    return !m_Pending.isEmpty() || (m_Resync && !m_Sent.isEmpty());
+}
+
+QByteArray StateChannel::flush()
+{
+    if (!hasPending())
+        return QByteArray();
+
+    QCborMap payload;
+    for (auto it = m_Pending.constBegin(); it != m_Pending.constEnd(); ++it)
+    {
+        QCborMap &sent = m_Sent[it.key()];
+        for (auto value = it.value().constBegin(); value != it.value().constEnd(); ++value)
+            sent.insert(value.key(), value.value());
+
+        if (!m_Resync)
+            payload.insert(it.key(), it.value());
+    }
+
+    if (m_Resync)
+    {
+        for (auto it = m_Sent.constBegin(); it != m_Sent.constEnd(); ++it)
+        {
+            if (!it.value().isEmpty())
+                payload.insert(it.key(), it.value());
+        }
+    }
+
+    QCborMap frame;
+    frame.insert(QStringLiteral("type"), m_Type);
+    frame.insert(QStringLiteral("seq"), static_cast<qint64>(m_Sequence++));
+    frame.insert(QStringLiteral("full"), m_Resync);
+    frame.insert(QStringLiteral("payload"), payload);
+
+    m_Pending.clear();
+    m_Resync = false;
+
+    return frame.toCborValue().toCbor();
+}
+
+void StateChannel::resync()
+{
+    m_Resync = true;
+}
+
+void StateChannel::clear()
+{
+    m_Sent.clear();
+    m_Pending.clear();
+    m_Resync = false;
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    Message Channel compact state encoder
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QCborMap>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+namespace EkosLive
+{
+/**
+ * @class StateChannel
+ * @brief Encodes module state updates as compact, delta encoded CBOR frames.
+ *
+ * The JSON protocol sends every state update of a module (mount, guide, capture...) as a
+ * complete text message as soon as it happens, even if most of its keys did not change.
+ * With the compact protocol the updates are instead collected per topic and flushed
+ * periodically as one binary frame:
+ *
+ * - Updates are coalesced by key, only the latest value of a key since the last flush is sent.
+ * - Each topic is delta encoded against the state that was last sent for it, keys whose
+ *   value did not change are left out. Topics without any change are left out entirely.
+ *
+ * A frame is a CBOR map {"type": type, "seq": sequence, "full": bool, "payload": {topic: {key: value}}}.
+ * A client merges every topic of the payload into the state it holds for it. Only top level
+ * keys are compared, a nested object is sent as a whole when any part of it changed. When
+ * full is set the payload holds the complete state of every topic, e.g. after resync() was
+ * called for a newly connected client.
+ *
+ * The class is not thread safe, it is used from the thread owning the Message channel.
+ */
+class StateChannel
+{
+    public:
+        /** @param type Sent as the type of each frame. */
+        explicit StateChannel(const QString &type);
+
+        /** @brief update Queue a state update of topic for the next frame. */
+        void update(const QString &topic, const QJsonObject &state);
+
+        /** @brief hasPending True if the next flush() produces a frame. */
+        bool hasPending() const;
+
+        /** @brief flush Encode all pending changes into a frame. Returns an empty array if nothing changed. */
+        QByteArray flush();
+
+        /** @brief resync Send the complete state of every topic with the next frame. */
+        void resync();
+
+        /** @brief clear Forget the sent and pending states of all topics. */
+        void clear();
+
+    private:
+        QString m_Type;
+        QHash<QString, QCborMap> m_Sent;
+        QHash<QString, QCborMap> m_Pending;
+        quint64 m_Sequence { 0 };
+        bool m_Resync { false };
+};
+}
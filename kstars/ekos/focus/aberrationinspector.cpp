@@ -10,7 +10,9 @@
 #include <kstars_debug.h>
 #include "kstars.h"
 #include "Options.h"
+#include <QElapsedTimer>
 #include <QSplitter>
+#include <QtConcurrent>
 
 const float RADIANS2DEGREES = 360.0f / (2.0f * M_PI);
 
@@ -423,8 +425,6 @@ void AberrationInspector::tableResize()
 // Run curve fitting on the collected data for each tile, updating other widgets as we go
 void AberrationInspector::fitCurves()
 {
-    curveFitting.reset(new CurveFitting());
-
     const double expected = 0.0;
     int minPos, maxPos;
 
@@ -441,24 +441,71 @@ void AberrationInspector::fitCurves()
         }
     }
 
-    for (int tile = 0; tile < m_measures.count(); tile++)
+    // Each tile is fitted with its own CurveFitting object so the tiles can be solved in parallel
+    struct TileFit
     {
-        curveFitting->fitCurve(CurveFitting::FittingGoal::BEST, m_positions, m_measures[tile], m_weights[tile], outliers,
-                               m_data.curveFit, m_data.useWeights, m_data.optDir);
-
+        std::unique_ptr<CurveFitting> curveFitting;
         double position = 0.0;
         double measure = 0.0;
         double R2 = 0.0;
-        bool foundFit = curveFitting->findMinMax(expected, static_cast<double>(minPos), static_cast<double>(maxPos), &position,
-                        &measure, m_data.curveFit, m_data.optDir);
-        if (foundFit)
-            R2 = curveFitting->calculateR2(m_data.curveFit);
+        bool foundFit = false;
+    };
+    const int numTiles = m_measures.count();
+    std::vector<TileFit> tileFits(numTiles);
+
+    auto fitTile = [&](int tile)
+    {
+        TileFit &tileFit = tileFits[tile];
+        tileFit.curveFitting->fitCurve(CurveFitting::FittingGoal::BEST, m_positions, m_measures[tile], m_weights[tile], outliers,
+                                       m_data.curveFit, m_data.useWeights, m_data.optDir);
+        tileFit.foundFit = tileFit.curveFitting->findMinMax(expected, static_cast<double>(minPos), static_cast<double>(maxPos),
+                           &tileFit.position, &tileFit.measure, m_data.curveFit, m_data.optDir);
+        if (tileFit.foundFit)
+            tileFit.R2 = tileFit.curveFitting->calculateR2(m_data.curveFit);
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Solve the centre tile first. The other tiles have similar curves so they warm start from its solution.
+    const int firstTile = (numTiles > TILE_CM) ? TILE_CM : 0;
+    if (numTiles > 0)
+    {
+        tileFits[firstTile].curveFitting.reset(new CurveFitting());
+        fitTile(firstTile);
+    }
 
-        position = round(position);
+    QVector<QFuture<void>> futures;
+    for (int tile = 0; tile < numTiles; tile++)
+    {
+        if (tile == firstTile)
+            continue;
+        tileFits[tile].curveFitting.reset(new CurveFitting(*tileFits[firstTile].curveFitting));
+        futures.append(QtConcurrent::run([&fitTile, tile]()
+        {
+            fitTile(tile);
+        }));
+    }
+    for (auto &future : futures)
+        future.waitForFinished();
+
+    for (int tile = 0; tile < numTiles; tile++)
+    {
+        const auto &stats = tileFits[tile].curveFitting->lastFitStats();
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Aberration Inspector: tile %1 fit %2 after %3 iters in %4 attempt(s), %5ms, %6 start")
+                                   .arg(TILE_NAME[tile]).arg(stats.solved ? "solved" : "failed").arg(stats.iterations)
+                                   .arg(stats.attempts).arg(stats.elapsedMs).arg(stats.warmStart ? "warm" : "cold");
+    }
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Aberration Inspector: %1 tiles fitted in %2ms").arg(numTiles).arg(timer.elapsed());
+
+    for (int tile = 0; tile < numTiles; tile++)
+    {
+        TileFit &tileFit = tileFits[tile];
+        double position = round(tileFit.position);
         m_minimum.append(position);
-        m_minMeasure.append(measure);
-        m_fit.append(foundFit);
-        m_R2.append(R2);
+        m_minMeasure.append(tileFit.measure);
+        m_fit.append(tileFit.foundFit);
+        m_R2.append(tileFit.R2);
 
         // Add the datapoints to the plot for the current tile
         // JEE Need to sort out what to do with outliers... for now ignore them
@@ -470,12 +517,12 @@ void AberrationInspector::fitCurves()
 
         m_plot->addData(m_positions, m_measures[tile], m_weights[tile], outliers);
         // Fit the curve - note this needs curveFitting with the parameters for the current solution
-        m_plot->drawCurve(tile, curveFitting.get(), position, measure, foundFit, R2);
+        m_plot->drawCurve(tile, tileFit.curveFitting.get(), position, tileFit.measure, tileFit.foundFit, tileFit.R2);
         // Draw solutions on the plot
-        m_plot->drawMaxMin(tile, position, measure);
+        m_plot->drawMaxMin(tile, position, tileFit.measure);
         // Draw the CFZ for the central tile
         if (tile == TILE_CM)
-            m_plot->drawCFZ(position, measure, m_data.cfzSteps);
+            m_plot->drawCFZ(position, tileFit.measure, m_data.cfzSteps);
     }
 }
 
@@ -2,6 +2,8 @@
 #include "ekos/ekos.h"
 #include <ekos_focus_debug.h>
 
+#include <QMutex>
+
 // Constants used to identify the number of parameters used for different curve types
 constexpr int NUM_HYPERBOLA_PARAMS = 4;
 constexpr int NUM_PARABOLA_PARAMS = 3;
@@ -924,6 +926,34 @@ int plaFxyxy(const gsl_vector* X,  const gsl_vector* v, void* inParams, gsl_vect
 
     return GSL_SUCCESS;
 }
+
+// GSL's error handler is process wide. Fits may run concurrently (e.g. Aberration Inspector tiles) so
+// only the first fit to start turns the handler off and only the last one to finish restores it.
+class GSLErrorHandlerOff
+{
+    public:
+        GSLErrorHandlerOff()
+        {
+            QMutexLocker locker(&s_Mutex);
+            if (s_Users++ == 0)
+                s_OldHandler = gsl_set_error_handler_off();
+        }
+        ~GSLErrorHandlerOff()
+        {
+            QMutexLocker locker(&s_Mutex);
+            if (--s_Users == 0)
+                gsl_set_error_handler(s_OldHandler);
+        }
+
+    private:
+        static QMutex s_Mutex;
+        static int s_Users;
+        static gsl_error_handler_t *s_OldHandler;
+};
+
+QMutex GSLErrorHandlerOff::s_Mutex;
+int GSLErrorHandlerOff::s_Users = 0;
+gsl_error_handler_t *GSLErrorHandlerOff::s_OldHandler = nullptr;
 }  // namespace
 
 CurveFitting::CurveFitting()
@@ -1098,7 +1128,7 @@ QVector<double> CurveFitting::polynomial_fit(const double *const data_x, const d
     }
 
     // Must turn off error handler or it aborts on error
-    gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     gsl_multifit_linear_workspace *work = gsl_multifit_linear_alloc(n, order + 1);
     status                              = gsl_multifit_linear(X, y, c, cov, &chisq, work);
@@ -1123,6 +1153,47 @@ QVector<double> CurveFitting::polynomial_fit(const double *const data_x, const d
     return vc;
 }
 
+gsl_multifit_nlinear_workspace *CurveFitting::LMWorkspace::get(const gsl_multifit_nlinear_parameters &params, size_t n,
+        size_t p)
+{
+    if (m_Workspace != nullptr && m_N == n && m_P == p && m_Params.trs == params.trs && m_Params.scale == params.scale
+            && m_Params.solver == params.solver && m_Params.fdtype == params.fdtype)
+        return m_Workspace;
+
+    release();
+    m_Workspace = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, n, p);
+    if (m_Workspace != nullptr)
+    {
+        m_Params = params;
+        m_N = n;
+        m_P = p;
+    }
+    return m_Workspace;
+}
+
+void CurveFitting::LMWorkspace::release()
+{
+    if (m_Workspace != nullptr)
+        gsl_multifit_nlinear_free(m_Workspace);
+    m_Workspace = nullptr;
+    m_N = m_P = 0;
+}
+
+bool CurveFitting::canWarmStart(const CurveFit curveType, const int numParams) const
+{
+    return !m_FirstSolverRun && m_LastCurveType == curveType && m_LastCoefficients.size() == numParams;
+}
+
+void CurveFitting::recordFitStats(const QElapsedTimer &timer, const int attempts, const int iterations,
+                                  const bool warmStart, const bool solved)
+{
+    m_LastFitStats.attempts = attempts;
+    m_LastFitStats.iterations = iterations;
+    m_LastFitStats.elapsedMs = timer.elapsed();
+    m_LastFitStats.warmStart = warmStart;
+    m_LastFitStats.solved = solved;
+}
+
 QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<double> data_x, const QVector<double> data_y,
         const QVector<double> data_weights, const QVector<bool> outliers, const bool useWeights, const OptimisationDirection optDir)
 {
@@ -1138,12 +1209,11 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
 
     auto weights = gsl_vector_alloc(dataPoints.dps.size());
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace *w = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, dataPoints.dps.size(),
-                                        NUM_HYPERBOLA_PARAMS);
+    gsl_multifit_nlinear_workspace *w = m_Workspace.get(params, dataPoints.dps.size(), NUM_HYPERBOLA_PARAMS);
     gsl_multifit_nlinear_fdf fdf;
     gsl_vector *guess = gsl_vector_alloc(NUM_HYPERBOLA_PARAMS);
     int numIters;
@@ -1186,6 +1256,8 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
     // Start a timer to see how long the solve takes.
     QElapsedTimer timer;
     timer.start();
+    int attempts = 0, iterations = 0;
+    const bool warmStart = canWarmStart(FOCUS_HYPERBOLA, NUM_HYPERBOLA_PARAMS);
 
     // We can sometimes have several attempts to solve based on "goal" and why the solver failed.
     // If the goal is STANDARD and we fail to solve then so be it. If the goal is BEST, then retry
@@ -1217,6 +1289,8 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
 
         int info = 0;
         int status = gsl_multifit_nlinear_driver(numIters, xtol, gtol, ftol, NULL, NULL, &info, w);
+        attempts++;
+        iterations += gsl_multifit_nlinear_niter(w);
 
         if (status != 0)
         {
@@ -1255,14 +1329,12 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
         }
     }
 
+    recordFitStats(timer, attempts, iterations, warmStart, !vc.isEmpty());
+
     // Free GSL memory
-    gsl_multifit_nlinear_free(w);
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -1454,12 +1526,11 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
 
     auto weights = gsl_vector_alloc(dataPoints.dps.size());
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, dataPoints.dps.size(),
-                                        NUM_PARABOLA_PARAMS);
+    gsl_multifit_nlinear_workspace *w = m_Workspace.get(params, dataPoints.dps.size(), NUM_PARABOLA_PARAMS);
     gsl_multifit_nlinear_fdf fdf;
     gsl_vector * guess = gsl_vector_alloc(NUM_PARABOLA_PARAMS);
     int numIters;
@@ -1500,6 +1571,8 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
     // Start a timer to see how long the solve takes.
     QElapsedTimer timer;
     timer.start();
+    int attempts = 0, iterations = 0;
+    const bool warmStart = canWarmStart(FOCUS_PARABOLA, NUM_PARABOLA_PARAMS);
 
     // We can sometimes have several attempts to solve based on "goal" and why the solver failed.
     // If the goal is STANDARD and we fail to solve then so be it. If the goal is BEST, then retry
@@ -1531,6 +1604,8 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
 
         int info = 0;
         int status = gsl_multifit_nlinear_driver(numIters, xtol, gtol, ftol, NULL, NULL, &info, w);
+        attempts++;
+        iterations += gsl_multifit_nlinear_niter(w);
 
         if (status != 0)
         {
@@ -1568,14 +1643,12 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
         }
     }
 
+    recordFitStats(timer, attempts, iterations, warmStart, !vc.isEmpty());
+
     // Free GSL memory
-    gsl_multifit_nlinear_free(w);
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -1720,12 +1793,11 @@ QVector<double> CurveFitting::gaussian2D_fit(FittingGoal goal, const QVector<dou
 
     auto weights = gsl_vector_alloc(dataPoints.dps.size());
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, dataPoints.dps.size(),
-                                        NUM_2DGAUSSIAN_PARAMS);
+    gsl_multifit_nlinear_workspace *w = m_Workspace.get(params, dataPoints.dps.size(), NUM_2DGAUSSIAN_PARAMS);
     gsl_multifit_nlinear_fdf fdf;
     gsl_vector * guess = gsl_vector_alloc(NUM_2DGAUSSIAN_PARAMS);
     int numIters;
@@ -1742,6 +1814,8 @@ QVector<double> CurveFitting::gaussian2D_fit(FittingGoal goal, const QVector<dou
     // Start a timer to see how long the solve takes.
     QElapsedTimer timer;
     timer.start();
+    int attempts = 0, iterations = 0;
+    const bool warmStart = canWarmStart(FOCUS_2DGAUSSIAN, NUM_2DGAUSSIAN_PARAMS);
 
     // We can sometimes have several attempts to solve based on "goal" and why the solver failed.
     // If the goal is STANDARD and we fail to solve then so be it. If the goal is BEST, then retry
@@ -1773,6 +1847,8 @@ QVector<double> CurveFitting::gaussian2D_fit(FittingGoal goal, const QVector<dou
 
         int info = 0;
         int status = gsl_multifit_nlinear_driver(numIters, xtol, gtol, ftol, NULL, NULL, &info, w);
+        attempts++;
+        iterations += gsl_multifit_nlinear_niter(w);
 
         if (status != 0)
         {
@@ -1811,14 +1887,12 @@ QVector<double> CurveFitting::gaussian2D_fit(FittingGoal goal, const QVector<dou
         }
     }
 
+    recordFitStats(timer, attempts, iterations, warmStart, !vc.isEmpty());
+
     // Free GSL memory
-    gsl_multifit_nlinear_free(w);
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -1965,12 +2039,11 @@ QVector<double> CurveFitting::gaussian3D_fit(DataPoint3DT data, const StarParams
     QVector<double> vc;
 
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, data.dps.size(),
-                                        NUM_3DGAUSSIAN_PARAMS);
+    gsl_multifit_nlinear_workspace *w = m_Workspace.get(params, data.dps.size(), NUM_3DGAUSSIAN_PARAMS);
     gsl_multifit_nlinear_fdf fdf;
     int numIters;
     double xtol, gtol, ftol;
@@ -1991,6 +2064,8 @@ QVector<double> CurveFitting::gaussian3D_fit(DataPoint3DT data, const StarParams
     // Setup a timer to see how long the solve takes
     QElapsedTimer timer;
     timer.start();
+    int attempts = 0, iterations = 0;
+    const bool warmStart = false;
 
     // Setup for multiple solve attempts. We won't worry too much if the solver fails as there should be
     // plenty of stars, but if the solver fails on its first step then adjust parameters and retry as this
@@ -2054,6 +2129,8 @@ QVector<double> CurveFitting::gaussian3D_fit(DataPoint3DT data, const StarParams
 
         int info = 0;
         int status = gsl_multifit_nlinear_driver(numIters, xtol, gtol, ftol, NULL, NULL, &info, w);
+        attempts++;
+        iterations += gsl_multifit_nlinear_niter(w);
 
         if (status != 0)
         {
@@ -2079,14 +2156,12 @@ QVector<double> CurveFitting::gaussian3D_fit(DataPoint3DT data, const StarParams
         }
     }
 
+    recordFitStats(timer, attempts, iterations, warmStart, !vc.isEmpty());
+
     // Free GSL memory
-    gsl_multifit_nlinear_free(w);
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -2170,12 +2245,11 @@ QVector<double> CurveFitting::plane_fit(const DataPoint3DT data)
     QVector<double> vc;
 
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, data.dps.size(),
-                                        NUM_PLANE_PARAMS);
+    gsl_multifit_nlinear_workspace *w = m_Workspace.get(params, data.dps.size(), NUM_PLANE_PARAMS);
     gsl_multifit_nlinear_fdf fdf;
     int numIters;
     double xtol, gtol, ftol;
@@ -2196,6 +2270,8 @@ QVector<double> CurveFitting::plane_fit(const DataPoint3DT data)
     // Setup a timer to see how long the solve takes
     QElapsedTimer timer;
     timer.start();
+    int attempts = 0, iterations = 0;
+    const bool warmStart = canWarmStart(FOCUS_PLANE, NUM_PLANE_PARAMS);
 
     // Setup for multiple solve attempts.
     for (int attempt = 0; attempt < 5; attempt++)
@@ -2253,6 +2329,8 @@ QVector<double> CurveFitting::plane_fit(const DataPoint3DT data)
 
         int info = 0;
         int status = gsl_multifit_nlinear_driver(numIters, xtol, gtol, ftol, NULL, NULL, &info, w);
+        attempts++;
+        iterations += gsl_multifit_nlinear_niter(w);
 
         if (status != 0)
         {
@@ -2277,14 +2355,12 @@ QVector<double> CurveFitting::plane_fit(const DataPoint3DT data)
         }
     }
 
+    recordFitStats(timer, attempts, iterations, warmStart, !vc.isEmpty());
+
     // Free GSL memory
-    gsl_multifit_nlinear_free(w);
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -2394,7 +2470,7 @@ bool CurveFitting::minimumQuadratic(double expected, double minPosition, double
     F.params   = this;
 
     // Must turn off error handler or it aborts on error
-    gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     T      = gsl_min_fminimizer_brent;
     s      = gsl_min_fminimizer_alloc(T);
@@ -2,6 +2,7 @@
 
 #include "../../auxiliary/robuststatistics.h"
 
+#include <QElapsedTimer>
 #include <QVector>
 #include <qcustomplot.h>
 #include <gsl/gsl_vector.h>
@@ -97,6 +98,16 @@ class CurveFitting
             double FWHM;
         };
 
+        // Cost of the last LM solve. Reported in the focus log so fit cost can be tracked.
+        struct FitStats
+        {
+            int attempts { 0 };        // Solver runs, including retries
+            int iterations { 0 };      // LM iterations summed over all attempts
+            qint64 elapsedMs { 0 };    // Wall time of the solve
+            bool warmStart { false };  // Initial guess seeded from the previous solution
+            bool solved { false };
+        };
+
         // Constructor just initialises the object
         CurveFitting();
 
@@ -217,7 +228,43 @@ class CurveFitting
         // Does not implement getting the original data points.
         QString serialize() const;
 
+        // Returns the solver cost of the last LM based fit (not used by FOCUS_QUADRATIC)
+        const FitStats &lastFitStats() const
+        {
+            return m_LastFitStats;
+        }
+
     private:
+        // Keeps the GSL LM workspace between solves so that repeated fits of the same size, e.g. each new
+        // autofocus datapoint or each star box of the same size, don't reallocate it. Copies start empty
+        // so that copied CurveFitting objects never share a workspace.
+        class LMWorkspace
+        {
+            public:
+                LMWorkspace() = default;
+                LMWorkspace(const LMWorkspace &) {}
+                LMWorkspace &operator=(const LMWorkspace &)
+                {
+                    release();
+                    return *this;
+                }
+                ~LMWorkspace()
+                {
+                    release();
+                }
+
+                // Returns a workspace for n datapoints and p parameters, reusing the current one if compatible
+                gsl_multifit_nlinear_workspace *get(const gsl_multifit_nlinear_parameters &params, size_t n, size_t p);
+
+            private:
+                void release();
+
+                gsl_multifit_nlinear_workspace *m_Workspace { nullptr };
+                gsl_multifit_nlinear_parameters m_Params;
+                size_t m_N { 0 };
+                size_t m_P { 0 };
+        };
+
         static double curveFunction(double x, void *params);
 
         QVector<double> polynomial_fit(const double *const data_x, const double *const data_y, const int n, const int order);
@@ -260,6 +307,11 @@ class CurveFitting
         // Get the reason code from the passed in info
         QString getLMReasonCode(int info);
 
+        // Whether the MakeGuess functions will seed the solver with the previous solution
+        bool canWarmStart(const CurveFit curveType, const int numParams) const;
+        void recordFitStats(const QElapsedTimer &timer, const int attempts, const int iterations, const bool warmStart,
+                            const bool solved);
+
         // Calculation engine for the R-squared which is a measure of how well the curve fits the datapoints
         double calcR2(const QVector<double> dataPoints, const QVector<double> curvePoints, const QVector<double> scale,
                       const bool useWeights);
@@ -283,6 +335,9 @@ class CurveFitting
         bool m_FirstSolverRun;
         CurveFit m_LastCurveType;
         QVector<double> m_LastCoefficients;
+        // Solver workspace reused between runs
+        LMWorkspace m_Workspace;
+        FitStats m_LastFitStats;
 };
 
 } //namespace
@@ -103,6 +103,9 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
         // Get the minimum number of datapoints before attempting the first curve fit
         int getCurveMinPoints();
 
+        // Log the solver cost of the last curve fit
+        void logFitCost() const;
+
         // Analyze data for donuts are remove
         void removeDonuts();
 
@@ -585,6 +588,7 @@ int LinearFocusAlgorithm::newMeasurement(int position, double value, const doubl
                 auto goal = getGoal(numSteps);
                 params.curveFitting->fitCurve(goal, positions, values, weights, pass1Outliers, params.curveFit, params.useWeights,
                                               params.optimisationDirection);
+                logFitCost();
 
                 foundFit = params.curveFitting->findMinMax(position, 0, params.maxPositionAllowed, &minPos, &minVal,
                            static_cast<CurveFitting::CurveFit>(params.curveFit),
@@ -746,6 +750,14 @@ int LinearFocusAlgorithm::getCurveMinPoints()
     return params.numSteps / 2 + 2;
 }
 
+void LinearFocusAlgorithm::logFitCost() const
+{
+    const auto &stats = params.curveFitting->lastFitStats();
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Linear: curve fit %1 after %2 iters in %3 attempt(s), %4ms, %5 start")
+                               .arg(stats.solved ? "solved" : "failed").arg(stats.iterations).arg(stats.attempts)
+                               .arg(stats.elapsedMs).arg(stats.warmStart ? "warm" : "cold");
+}
+
 // Process next step for LINEAR1PASS for walks: FOCUS_WALK_FIXED_STEPS and FOCUS_WALK_CFZ_SHUFFLE
 int LinearFocusAlgorithm::linearWalk(int position, double value, const double starWeight)
 {
@@ -795,6 +807,7 @@ int LinearFocusAlgorithm::linearWalk(int position, double value, const double st
                 removeDonuts();
             params.curveFitting->fitCurve(goal, positions, values, weights, pass1Outliers, params.curveFit, params.useWeights,
                                           params.optimisationDirection);
+            logFitCost();
 
             foundFit = params.curveFitting->findMinMax(position, 0, params.maxPositionAllowed, &minPos, &minVal,
                        static_cast<CurveFitting::CurveFit>(params.curveFit), params.optimisationDirection);
@@ -1227,6 +1240,7 @@ int LinearFocusAlgorithm::finishFirstPass(int position, double value)
                 // Try another curve fit on the data without outliers
                 params.curveFitting->fitCurve(CurveFitting::FittingGoal::BEST, pass1Positions, pass1Values, pass1Weights,
                                               pass1Outliers, params.curveFit, params.useWeights, params.optimisationDirection);
+                logFitCost();
                 double minPos, minVal;
                 bool foundFit = params.curveFitting->findMinMax(position, 0, params.maxPositionAllowed, &minPos, &minVal,
                                 static_cast<CurveFitting::CurveFit>(params.curveFit),
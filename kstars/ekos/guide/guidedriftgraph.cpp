@@ -10,6 +10,7 @@
 #include "ksnotification.h"
 #include "kstarsdata.h"
 #include "guideinterface.h"
+#include "auxiliary/lodgraph.h"
 #include "Options.h"
 
 // Qt version calming
@@ -89,13 +90,13 @@ GuideDriftGraph::GuideDriftGraph(QWidget *parent)
     axisRect()->insetLayout()->setInsetAlignment(0, Qt::AlignLeft | Qt::AlignBottom);
 
     // RA Curve
-    addGraph(xAxis, yAxis);
+    new LODGraph(xAxis, yAxis);
     graph(GuideGraph::G_RA)->setPen(QPen(KStarsData::Instance()->colorScheme()->colorNamed("RAGuideError")));
     graph(GuideGraph::G_RA)->setName("RA");
     graph(GuideGraph::G_RA)->setLineStyle(QCPGraph::lsLine);
 
     // DE Curve
-    addGraph(xAxis, yAxis);
+    new LODGraph(xAxis, yAxis);
     graph(GuideGraph::G_DEC)->setPen(QPen(KStarsData::Instance()->colorScheme()->colorNamed("DEGuideError")));
     graph(GuideGraph::G_DEC)->setName("DE");
     graph(GuideGraph::G_DEC)->setLineStyle(QCPGraph::lsLine);
@@ -115,7 +116,7 @@ GuideDriftGraph::GuideDriftGraph(QWidget *parent)
             QPen(KStarsData::Instance()->colorScheme()->colorNamed("DEGuideError"), 2), QBrush(), 10));
 
     // RA Pulse
-    addGraph(xAxis, yAxis2);
+    new LODGraph(xAxis, yAxis2);
     QColor raPulseColor(KStarsData::Instance()->colorScheme()->colorNamed("RAGuideError"));
     raPulseColor.setAlpha(75);
     graph(GuideGraph::G_RA_PULSE)->setPen(QPen(raPulseColor));
@@ -124,7 +125,7 @@ GuideDriftGraph::GuideDriftGraph(QWidget *parent)
     graph(GuideGraph::G_RA_PULSE)->setLineStyle(QCPGraph::lsStepLeft);
 
     // DEC Pulse
-    addGraph(xAxis, yAxis2);
+    new LODGraph(xAxis, yAxis2);
     QColor dePulseColor(KStarsData::Instance()->colorScheme()->colorNamed("DEGuideError"));
     dePulseColor.setAlpha(75);
     graph(GuideGraph::G_DEC_PULSE)->setPen(QPen(dePulseColor));
@@ -133,25 +134,25 @@ GuideDriftGraph::GuideDriftGraph(QWidget *parent)
     graph(GuideGraph::G_DEC_PULSE)->setLineStyle(QCPGraph::lsStepLeft);
 
     // SNR
-    addGraph(xAxis, snrAxis);
+    new LODGraph(xAxis, snrAxis);
     graph(GuideGraph::G_SNR)->setPen(QPen(Qt::yellow));
     graph(GuideGraph::G_SNR)->setName("SNR");
     graph(GuideGraph::G_SNR)->setLineStyle(QCPGraph::lsLine);
 
     // RA RMS
-    addGraph(xAxis, yAxis);
+    new LODGraph(xAxis, yAxis);
     graph(GuideGraph::G_RA_RMS)->setPen(QPen(Qt::red));
     graph(GuideGraph::G_RA_RMS)->setName("RA RMS");
     graph(GuideGraph::G_RA_RMS)->setLineStyle(QCPGraph::lsLine);
 
     // DEC RMS
-    addGraph(xAxis, yAxis);
+    new LODGraph(xAxis, yAxis);
     graph(GuideGraph::G_DEC_RMS)->setPen(QPen(Qt::red));
     graph(GuideGraph::G_DEC_RMS)->setName("DEC RMS");
     graph(GuideGraph::G_DEC_RMS)->setLineStyle(QCPGraph::lsLine);
 
     // Total RMS
-    addGraph(xAxis, yAxis);
+    new LODGraph(xAxis, yAxis);
     graph(GuideGraph::G_RMS)->setPen(QPen(Qt::red));
     graph(GuideGraph::G_RMS)->setName("RMS");
     graph(GuideGraph::G_RMS)->setLineStyle(QCPGraph::lsLine);
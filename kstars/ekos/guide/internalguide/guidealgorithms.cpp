@@ -9,13 +9,17 @@
 
 #include "guidealgorithms.h"
 
+#include <algorithm>
+#include <cmath>
 #include <set>
+#include <vector>
 #include <QObject>
 
 #include "ekos_guide_debug.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 #include "Options.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/skybackground.h"
 
 #define SMART_THRESHOLD    0
 #define SEP_THRESHOLD      1
@@ -881,3 +885,144 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
 
     return GuiderUtils::Vector(-1, -1, -1);
 }
+
+template <typename T>
+bool GuideAlgorithms::refineStarPosition(const QSharedPointer<FITSData> &imageData,
+        const SkyBackground &background,
+        const int radius, Edge *star)
+{
+    // Stars smaller than this are most likely hot pixels or noise.
+    constexpr int MIN_STAR_PIXELS = 3;
+    // Pixels below mean + this many sigmas are considered background.
+    constexpr double THRESHOLD_SIGMAS = 3.0;
+
+    T const *pixels = reinterpret_cast<T const *>(imageData->getImageBuffer());
+    const int width = imageData->width();
+    const int height = imageData->height();
+    const double threshold = background.mean + THRESHOLD_SIGMAS * background.sigma;
+    const double startX = star->x, startY = star->y;
+
+    double x = star->x, y = star->y;
+    double sum = 0, peak = 0;
+    int numPixels = 0;
+    QRect window;
+
+    // Two passes, so that the window is re-centered on a star that moved since the previous frame.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const int cx = static_cast<int>(std::lround(x));
+        const int cy = static_cast<int>(std::lround(y));
+        window = QRect(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1).intersected(QRect(0, 0, width, height));
+        if (window.isEmpty())
+            return false;
+
+        double sumX = 0, sumY = 0;
+        sum = 0;
+        peak = 0;
+        numPixels = 0;
+        for (int j = window.top(); j <= window.bottom(); j++)
+        {
+            T const *row = pixels + j * width;
+            for (int i = window.left(); i <= window.right(); i++)
+            {
+                const double value = row[i];
+                if (value <= threshold)
+                    continue;
+                const double w = value - background.mean;
+                sumX += w * i;
+                sumY += w * j;
+                sum += w;
+                numPixels++;
+                if (value > peak)
+                    peak = value;
+            }
+        }
+
+        if (numPixels < MIN_STAR_PIXELS || sum <= 0)
+            return false;
+
+        x = sumX / sum;
+        y = sumY / sum;
+    }
+
+    if (std::hypot(x - startX, y - startY) > radius)
+        return false;
+
+    // Half flux radius around the refined centroid, same window as the last pass: the radius
+    // inside which the background-subtracted pixels above the threshold add up to half of sum.
+    std::vector<std::pair<double, double>> radii;
+    radii.reserve(numPixels);
+    for (int j = window.top(); j <= window.bottom(); j++)
+    {
+        T const *row = pixels + j * width;
+        for (int i = window.left(); i <= window.right(); i++)
+        {
+            const double value = row[i];
+            if (value > threshold)
+                radii.emplace_back(std::hypot(i - x, j - y), value - background.mean);
+        }
+    }
+    std::sort(radii.begin(), radii.end());
+
+    double hfr = radii.back().first;
+    double flux = 0, lastRadius = 0;
+    for (const auto &r : radii)
+    {
+        if (flux + r.second >= sum / 2)
+        {
+            // Interpolate between the radius of the previous pixel and this one.
+            hfr = lastRadius + (r.first - lastRadius) * (sum / 2 - flux) / r.second;
+            break;
+        }
+        flux += r.second;
+        lastRadius = r.first;
+    }
+
+    star->x = x;
+    star->y = y;
+    star->sum = sum;
+    star->numPixels = numPixels;
+    star->val = static_cast<int>(peak);
+    star->HFR = hfr;
+    return true;
+}
+
+bool GuideAlgorithms::refineStarPosition(const QSharedPointer<FITSData> &imageData,
+        const SkyBackground &background,
+        const int radius, Edge *star)
+{
+    if (imageData.isNull() || star == nullptr)
+        return false;
+
+    switch (imageData->dataType())
+    {
+        case TBYTE:
+            return refineStarPosition<uint8_t>(imageData, background, radius, star);
+
+        case TSHORT:
+            return refineStarPosition<int16_t>(imageData, background, radius, star);
+
+        case TUSHORT:
+            return refineStarPosition<uint16_t>(imageData, background, radius, star);
+
+        case TLONG:
+            return refineStarPosition<int32_t>(imageData, background, radius, star);
+
+        case TULONG:
+            return refineStarPosition<uint32_t>(imageData, background, radius, star);
+
+        case TFLOAT:
+            return refineStarPosition<float>(imageData, background, radius, star);
+
+        case TLONGLONG:
+            return refineStarPosition<int64_t>(imageData, background, radius, star);
+
+        case TDOUBLE:
+            return refineStarPosition<double>(imageData, background, radius, star);
+
+        default:
+            break;
+    }
+
+    return false;
+}
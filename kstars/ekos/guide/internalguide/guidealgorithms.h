@@ -16,6 +16,7 @@
 
 class FITSData;
 class Edge;
+class SkyBackground;
 
 // Traditional guiding functions for star detection.
 class GuideAlgorithms : public QObject
@@ -29,6 +30,13 @@ class GuideAlgorithms : public QObject
                 const int videoWidth,
                 const int videoHeight,
                 const QRect &trackingBox);
+
+        // Re-measures a star near its previous position using a windowed, background-subtracted
+        // first-moment fit. Updates x, y, sum, numPixels, val and HFR (half flux radius) of the star.
+        // Returns false if no star was found within radius pixels of the previous position.
+        static bool refineStarPosition(const QSharedPointer<FITSData> &imageData,
+                                       const SkyBackground &background,
+                                       const int radius, Edge *star);
     private:
         template <typename T>
         static GuiderUtils::Vector findLocalStarPosition(QSharedPointer<FITSData> &imageData,
@@ -36,5 +44,10 @@ class GuideAlgorithms : public QObject
                 const int videoWidth,
                 const int videoHeight,
                 const QRect &trackingBox);
+
+        template <typename T>
+        static bool refineStarPosition(const QSharedPointer<FITSData> &imageData,
+                                       const SkyBackground &background,
+                                       const int radius, Edge *star);
 };
 
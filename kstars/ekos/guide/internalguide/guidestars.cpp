@@ -7,6 +7,7 @@
 #include "guidestars.h"
 
 #include "ekos_guide_debug.h"
+#include "guidealgorithms.h"
 #include "../guideview.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitssepdetector.h"
@@ -29,6 +30,14 @@
 // It will instead back-off to a reticle-based algorithm.
 #define MIN_STAR_CORRESPONDENCE_SIZE 5
 
+// In incremental detection, stars are searched within this many pixels
+// (plus a multiple of their HFR) of their previous position.
+constexpr int REFINE_SEARCH_MARGIN = 8;
+
+// In incremental detection, run a full detection if fewer than this fraction
+// of the previous stars are found again.
+constexpr double MIN_REFINED_FRACTION = 0.75;
+
 // We limit the HFR for guide stars. When searching for the guide star, we relax this by the
 // margin below (e.g. if a guide star was selected that was near the max guide-star hfr, the later
 // the hfr increased a little, we still want to be able to find it.
@@ -321,8 +330,19 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     const double maxHFR = Options::guideMaxHFR() + HFR_MARGIN;
     if (starCorrespondence.size() > 0)
     {
-
-        findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
+        // Only run the full-frame detection periodically, or when the stars can't be refined.
+        const bool refined = Options::guideIncrementalDetection() && !firstFrame && m_CanRefineStars &&
+                             m_FramesSinceFullDetection < static_cast<int>(Options::guideFullDetectionInterval()) &&
+                             refineDetectedStars(imageData, maxHFR);
+        if (refined)
+            m_FramesSinceFullDetection++;
+        else
+        {
+            findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
+            m_FramesSinceFullDetection = 0;
+            m_FullDetectionSize = detectedStars.size();
+        }
+        m_CanRefineStars = false;
         if (detectedStars.empty())
             return GuiderUtils::Vector(-1, -1, -1);
 
@@ -351,8 +371,10 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
                 guideStarSNR = SNR;
                 guideStarMass = star.sum;
                 unreliableDectionCounter = 0;
-                qCDebug(KSTARS_EKOS_GUIDE) << QString("StarCorrespondence found star %1 at %2 %3 SNR %4")
-                                           .arg(i).arg(star.x, 0, 'f', 1).arg(star.y, 0, 'f', 1).arg(SNR, 0, 'f', 1);
+                m_CanRefineStars = true;
+                qCDebug(KSTARS_EKOS_GUIDE) << QString("StarCorrespondence found star %1 at %2 %3 SNR %4%5")
+                                           .arg(i).arg(star.x, 0, 'f', 1).arg(star.y, 0, 'f', 1).arg(SNR, 0, 'f', 1)
+                                           .arg(refined ? " (incremental)" : "");
 
                 if (guideView != nullptr)
                     plotStars(guideView, trackingBox);
@@ -453,6 +475,41 @@ SSolver::Parameters GuideStars::getStarExtractionParameters(int num)
     return params;
 }
 
+bool GuideStars::refineDetectedStars(const QSharedPointer<FITSData> &imageData, const double maxHFR)
+{
+    if (imageData == nullptr || detectedStars.size() < MIN_STAR_CORRESPONDENCE_SIZE)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QList<Edge> refinedStars;
+    bool guideStarRefined = false;
+    for (int i = 0; i < detectedStars.size(); ++i)
+    {
+        Edge star = detectedStars[i];
+        const int radius = REFINE_SEARCH_MARGIN + static_cast<int>(std::ceil(2 * std::max(0.0f, star.HFR)));
+        if (!GuideAlgorithms::refineStarPosition(imageData, skyBackground, radius, &star) || star.HFR > maxHFR)
+            continue;
+        if (getStarMap(i) >= 0 && getStarMap(i) == starCorrespondence.guideStar())
+            guideStarRefined = true;
+        refinedStars.append(star);
+    }
+
+    if (!guideStarRefined || refinedStars.size() < MIN_REFINED_FRACTION * m_FullDetectionSize)
+    {
+        qCDebug(KSTARS_EKOS_GUIDE) << "Multistar: incremental detection lost stars" << refinedStars.size()
+                                   << "of" << m_FullDetectionSize << (guideStarRefined ? "" : "including the guide star")
+                                   << ", running full detection.";
+        return false;
+    }
+
+    detectedStars = refinedStars;
+    qCDebug(KSTARS_EKOS_GUIDE) << QString("Multistar: incremental detection refined %1 stars in %2s")
+                               .arg(detectedStars.size()).arg(timer.elapsed() / 1000.0, 0, 'f', 3);
+    return true;
+}
+
 // This is the interface to star detection.
 int GuideStars::findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge *> *sepStars, int num)
 {
@@ -123,6 +123,12 @@ private:
                           const QRect *roi = nullptr,
                           QList<double> *outputScores = nullptr,
                           QList<double> *minDistances = nullptr);
+        // Incremental detection: re-measures the stars detected in the previous frame
+        // in small windows around their last positions, instead of running SEP over the full frame.
+        // Stars wider than maxHFR are dropped, as findTopStars() would.
+        // Returns false (and leaves detectedStars untouched) if a full detection is needed.
+        bool refineDetectedStars(const QSharedPointer<FITSData> &imageData, const double maxHFR);
+
         // The interface to the SEP star detection algoritms.
         int findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge*> *sepStars, int num);
 
@@ -187,5 +193,14 @@ private:
 
         int m_NumStarsDetected { 0 };
 
+        // Number of frames processed incrementally since the last full SEP detection.
+        int m_FramesSinceFullDetection { 0 };
+        // Number of stars found by the last full SEP detection. Refined frames are
+        // compared against it, so the star set can't shrink over successive refinements.
+        int m_FullDetectionSize { 0 };
+        // The detected stars are a full-frame detection matched to the references,
+        // so they can be refined incrementally in the next frame.
+        bool m_CanRefineStars { false };
+
         friend class TestGuideStars;
 };
@@ -14,6 +14,7 @@
 #include "auxiliary/kspaths.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsview.h"
+#include "fitsviewer/fitsbufferpool.h"
 #include "guidealgorithms.h"
 #include "ksnotification.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -954,6 +955,14 @@ bool InternalGuider::processGuiding()
     {
         auto const timeStep = calculateGPGTimeStep();
         pmath->performProcessing(state, m_ImageData, m_GuideFrame, timeStep, &guideLog);
+        if (m_ImageData && m_ImageData->bufferPool())
+        {
+            // Once guiding settles these allocation counters should stop increasing.
+            const auto poolStats = m_ImageData->bufferPool()->statistics();
+            qCDebug(KSTARS_EKOS_GUIDE) << QString("Guide buffer pool: buffers %1 allocated %2 reused, stars %3 allocated %4 reused")
+                                       .arg(poolStats.allocations).arg(poolStats.reuses)
+                                       .arg(poolStats.edgeAllocations).arg(poolStats.edgeReuses);
+        }
         if (pmath->usingSEPMultiStar())
         {
             QString info = "";
@@ -0,0 +1,271 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "bayerdemosaic.h"
+
+#include <QFuture>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+
+// Below this many rows per band the thread hand-off costs more than it saves.
+constexpr uint32_t MIN_BAND_ROWS = 64;
+// Bounds the scratch memory of a band, so a 60MP frame does not need a second full frame in flight.
+constexpr uint32_t MAX_BAND_ROWS = 512;
+
+// Rows decoded above and below each band and then thrown away. They must cover the kernel
+// radius plus the border dc1394 paints black, and must be even so every band starts on the
+// same bayer phase as the full frame.
+uint32_t bandMargin(dc1394bayer_method_t method)
+{
+    switch (method)
+    {
+        case DC1394_BAYER_METHOD_NEAREST:
+        case DC1394_BAYER_METHOD_SIMPLE:
+        case DC1394_BAYER_METHOD_BILINEAR:
+            return 2;
+        case DC1394_BAYER_METHOD_HQLINEAR:
+            return 4;
+        case DC1394_BAYER_METHOD_AHD:
+            return 16;
+        default:
+            return 8;
+    }
+}
+
+dc1394error_t decodeRows(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                         const BayerParams &params, uint32_t)
+{
+    return dc1394_bayer_decoding_8bit(bayer, rgb, width, height, params.filter, params.method);
+}
+
+dc1394error_t decodeRows(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                         const BayerParams &params, uint32_t bits)
+{
+    return dc1394_bayer_decoding_16bit(bayer, rgb, width, height, params.filter, params.method, bits);
+}
+
+struct Strides
+{
+    size_t row;
+    size_t plane;
+};
+
+Strides resolveStrides(const BayerDemosaic::Target &target, uint32_t width, uint32_t height)
+{
+    if (target.layout == BayerDemosaic::Target::Interleaved)
+        return { target.rowStride ? target.rowStride : size_t(width) * 3, 0 };
+
+    const size_t row = target.rowStride ? target.rowStride : width;
+    return { row, target.planeStride ? target.planeStride : row * height };
+}
+
+// Copy interleaved rows produced by dc1394 to their final place.
+template <typename T>
+void storeRows(const T *source, uint32_t width, uint32_t firstRow, uint32_t rows, T *rgb,
+               BayerDemosaic::Target::Layout layout, const Strides &strides)
+{
+    const size_t sourceRow = size_t(width) * 3;
+
+    if (layout == BayerDemosaic::Target::Interleaved)
+    {
+        for (uint32_t y = 0; y < rows; y++)
+            memcpy(rgb + (firstRow + y) * strides.row, source + y * sourceRow, sourceRow * sizeof(T));
+        return;
+    }
+
+    for (uint32_t y = 0; y < rows; y++)
+    {
+        const T *in = source + y * sourceRow;
+        T *r = rgb + (firstRow + y) * strides.row;
+        T *g = r + strides.plane;
+        T *b = g + strides.plane;
+        for (uint32_t x = 0; x < width; x++)
+        {
+            r[x] = in[3 * x];
+            g[x] = in[3 * x + 1];
+            b[x] = in[3 * x + 2];
+        }
+    }
+}
+
+// Position of the red and blue pixels inside a 2x2 bayer cell.
+void cellLayout(dc1394color_filter_t filter, int &rx, int &ry, int &bx, int &by)
+{
+    switch (filter)
+    {
+        case DC1394_COLOR_FILTER_BGGR:
+            rx = 1, ry = 1, bx = 0, by = 0;
+            break;
+        case DC1394_COLOR_FILTER_GRBG:
+            rx = 1, ry = 0, bx = 0, by = 1;
+            break;
+        case DC1394_COLOR_FILTER_GBRG:
+            rx = 0, ry = 1, bx = 1, by = 0;
+            break;
+        default:
+            rx = 0, ry = 0, bx = 1, by = 1;
+            break;
+    }
+}
+
+// 2x2 super pixel: one RGB value per bayer cell, replicated to the four pixels of the cell.
+// A trailing odd row or column reuses the last complete cell.
+template <typename T>
+void superPixelRows(const T *bayer, T *rgb, uint32_t width, uint32_t height, uint32_t firstRow, uint32_t lastRow,
+                    dc1394color_filter_t filter, BayerDemosaic::Target::Layout layout, const Strides &strides)
+{
+    int rx, ry, bx, by;
+    cellLayout(filter, rx, ry, bx, by);
+
+    const uint32_t cellsX = width / 2;
+    const uint32_t cellsY = height / 2;
+
+    for (uint32_t y = firstRow; y < lastRow; y++)
+    {
+        const uint32_t cy = std::min(y / 2, cellsY - 1);
+        const T *row[2] = { bayer + size_t(2 * cy) * width, bayer + size_t(2 * cy + 1) * width };
+        const T *red = row[ry] + rx;
+        const T *blue = row[by] + bx;
+        const T *green1 = row[ry] + (1 - rx);
+        const T *green2 = row[by] + (1 - bx);
+
+        if (layout == BayerDemosaic::Target::Interleaved)
+        {
+            T *out = rgb + y * strides.row;
+            for (uint32_t cx = 0; cx < cellsX; cx++)
+            {
+                const T r = red[2 * cx];
+                const T g = static_cast<T>((uint32_t(green1[2 * cx]) + green2[2 * cx] + 1) / 2);
+                const T b = blue[2 * cx];
+                out[6 * cx] = out[6 * cx + 3] = r;
+                out[6 * cx + 1] = out[6 * cx + 4] = g;
+                out[6 * cx + 2] = out[6 * cx + 5] = b;
+            }
+            if (width % 2)
+            {
+                T *last = out + 3 * (width - 1);
+                last[0] = last[-3];
+                last[1] = last[-2];
+                last[2] = last[-1];
+            }
+        }
+        else
+        {
+            T *r = rgb + y * strides.row;
+            T *g = r + strides.plane;
+            T *b = g + strides.plane;
+            for (uint32_t cx = 0; cx < cellsX; cx++)
+            {
+                r[2 * cx] = r[2 * cx + 1] = red[2 * cx];
+                g[2 * cx] = g[2 * cx + 1] = static_cast<T>((uint32_t(green1[2 * cx]) + green2[2 * cx] + 1) / 2);
+                b[2 * cx] = b[2 * cx + 1] = blue[2 * cx];
+            }
+            if (width % 2)
+            {
+                r[width - 1] = r[width - 2];
+                g[width - 1] = g[width - 2];
+                b[width - 1] = b[width - 2];
+            }
+        }
+    }
+}
+
+// Split [0, height) into even sized bands and run them on the global thread pool.
+template <typename Function>
+dc1394error_t runBands(uint32_t height, Function decodeBand)
+{
+    const uint32_t threads = static_cast<uint32_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+    uint32_t rowsPerBand = std::clamp((height + threads - 1) / threads, MIN_BAND_ROWS, MAX_BAND_ROWS);
+    rowsPerBand += rowsPerBand % 2;
+
+    // On a single core the margins would only add work.
+    if (threads == 1 || rowsPerBand >= height)
+        return decodeBand(0, height);
+
+    QVector<QFuture<dc1394error_t>> futures;
+    for (uint32_t first = 0; first < height; first += rowsPerBand)
+    {
+        const uint32_t last = std::min(height, first + rowsPerBand);
+        futures.append(QtConcurrent::run([decodeBand, first, last]()
+        {
+            return decodeBand(first, last);
+        }));
+    }
+
+    dc1394error_t result = DC1394_SUCCESS;
+    for (auto &future : futures)
+    {
+        future.waitForFinished();
+        if (result == DC1394_SUCCESS)
+            result = future.result();
+    }
+    return result;
+}
+
+template <typename T>
+dc1394error_t decodeImpl(const T *bayer, T *rgb, uint32_t width, uint32_t height, const BayerParams &params,
+                         const BayerDemosaic::Target &target, uint32_t bits)
+{
+    if (bayer == nullptr || rgb == nullptr || width < 2 || height < 2)
+        return DC1394_INVALID_ARGUMENT_VALUE;
+    if (params.filter < DC1394_COLOR_FILTER_MIN || params.filter > DC1394_COLOR_FILTER_MAX)
+        return DC1394_INVALID_COLOR_FILTER;
+    if (params.method < DC1394_BAYER_METHOD_MIN || params.method > DC1394_BAYER_METHOD_MAX)
+        return DC1394_INVALID_BAYER_METHOD;
+
+    const Strides strides = resolveStrides(target, width, height);
+    const auto layout = target.layout;
+
+    if (params.method == DC1394_BAYER_METHOD_DOWNSAMPLE)
+    {
+        return runBands(height, [ = ](uint32_t first, uint32_t last)
+        {
+            superPixelRows(bayer, rgb, width, height, first, last, params.filter, layout, strides);
+            return DC1394_SUCCESS;
+        });
+    }
+
+    const uint32_t margin = bandMargin(params.method);
+    return runBands(height, [ = ](uint32_t first, uint32_t last)
+    {
+        const uint32_t inFirst = first > margin ? first - margin : 0;
+        const uint32_t inLast = std::min(height, last + margin);
+        // Left uninitialized, dc1394 writes every element.
+        std::unique_ptr<T[]> scratch(new T[size_t(inLast - inFirst) * width * 3]);
+
+        dc1394error_t rc = decodeRows(bayer + size_t(inFirst) * width, scratch.get(), width, inLast - inFirst, params, bits);
+        if (rc == DC1394_SUCCESS)
+            storeRows(scratch.get() + size_t(first - inFirst) * width * 3, width, first, last - first, rgb, layout, strides);
+        return rc;
+    });
+}
+
+}
+
+namespace BayerDemosaic
+{
+
+dc1394error_t decode(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                     const BayerParams &params, const Target &target)
+{
+    return decodeImpl(bayer, rgb, width, height, params, target, 8);
+}
+
+dc1394error_t decode(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                     const BayerParams &params, const Target &target, uint32_t bits)
+{
+    return decodeImpl(bayer, rgb, width, height, params, target, bits);
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "bayer.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @namespace BayerDemosaic
+ * @brief Multi-threaded front end to the dc1394 bayer decoders.
+ *
+ * dc1394_bayer_decoding_8bit/16bit() run on a single core and always produce interleaved
+ * RGB, which FITSData then had to copy into three planes. Here the frame is split into
+ * bands of rows that are decoded concurrently on the global thread pool. Each band is
+ * decoded with a few extra rows above and below so that the interpolation kernel (and the
+ * black border dc1394 paints around its output) never reaches the rows that are kept. The
+ * kept rows are written straight into the final buffer, either as planes or interleaved,
+ * so no full-frame temporary is needed. The result is identical to a single dc1394 call.
+ *
+ * DC1394_BAYER_METHOD_DOWNSAMPLE is served by a 2x2 super pixel kernel instead: each
+ * bayer cell gives one RGB value (the two greens are averaged) that is written to all
+ * four pixels of the cell. It is the cheapest way to get color and is meant for previews.
+ */
+namespace BayerDemosaic
+{
+
+/**
+ * @brief Where and how the decoded pixels are written. Strides are in elements, not bytes.
+ */
+struct Target
+{
+    enum Layout
+    {
+        /** R plane, then G plane, then B plane, as stored in FITS. */
+        Planar,
+        /** RGBRGB..., as used by QImage::Format_RGB888. */
+        Interleaved
+    };
+
+    Layout layout { Planar };
+    /** Elements between the start of two rows. 0 means tightly packed. */
+    size_t rowStride { 0 };
+    /** Planar only: elements between the start of two planes. 0 means width * height. */
+    size_t planeStride { 0 };
+};
+
+/**
+ * @brief decode Demosaic width x height bayer pixels into rgb.
+ * @param bayer Source pixels, must not overlap rgb.
+ * @param rgb Destination, large enough for the given target.
+ * @param params Filter and method. Offsets are ignored, the caller positions bayer accordingly.
+ * @return DC1394_SUCCESS, or the dc1394 error of the first failing band.
+ */
+dc1394error_t decode(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                     const BayerParams &params, const Target &target = Target());
+
+/**
+ * @brief decode 16bit version.
+ * @param bits Number of significant bits of the source pixels.
+ */
+dc1394error_t decode(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                     const BayerParams &params, const Target &target = Target(), uint32_t bits = 16);
+
+}
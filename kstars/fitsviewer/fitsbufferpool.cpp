@@ -0,0 +1,145 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsbufferpool.h"
+
+#include "fitsstardetector.h"
+
+#include <QMutexLocker>
+
+#include <new>
+
+FITSBufferPool::FITSBufferPool(int maxCachedBuffers, int maxCachedEdges) :
+    m_MaxCachedBuffers(maxCachedBuffers), m_MaxCachedEdges(maxCachedEdges)
+{
+}
+
+FITSBufferPool::~FITSBufferPool()
+{
+    clear();
+    // Anything still outstanding is owned by its user and freed through release().
+}
+
+QSharedPointer<FITSBufferPool> FITSBufferPool::guidePool()
+{
+    static QSharedPointer<FITSBufferPool> pool(new FITSBufferPool());
+    return pool;
+}
+
+uint8_t *FITSBufferPool::acquire(uint32_t size)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    // Most recently released first, it is most likely still in cache.
+    for (int i = m_Free.size() - 1; i >= 0; i--)
+    {
+        if (m_Free[i].size == size)
+        {
+            uint8_t *data = m_Free[i].data;
+            m_Free.remove(i);
+            m_Statistics.cachedBytes -= size;
+            m_Statistics.reuses++;
+            m_Outstanding.insert(data, size);
+            m_Statistics.outstanding = m_Outstanding.size();
+            return data;
+        }
+    }
+
+    // Frame size changed (e.g. binning or subframe). Idle buffers of other sizes are useless now.
+    for (auto &block : m_Free)
+        delete [] block.data;
+    m_Free.clear();
+    m_Statistics.cachedBytes = 0;
+
+    uint8_t *data = new (std::nothrow) uint8_t[size];
+    if (data == nullptr)
+        return nullptr;
+
+    m_Statistics.allocations++;
+    m_Outstanding.insert(data, size);
+    m_Statistics.outstanding = m_Outstanding.size();
+    return data;
+}
+
+void FITSBufferPool::release(uint8_t *buffer)
+{
+    if (buffer == nullptr)
+        return;
+
+    QMutexLocker locker(&m_Mutex);
+
+    auto it = m_Outstanding.find(buffer);
+    if (it == m_Outstanding.end())
+    {
+        // Not ours (e.g. set through FITSData::setImageBuffer()).
+        delete [] buffer;
+        return;
+    }
+
+    const uint32_t size = it.value();
+    m_Outstanding.erase(it);
+    m_Statistics.outstanding = m_Outstanding.size();
+
+    if (m_Free.size() >= m_MaxCachedBuffers)
+    {
+        m_Statistics.cachedBytes -= m_Free.first().size;
+        delete [] m_Free.first().data;
+        m_Free.removeFirst();
+    }
+
+    m_Free.append({buffer, size});
+    m_Statistics.cachedBytes += size;
+}
+
+Edge *FITSBufferPool::acquireEdge()
+{
+    QMutexLocker locker(&m_Mutex);
+
+    if (m_FreeEdges.isEmpty())
+    {
+        m_Statistics.edgeAllocations++;
+        return new Edge();
+    }
+
+    Edge *edge = m_FreeEdges.takeLast();
+    *edge = Edge();
+    m_Statistics.edgeReuses++;
+    return edge;
+}
+
+void FITSBufferPool::releaseEdges(QList<Edge *> &edges)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    for (auto edge : edges)
+    {
+        // Only plain edges can be recycled, subclasses carry extra state.
+        if (m_FreeEdges.size() >= m_MaxCachedEdges || dynamic_cast<BahtinovEdge *>(edge) != nullptr)
+            delete edge;
+        else
+            m_FreeEdges.append(edge);
+    }
+    edges.clear();
+}
+
+FITSBufferPool::Statistics FITSBufferPool::statistics() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Statistics;
+}
+
+void FITSBufferPool::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+
+    for (auto &block : m_Free)
+        delete [] block.data;
+    m_Free.clear();
+    m_Statistics.cachedBytes = 0;
+
+    qDeleteAll(m_FreeEdges);
+    m_FreeEdges.clear();
+}
@@ -0,0 +1,101 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+#include <QList>
+
+#include <cstdint>
+
+class Edge;
+
+/**
+ * @class FITSBufferPool
+ * @brief Recycles image buffers and star detection results between frames of the same size.
+ *
+ * The guide loop receives a new frame every few seconds (or faster) and each one used to
+ * allocate a fresh image buffer plus one Edge per detected star. Over multi-day sessions
+ * this churn fragments the heap. FITSData objects that are given a pool acquire their
+ * image buffer and their star centers from it and hand them back on destruction, so in
+ * steady state no allocation takes place. The counters returned by statistics() can be
+ * logged to verify that.
+ *
+ * Buffers handed to release() that were not acquired from the pool are simply deleted,
+ * so it is always safe to route a FITSData buffer through the pool.
+ *
+ * All methods are thread safe. Star extraction runs in a worker thread while FITSData
+ * objects are destroyed in the GUI thread.
+ */
+class FITSBufferPool
+{
+    public:
+        struct Statistics
+        {
+            /** Number of image buffers allocated from the heap. */
+            quint64 allocations {0};
+            /** Number of image buffers served from the free list. */
+            quint64 reuses {0};
+            /** Number of Edge objects allocated from the heap. */
+            quint64 edgeAllocations {0};
+            /** Number of Edge objects served from the free list. */
+            quint64 edgeReuses {0};
+            /** Number of image buffers currently in use. */
+            int outstanding {0};
+            /** Bytes held in the free list. */
+            quint64 cachedBytes {0};
+        };
+
+        /**
+         * @param maxCachedBuffers Maximum number of idle image buffers kept around.
+         * @param maxCachedEdges Maximum number of idle Edge objects kept around.
+         */
+        explicit FITSBufferPool(int maxCachedBuffers = 4, int maxCachedEdges = 4096);
+        ~FITSBufferPool();
+
+        /** @brief The pool shared by all FITS_GUIDE frames. */
+        static QSharedPointer<FITSBufferPool> guidePool();
+
+        /**
+         * @brief acquire Get a buffer of exactly size bytes. Contents are undefined.
+         * @return buffer or nullptr if allocation failed.
+         */
+        uint8_t *acquire(uint32_t size);
+
+        /** @brief release Return a buffer to the pool. Foreign buffers are deleted. */
+        void release(uint8_t *buffer);
+
+        /** @brief acquireEdge Get a default-initialized Edge. */
+        Edge *acquireEdge();
+
+        /** @brief releaseEdges Take back ownership of the edges and clear the list. */
+        void releaseEdges(QList<Edge *> &edges);
+
+        Statistics statistics() const;
+
+        /** @brief clear Free all idle buffers and edges. Outstanding buffers are unaffected. */
+        void clear();
+
+    private:
+        struct Block
+        {
+            uint8_t *data {nullptr};
+            uint32_t size {0};
+        };
+
+        mutable QMutex m_Mutex;
+        int m_MaxCachedBuffers {4};
+        int m_MaxCachedEdges {4096};
+        // Buffers handed out, and their sizes.
+        QHash<uint8_t *, uint32_t> m_Outstanding;
+        // Idle buffers, most recently released last.
+        QVector<Block> m_Free;
+        QVector<Edge *> m_FreeEdges;
+        Statistics m_Statistics;
+};
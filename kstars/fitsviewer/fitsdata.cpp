@@ -8,6 +8,8 @@
 */
 
 #include "fitsdata.h"
+#include "fitsbufferpool.h"
+#include "bayerdemosaic.h"
 #include "fitsbahtinovdetector.h"
 #include "fitsthresholddetector.h"
 #include "fitsgradientdetector.h"
@@ -26,6 +28,7 @@
 
 #include <KFormat>
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QImage>
 #include <QtConcurrent>
 #include <QImageReader>
@@ -45,6 +48,7 @@
 #include <libxisf.h>
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
@@ -84,6 +88,10 @@ FITSData::FITSData(FITSMode fitsMode): m_Mode(fitsMode)
     debayerParams.filter  = DC1394_COLOR_FILTER_RGGB;
     debayerParams.offsetX = debayerParams.offsetY = 0;
 
+    // Guide frames arrive continuously with the same geometry, so recycle their buffers.
+    if (m_Mode == FITS_GUIDE)
+        m_BufferPool = FITSBufferPool::guidePool();
+
     // Reserve 3 channels
     m_CumulativeFrequency.resize(3);
     m_HistogramBinWidth.resize(3);
@@ -110,7 +118,9 @@ FITSData::FITSData(const QSharedPointer<FITSData> &other)
     this->m_Mode = other->m_Mode;
     this->m_Statistics.channels = other->m_Statistics.channels;
     memcpy(&m_Statistics, &(other->m_Statistics), sizeof(m_Statistics));
-    m_ImageBuffer = new uint8_t[m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel];
+    m_BufferPool = other->m_BufferPool;
+    m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
+    m_ImageBuffer = allocateImageBuffer(m_ImageBufferSize);
     memcpy(m_ImageBuffer, other->m_ImageBuffer,
            m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel);
 
@@ -138,9 +148,7 @@ FITSData::~FITSData()
     }
 #endif
 
-    if (starCenters.count() > 0)
-        qDeleteAll(starCenters);
-    starCenters.clear();
+    clearStarCenters();
 
     if (m_SkyObjects.count() > 0)
         qDeleteAll(m_SkyObjects);
@@ -161,8 +169,7 @@ FITSData::~FITSData()
 void FITSData::loadCommon(const QString &inFilename)
 {
     int status = 0;
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    clearStarCenters();
 
     if (fptr != nullptr)
     {
@@ -172,6 +179,7 @@ void FITSData::loadCommon(const QString &inFilename)
         m_PackBuffer = nullptr;
         fptr = nullptr;
     }
+    m_MemFileBuffer.clear();
 
     m_Filename = inFilename;
 }
@@ -303,8 +311,10 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
     }
     else
     {
-        // Read the FITS file from a memory buffer.
-        void *temp_buffer = const_cast<void *>(reinterpret_cast<const void *>(buffer.data()));
+        // Read the FITS file from a memory buffer. The header and pixels are read in place,
+        // so hold a reference to the (shared, never modified) buffer while fptr is open.
+        m_MemFileBuffer = buffer;
+        void *temp_buffer = const_cast<void *>(reinterpret_cast<const void *>(m_MemFileBuffer.constData()));
         size_t temp_size = buffer.size();
         if (fits_open_memfile(&fptr, m_Filename.toLocal8Bit().data(), READONLY,
                               &temp_buffer, &temp_size, 0, nullptr, &status))
@@ -425,7 +435,7 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
         m_Statistics.channels = 1;
 
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    m_ImageBuffer = allocateImageBuffer(m_ImageBufferSize);
     if (m_ImageBuffer == nullptr)
     {
         qCWarning(KSTARS_FITS) << "FITSData: Not enough memory for image_buffer channel. Requested: "
@@ -560,7 +570,7 @@ bool FITSData::loadXISFImage(const QByteArray &buffer)
         setupWCSParams();
 
         m_ImageBufferSize = image.imageDataSize();
-        m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+        m_ImageBuffer = allocateImageBuffer(m_ImageBufferSize);
         std::memcpy(m_ImageBuffer, image.imageData(), m_ImageBufferSize);
 
         calculateStats(false, false);
@@ -709,7 +719,7 @@ bool FITSData::loadCanonicalImage(const QByteArray &buffer)
     clearImageBuffers();
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * static_cast<uint16_t>
                         (m_Statistics.bytesPerPixel);
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    m_ImageBuffer = allocateImageBuffer(m_ImageBufferSize);
     if (m_ImageBuffer == nullptr)
     {
         m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
@@ -825,7 +835,7 @@ bool FITSData::loadRAWImage(const QByteArray &buffer)
     m_Statistics.samples_per_channel = m_Statistics.width * m_Statistics.height;
     clearImageBuffers();
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    m_ImageBuffer = allocateImageBuffer(m_ImageBufferSize);
     if (m_ImageBuffer == nullptr)
     {
         m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
@@ -1184,9 +1194,48 @@ bool FITSData::saveImage(const QString &newFilename)
     return true;
 }
 
+uint8_t *FITSData::allocateImageBuffer(uint32_t size)
+{
+    if (m_BufferPool)
+        return m_BufferPool->acquire(size);
+    return new uint8_t[size];
+}
+
+void FITSData::releaseImageBuffer(uint8_t *buffer)
+{
+    if (m_BufferPool)
+        m_BufferPool->release(buffer);
+    else
+        delete[] buffer;
+}
+
+Edge *FITSData::createEdge()
+{
+    if (m_BufferPool)
+        return m_BufferPool->acquireEdge();
+    return new Edge();
+}
+
+void FITSData::clearStarCenters()
+{
+    if (m_BufferPool)
+        m_BufferPool->releaseEdges(starCenters);
+    else
+    {
+        qDeleteAll(starCenters);
+        starCenters.clear();
+    }
+}
+
+void FITSData::setStarCenters(const QList<Edge*> &centers)
+{
+    clearStarCenters();
+    starCenters = centers;
+}
+
 void FITSData::clearImageBuffers()
 {
-    delete[] m_ImageBuffer;
+    releaseImageBuffer(m_ImageBuffer);
     m_ImageBuffer = nullptr;
     if(m_ImageRoiBuffer != nullptr )
     {
@@ -2150,8 +2199,7 @@ QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &tracking
         m_StarFindFuture.waitForFinished();
 
     starAlgorithm = algorithm;
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    clearStarCenters();
     starsSearched = true;
 
     switch (algorithm)
@@ -3957,7 +4005,7 @@ bool FITSData::rotFITS(int rotate, int mirror)
         }
     }
 
-    delete[] m_ImageBuffer;
+    releaseImageBuffer(m_ImageBuffer);
     m_ImageBuffer = rotimage;
 
     return true;
@@ -4258,7 +4306,7 @@ uint8_t const * FITSData::getImageBuffer() const
 
 void FITSData::setImageBuffer(uint8_t * buffer)
 {
-    delete[] m_ImageBuffer;
+    releaseImageBuffer(m_ImageBuffer);
     m_ImageBuffer = buffer;
 }
 
@@ -4391,36 +4439,31 @@ bool FITSData::debayer(bool reload)
     }
 }
 
-bool FITSData::debayer_8bit()
+template <typename T>
+bool FITSData::debayer()
 {
-    dc1394error_t error_code;
-
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t * destinationBuffer = nullptr;
+    const uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
 
+    // Decode into a fresh buffer: on reload the bayer data lives in the first plane of the current one.
+    uint8_t *destinationBuffer = nullptr;
     try
     {
-        destinationBuffer = new uint8_t[rgb_size];
+        destinationBuffer = allocateImageBuffer(rgb_size);
     }
-    catch (const std::bad_alloc &e)
+    catch (const std::bad_alloc &)
     {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-        return false;
+        destinationBuffer = nullptr;
     }
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint8_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
+    if (destinationBuffer == nullptr)
     {
         logOOMError(rgb_size);
         m_LastError = i18n("Unable to allocate memory for temporary bayer buffer.");
         return false;
     }
 
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
+    const T *dc1394_source = reinterpret_cast<const T *>(m_ImageBuffer);
+    uint32_t ds1394_height = m_Statistics.height;
 
     if (debayerParams.offsetY == 1)
     {
@@ -4429,148 +4472,57 @@ bool FITSData::debayer_8bit()
     }
     // offsetX == 1 is handled in checkDebayer() and should be 0 here.
 
-    error_code = dc1394_bayer_decoding_8bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                                            debayerParams.filter,
-                                            debayerParams.method);
+    // Planes stay width * height apart even when the first row is skipped above.
+    BayerDemosaic::Target target;
+    target.layout = BayerDemosaic::Target::Planar;
+    target.planeStride = m_Statistics.samples_per_channel;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto rgbBuffer = reinterpret_cast<T *>(destinationBuffer);
+    dc1394error_t error_code = BayerDemosaic::decode(dc1394_source, rgbBuffer, m_Statistics.width, ds1394_height,
+                               debayerParams, target);
 
     if (error_code != DC1394_SUCCESS)
     {
         m_LastError = i18n("Debayer failed (%1)", error_code);
         m_Statistics.channels = 1;
-        delete[] destinationBuffer;
+        releaseImageBuffer(destinationBuffer);
         return false;
     }
 
-    if (m_ImageBufferSize != rgb_size)
+    if (ds1394_height < static_cast<uint32_t>(m_Statistics.height))
     {
-        delete[] m_ImageBuffer;
-        try
-        {
-            m_ImageBuffer = new uint8_t[rgb_size];
-        }
-        catch (const std::bad_alloc &e)
-        {
-            delete[] destinationBuffer;
-            logOOMError(rgb_size);
-            m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
+        // The skipped row leaves the last row of each plane undecoded.
+        for (int channel = 0; channel < 3; channel++)
+            std::fill_n(rgbBuffer + channel * m_Statistics.samples_per_channel + ds1394_height * m_Statistics.width,
+                        m_Statistics.width, T(0));
     }
 
-    auto bayered_buffer = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
+    qCDebug(KSTARS_FITS) << "Debayered" << m_Statistics.width << "x" << m_Statistics.height << "method"
+                         << debayerParams.method << "in" << timer.elapsed() << "ms";
 
-    uint8_t * rBuff = bayered_buffer;
-    uint8_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint8_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
-
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    releaseImageBuffer(m_ImageBuffer);
+    m_ImageBuffer = destinationBuffer;
+    m_ImageBufferSize = rgb_size;
 
     // TODO Maybe all should be treated the same
     // Doing single channel saves lots of memory though for non-essential
     // frames
     m_Statistics.channels = (m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE) ? 3 : 1;
-    m_Statistics.dataType = TBYTE;
-    delete[] destinationBuffer;
+    m_Statistics.dataType = (sizeof(T) == 1) ? TBYTE : TUSHORT;
     return true;
 }
 
-bool FITSData::debayer_16bit()
+bool FITSData::debayer_8bit()
 {
-    dc1394error_t error_code;
-
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t *destinationBuffer = nullptr;
-    try
-    {
-        destinationBuffer = new uint8_t[rgb_size];
-    }
-    catch (const std::bad_alloc &e)
-    {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-        return false;
-    }
-
-    auto * bayer_source_buffer      = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint16_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
-    {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer.");
-        return false;
-    }
-
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
-
-    if (debayerParams.offsetY == 1)
-    {
-        dc1394_source += m_Statistics.width;
-        ds1394_height--;
-    }
-    // offsetX == 1 is handled in checkDebayer() and should be 0 here.
-
-    error_code = dc1394_bayer_decoding_16bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                 debayerParams.filter,
-                 debayerParams.method, 16);
-
-    if (error_code != DC1394_SUCCESS)
-    {
-        m_LastError = i18n("Debayer failed (%1)");
-        m_Statistics.channels = 1;
-        delete[] destinationBuffer;
-        return false;
-    }
-
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
-        try
-        {
-            m_ImageBuffer = new uint8_t[rgb_size];
-        }
-        catch (const std::bad_alloc &e)
-        {
-            logOOMError(rgb_size);
-            delete[] destinationBuffer;
-            m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
-    }
-
-    auto bayered_buffer = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint16_t * rBuff = bayered_buffer;
-    uint16_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint16_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
-
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    return debayer<uint8_t>();
+}
 
-    m_Statistics.channels = (m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE) ? 3 : 1;
-    m_Statistics.dataType = TUSHORT;
-    delete[] destinationBuffer;
-    return true;
+bool FITSData::debayer_16bit()
+{
+    return debayer<uint16_t>();
 }
 
 void FITSData::logOOMError(uint32_t requiredMemory)
@@ -53,6 +53,7 @@ class QProgressDialog;
 
 class SkyPoint;
 class FITSHistogramData;
+class FITSBufferPool;
 class Edge;
 
 class FITSData : public QObject
@@ -138,6 +139,19 @@ class FITSData : public QObject
         uint8_t const *getImageBuffer() const;
         uint8_t *getWritableImageBuffer();
 
+        /**
+         * @brief setBufferPool Use the given pool for the image buffer and star centers of this image.
+         * FITS_GUIDE images use FITSBufferPool::guidePool() by default. Must be set before loading.
+         */
+        void setBufferPool(const QSharedPointer<FITSBufferPool> &pool)
+        {
+            m_BufferPool = pool;
+        }
+        const QSharedPointer<FITSBufferPool> &bufferPool() const
+        {
+            return m_BufferPool;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////////////////////////////////////////////////////////////
         /// Statistics Functions.
@@ -298,11 +312,12 @@ class FITSData : public QObject
         }
         QList<Edge *> getStarCentersInSubFrame(QRect subFrame) const;
 
-        void setStarCenters(const QList<Edge*> &centers)
-        {
-            qDeleteAll(starCenters);
-            starCenters = centers;
-        }
+        void setStarCenters(const QList<Edge*> &centers);
+        /**
+         * @brief createEdge Allocate a star center for this image. Detectors should use this instead of new
+         * so that the centers are recycled when a buffer pool is set.
+         */
+        Edge *createEdge();
         QFuture<bool> findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &trackingBox = QRect());
 
         void setSkyBackground(const SkyBackground &bg)
@@ -712,6 +727,10 @@ class FITSData : public QObject
         bool loadRAWImage(const QByteArray &buffer);
 
         void rotWCSFITS(int angle, int mirror);
+        // Image buffer and star center (de)allocation, through m_BufferPool if set.
+        uint8_t *allocateImageBuffer(uint32_t size);
+        void releaseImageBuffer(uint8_t *buffer);
+        void clearStarCenters();
         void calculateMinMax(bool refresh = false, bool roi = false);
         void calculateMedian(bool refresh = false, bool roi = false);
         bool checkDebayer();
@@ -838,6 +857,8 @@ class FITSData : public QObject
         uint8_t *m_ImageBuffer { nullptr };
         /// Above buffer size in bytes
         uint32_t m_ImageBufferSize { 0 };
+        /// Optional pool recycling image buffers and star centers between frames
+        QSharedPointer<FITSBufferPool> m_BufferPool;
         /// Image Buffer if Selection is to be done
         uint8_t *m_ImageRoiBuffer { nullptr };
         /// Above buffer size in bytes
@@ -856,6 +877,8 @@ class FITSData : public QObject
         bool HasDebayer { false };
         /// Buffer to hold fpack uncompressed data
         uint8_t *m_PackBuffer {nullptr};
+        /// Frame an in-memory fptr reads from, shared with the caller of loadFromBuffer()
+        QByteArray m_MemFileBuffer;
 
         /// Our very own file name
         QString m_Filename, m_compressedFilename, m_Extension;
@@ -18,6 +18,8 @@
 
 #include <memory>
 #include <math.h>
+#include <QElapsedTimer>
+#include <QThreadPool>
 #include <QPointer>
 #include <QtConcurrent>
 
@@ -62,22 +64,41 @@ QFuture<bool> FITSSEPDetector::findSources(QRect const &boundary)
 #endif
 }
 
-bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
+#ifdef HAVE_STELLARSOLVER
+namespace
 {
-#ifndef HAVE_STELLARSOLVER
-    Q_UNUSED(boundary)
-    return false;
-#else
-    QList<Edge*> starCenters;
-    SkyBackground skyBG;
-    int maxStarsCount = getValue("maxStarsCount", 100000).toInt();
+// Images smaller than this are extracted in one piece, splitting them doesn't pay off.
+constexpr int64_t MIN_TILED_EXTRACTION_PIXELS = 16000000;
+// Tiles overlap by this many pixels so that stars on a tile border are fully inside one of them.
+constexpr int TILE_OVERLAP = 32;
+// Detections closer than this on both sides of a tile border are the same star.
+constexpr double DUPLICATE_STAR_DISTANCE = 2.0;
+
+struct TileExtraction
+{
+    QRect core;
+    QRect frame;
+    QList<FITSImage::Star> stars;
+    FITSImage::Background background {};
+};
 
+bool insideRect(const QRect &rect, float x, float y)
+{
+    return x >= rect.x() && x < rect.x() + rect.width() && y >= rect.y() && y < rect.y() + rect.height();
+}
+
+double distanceToBorder(const QRect &rect, float x, float y)
+{
+    return std::min(std::min(x - rect.x(), rect.x() + rect.width() - x),
+                    std::min(y - rect.y(), rect.y() + rect.height() - y));
+}
+}
+
+SSolver::Parameters FITSSEPDetector::getParameters() const
+{
     int optionsProfileIndex = getValue("optionsProfileIndex", -1).toInt();
     Ekos::ProfileGroup group = static_cast<Ekos::ProfileGroup>(getValue("optionsProfileGroup", 1).toInt());
-    QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(m_ImageData->getStatistics(),
-            m_ImageData->getImageBuffer()));
     QString filename = "";
-    QPointer<FITSData> image(m_ImageData);
     switch(group)
     {
         case Ekos::AlignProfiles:
@@ -120,35 +141,61 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
     {
         auto params = optionsList[optionsProfileIndex];
         params.partition = Options::stellarSolverPartition();
-        solver->setParameters(params);
         qCDebug(KSTARS_FITS) << "Sextract with: " << optionsList[optionsProfileIndex].listName;
+        return params;
     }
-    else
-    {
-        auto params = SSolver::Parameters();  // This is default
-        params.partition = Options::stellarSolverPartition();
-        solver->setParameters(params);
-    }
+
+    auto params = SSolver::Parameters();  // This is default
+    params.partition = Options::stellarSolverPartition();
+    return params;
+}
+#endif
+
+bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
+{
+#ifndef HAVE_STELLARSOLVER
+    Q_UNUSED(boundary)
+    return false;
+#else
+    QList<Edge*> starCenters;
+    SkyBackground skyBG;
+    int maxStarsCount = getValue("maxStarsCount", 100000).toInt();
+
+    Ekos::ProfileGroup group = static_cast<Ekos::ProfileGroup>(getValue("optionsProfileGroup", 1).toInt());
+    QPointer<FITSData> image(m_ImageData);
+    const SSolver::Parameters params = getParameters();
 
     QList<FITSImage::Star> stars;
+    FITSImage::Background bg;
     const bool runHFR = group != Ekos::AlignProfiles;
 
-    solver->setLogLevel(SSolver::LOG_NONE);
-    solver->setSSLogLevel(SSolver::LOG_OFF);
-
-    if (boundary.isValid())
-        solver->extract(runHFR, boundary);
+    const QRect region = boundary.isValid() ? boundary : QRect(0, 0, m_ImageData->width(), m_ImageData->height());
+    if (Options::sEPTiledExtraction() && static_cast<int64_t>(region.width()) * region.height() >= MIN_TILED_EXTRACTION_PIXELS)
+    {
+        if (!extractTiled(params, runHFR, region, &stars, &bg))
+            return false;
+    }
     else
-        solver->extract(runHFR);
+    {
+        QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(m_ImageData->getStatistics(),
+                m_ImageData->getImageBuffer()));
+        solver->setParameters(params);
+        solver->setLogLevel(SSolver::LOG_NONE);
+        solver->setSSLogLevel(SSolver::LOG_OFF);
 
-    stars = solver->getStarList();
+        if (boundary.isValid())
+            solver->extract(runHFR, boundary);
+        else
+            solver->extract(runHFR);
+
+        stars = solver->getStarList();
+        bg = solver->getBackground();
+    }
 
     // If m_ImageData goes out of scope, also return.
     if (stars.empty() || image.isNull())
         return false;
 
-    auto bg = solver->getBackground();
-
     skyBG.mean = bg.global;
     skyBG.sigma = bg.globalrms;
     skyBG.numPixelsInSkyEstimate = bg.bw * bg.bh;
@@ -171,7 +218,7 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
     starCenters.reserve(starCount);
     for (int i = 0; i < starCount; i++)
     {
-        Edge *oneEdge = new Edge();
+        Edge *oneEdge = m_ImageData->createEdge();
         oneEdge->x = stars[i].x;
         oneEdge->y = stars[i].y;
         oneEdge->val = stars[i].peak;
@@ -193,6 +240,138 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
 #endif
 }
 
+#ifdef HAVE_STELLARSOLVER
+bool FITSSEPDetector::extractTiled(const SSolver::Parameters &params, bool runHFR, const QRect &region,
+                                   QList<FITSImage::Star> *stars, FITSImage::Background *background)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // One tile per thread, laid out as close to a square grid as possible.
+    const int numThreads = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(numThreads)))));
+    const int rows = std::max(1, (numThreads + columns - 1) / columns);
+
+    // Each tile extracts in its own thread. The percentage filters must see all the stars
+    // of the image, so they are applied after merging.
+    SSolver::Parameters tileParams = params;
+    tileParams.partition = false;
+    tileParams.removeBrightest = 0;
+    tileParams.removeDimmest = 0;
+
+    QVector<TileExtraction> tiles;
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < columns; c++)
+        {
+            TileExtraction tile;
+            const int x0 = region.x() + c * region.width() / columns;
+            const int x1 = region.x() + (c + 1) * region.width() / columns;
+            const int y0 = region.y() + r * region.height() / rows;
+            const int y1 = region.y() + (r + 1) * region.height() / rows;
+            tile.core = QRect(x0, y0, x1 - x0, y1 - y0);
+            tile.frame = tile.core.adjusted(-TILE_OVERLAP, -TILE_OVERLAP, TILE_OVERLAP, TILE_OVERLAP).intersected(region);
+            tiles.append(tile);
+        }
+    }
+
+    QPointer<FITSData> image(m_ImageData);
+    const FITSImage::Statistic stats = m_ImageData->getStatistics();
+    uint8_t const *buffer = m_ImageData->getImageBuffer();
+
+    QVector<QFuture<void>> futures;
+    for (int i = 0; i < tiles.size(); i++)
+    {
+        TileExtraction *tile = &tiles[i];
+        futures.append(QtConcurrent::run([ = ]()
+        {
+            QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(stats, buffer));
+            solver->setParameters(tileParams);
+            solver->setLogLevel(SSolver::LOG_NONE);
+            solver->setSSLogLevel(SSolver::LOG_OFF);
+            solver->extract(runHFR, tile->frame);
+            tile->stars = solver->getStarList();
+            tile->background = solver->getBackground();
+        }));
+    }
+
+    for (QFuture<void> future : futures)
+        future.waitForFinished();
+
+    if (image.isNull())
+        return false;
+
+    // Merge. A star belongs to the tile whose core contains its center, which drops the copies
+    // found in the overlap of neighbouring tiles. Stars right on a core border may have been
+    // measured on both sides of it, those are de-duplicated below.
+    double bgSum = 0, bgSquaredSum = 0, totalArea = 0, detected = 0;
+    QVector<int> borderStars;
+    stars->clear();
+    for (const auto &tile : tiles)
+    {
+        const double area = static_cast<double>(tile.core.width()) * tile.core.height();
+        const double frameArea = static_cast<double>(tile.frame.width()) * tile.frame.height();
+        bgSum += area * tile.background.global;
+        bgSquaredSum += area * tile.background.globalrms * tile.background.globalrms;
+        totalArea += area;
+        // Detections in the overlap are counted by both neighbours.
+        if (frameArea > 0)
+            detected += tile.background.num_stars_detected * area / frameArea;
+
+        for (const auto &star : tile.stars)
+        {
+            if (!insideRect(tile.core, star.x, star.y))
+                continue;
+            if (distanceToBorder(tile.core, star.x, star.y) < DUPLICATE_STAR_DISTANCE)
+                borderStars.append(stars->size());
+            stars->append(star);
+        }
+    }
+
+    QVector<bool> duplicate(stars->size(), false);
+    for (int i = 0; i < borderStars.size(); i++)
+    {
+        for (int j = i + 1; j < borderStars.size(); j++)
+        {
+            const auto &a = stars->at(borderStars[i]);
+            const auto &b = stars->at(borderStars[j]);
+            if (std::hypot(a.x - b.x, a.y - b.y) < DUPLICATE_STAR_DISTANCE)
+                duplicate[a.flux < b.flux ? borderStars[i] : borderStars[j]] = true;
+        }
+    }
+    for (int i = stars->size() - 1; i >= 0; i--)
+    {
+        if (duplicate[i])
+            stars->removeAt(i);
+    }
+
+    // Apply the profile's percentage and count filters on the merged list, brightest first.
+    std::sort(stars->begin(), stars->end(), [](const FITSImage::Star & star1, const FITSImage::Star & star2)
+    {
+        return star1.flux > star2.flux;
+    });
+    if (params.removeBrightest > 0 || params.removeDimmest > 0)
+    {
+        const int numStars = stars->size();
+        const int numBrightest = static_cast<int>(numStars * params.removeBrightest / 100.0);
+        const int numDimmest = static_cast<int>(numStars * params.removeDimmest / 100.0);
+        *stars = stars->mid(numBrightest, std::max(0, numStars - numBrightest - numDimmest));
+    }
+    if (params.keepNum > 0 && stars->size() > params.keepNum)
+        *stars = stars->mid(0, params.keepNum);
+
+    background->bw = tiles.first().background.bw;
+    background->bh = tiles.first().background.bh;
+    background->global = totalArea > 0 ? bgSum / totalArea : 0;
+    background->globalrms = totalArea > 0 ? std::sqrt(bgSquaredSum / totalArea) : 0;
+    background->num_stars_detected = static_cast<int>(detected);
+
+    qCDebug(KSTARS_FITS) << QString("Tiled extraction: %1 tiles, %2 stars in %3s")
+                         .arg(tiles.size()).arg(stars->size()).arg(timer.elapsed() / 1000.0, 0, 'f', 3);
+    return true;
+}
+#endif
+
 template <typename T>
 void FITSSEPDetector::getFloatBuffer(float * buffer, int x, int y, int w, int h, FITSData const *data) const
 {
@@ -10,9 +10,15 @@
 
 #pragma once
 
+#include "config-kstars.h"
 #include "fitsstardetector.h"
 #include "skybackground.h"
 
+#ifdef HAVE_STELLARSOLVER
+#include <structuredefinitions.h>
+#include <parameters.h>
+#endif
+
 class FITSSEPDetector : public FITSStarDetector
 {
         Q_OBJECT
@@ -39,6 +45,19 @@ class FITSSEPDetector : public FITSStarDetector
         void getFloatBuffer(float * buffer, int x, int y, int w, int h, FITSData const * image_data) const;
 
     private:
+#ifdef HAVE_STELLARSOLVER
+        /** @internal Extraction parameters from the configured StellarSolver profile. */
+        SSolver::Parameters getParameters() const;
+
+        /** @internal Extract the region as overlapping tiles processed in parallel, then merge the results.
+         * @param params is the extraction profile, its percentage and count filters are applied to the merged list.
+         * @param stars receives the merged, de-duplicated star list.
+         * @param background receives the background statistics combined over all tiles.
+         * @return false if the image went away during extraction.
+         */
+        bool extractTiled(const SSolver::Parameters &params, bool runHFR, const QRect &region,
+                          QList<FITSImage::Star> *stars, FITSImage::Background *background);
+#endif
 
         void clearSolver();
 
@@ -0,0 +1,260 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitswritequeue.h"
+
+#include <fitsio.h>
+#include "fpack.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <fits_debug.h>
+
+namespace
+{
+
+bool syncFile(int fd, FITSWriteQueue::SyncPolicy sync)
+{
+    if (sync == FITSWriteQueue::SYNC_NONE)
+        return true;
+#if defined(Q_OS_WIN)
+    return _commit(fd) == 0;
+#elif defined(Q_OS_LINUX)
+    return ::fdatasync(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+// A new file is only durable once the directory entry pointing to it is.
+bool syncDirectory(const QString &filename, FITSWriteQueue::SyncPolicy sync)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(filename)
+    Q_UNUSED(sync)
+    return true;
+#else
+    if (sync != FITSWriteQueue::SYNC_FULL)
+        return true;
+
+    const int fd = ::open(QFile::encodeName(QFileInfo(filename).absolutePath()).constData(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+void setPermissions(const QString &filename)
+{
+    QFile::setPermissions(filename, QFileDevice::ReadUser | QFileDevice::WriteUser | QFileDevice::ReadGroup |
+                          QFileDevice::ReadOther);
+}
+
+}
+
+FITSWriteQueue::FITSWriteQueue(QObject *parent) : QObject(parent)
+{
+    m_Pool.setMaxThreadCount(m_Settings.maxParallelWrites);
+}
+
+FITSWriteQueue::~FITSWriteQueue()
+{
+    waitForFinished();
+}
+
+void FITSWriteQueue::setSettings(const Settings &settings)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Settings = settings;
+    m_Settings.maxParallelWrites = std::max(1, settings.maxParallelWrites);
+    m_Pool.setMaxThreadCount(m_Settings.maxParallelWrites);
+}
+
+FITSWriteQueue::Settings FITSWriteQueue::settings() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Settings;
+}
+
+QString FITSWriteQueue::enqueue(const QString &filename, const QByteArray &buffer, bool isFITS)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    // A single frame larger than the bound is still accepted once everything else is written.
+    while (m_Pending > 0 && m_QueuedBytes + buffer.size() > m_Settings.maxQueuedBytes)
+        m_Drained.wait(&m_Mutex);
+
+    const bool compress = isFITS && m_Settings.compress;
+    const SyncPolicy sync = m_Settings.sync;
+    const QString target = compress && !filename.endsWith(".fz") ? filename + ".fz" : filename;
+
+    m_QueuedBytes += buffer.size();
+    m_Pending++;
+    locker.unlock();
+
+    QtConcurrent::run(&m_Pool, [this, target, buffer, compress, sync]()
+    {
+        write(target, buffer, compress, sync);
+    });
+
+    return target;
+}
+
+void FITSWriteQueue::write(const QString &filename, const QByteArray &buffer, bool compress, SyncPolicy sync)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool ok = compress ? compressFile(filename, buffer, sync) : writeFile(filename, buffer, sync);
+
+    if (ok)
+        emit written(filename, buffer.size(), timer.elapsed());
+    else
+    {
+        qCCritical(KSTARS_FITS) << "Failed to write" << filename;
+        emit writeFailed(filename);
+    }
+
+    QMutexLocker locker(&m_Mutex);
+    m_QueuedBytes -= buffer.size();
+    m_Pending--;
+    m_Drained.wakeAll();
+}
+
+void FITSWriteQueue::waitForFinished()
+{
+    QMutexLocker locker(&m_Mutex);
+    while (m_Pending > 0)
+        m_Drained.wait(&m_Mutex);
+}
+
+qint64 FITSWriteQueue::queuedBytes() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_QueuedBytes;
+}
+
+bool FITSWriteQueue::writeFile(const QString &filename, const QByteArray &buffer, SyncPolicy sync)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCCritical(KSTARS_FITS) << "Unable to open" << filename << "for writing:" << file.errorString();
+        return false;
+    }
+
+    const char *data = buffer.constData();
+    const qint64 size = buffer.size();
+    bool ok = true;
+    for (qint64 nr = 0, n = 0; nr < size; nr += n)
+    {
+        n = file.write(data + nr, size - nr);
+        if (n < 0)
+        {
+            ok = false;
+            break;
+        }
+    }
+    ok = file.flush() && ok;
+    ok = syncFile(file.handle(), sync) && ok;
+    file.close();
+
+    setPermissions(filename);
+    return syncDirectory(filename, sync) && ok;
+}
+
+bool FITSWriteQueue::compressFile(const QString &filename, const QByteArray &buffer, SyncPolicy sync)
+{
+    fitsfile *in = nullptr, *out = nullptr;
+    int status = 0;
+
+    void *memory = const_cast<char *>(buffer.constData());
+    size_t memorySize = buffer.size();
+    if (fits_open_memfile(&in, "frame", READONLY, &memory, &memorySize, 0, nullptr, &status))
+    {
+        char message[FLEN_STATUS];
+        fits_get_errstatus(status, message);
+        qCCritical(KSTARS_FITS) << "Unable to read frame for" << filename << ":" << message;
+        return false;
+    }
+
+    // Default fpack parameters: Rice, one row per tile. With them fp_pack_hdu() only calls
+    // into cfitsio and never touches the global state of fpack, so it is safe in any thread.
+    fpstate fpvar;
+    fp_init(&fpvar);
+    fpvar.do_checksums = 0;
+
+    // Quantizing floating point pixels is lossy, use lossless GZIP for them instead.
+    int bitpix = 0;
+    fits_get_img_type(in, &bitpix, &status);
+    if (bitpix < 0)
+    {
+        fpvar.comptype = GZIP_2;
+        fpvar.quantize_level = 0;
+    }
+
+    // The leading ! overwrites an existing file.
+    const QByteArray target = QFile::encodeName("!" + filename);
+    fits_create_file(&out, target.constData(), &status);
+
+    int lossless = 1;
+    while (status == 0)
+    {
+        fits_set_compression_type(out, fpvar.comptype, &status);
+        fits_set_tile_dim(out, 6, fpvar.ntile, &status);
+        fits_set_quantize_level(out, fpvar.quantize_level, &status);
+        fp_pack_hdu(in, out, fpvar, &lossless, &status);
+        fits_movrel_hdu(in, 1, nullptr, &status);
+    }
+    if (status == END_OF_FILE)
+        status = 0;
+
+    if (status)
+    {
+        char message[FLEN_STATUS];
+        fits_get_errstatus(status, message);
+        qCCritical(KSTARS_FITS) << "Unable to compress" << filename << ":" << message;
+    }
+
+    int closeStatus = 0;
+    fits_close_file(in, &closeStatus);
+    closeStatus = 0;
+    if (out)
+    {
+        if (status)
+            fits_delete_file(out, &closeStatus);
+        else
+            fits_close_file(out, &status);
+    }
+
+    if (status)
+        return false;
+
+    bool ok = true;
+    if (sync != SYNC_NONE)
+    {
+        QFile file(filename);
+        ok = file.open(QIODevice::ReadOnly) && syncFile(file.handle(), sync);
+    }
+
+    setPermissions(filename);
+    return syncDirectory(filename, sync) && ok;
+}
@@ -0,0 +1,111 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+/**
+ * @class FITSWriteQueue
+ * @brief Write-behind queue for captured frames.
+ *
+ * A camera hands each received frame to enqueue() and returns to capturing at once.
+ * Up to maxParallelWrites frames are written at the same time, on a thread pool of
+ * their own so that long disk stalls never starve the global pool used for loading
+ * and analysing frames. The frames waiting to be written are bounded by
+ * maxQueuedBytes. Once the bound is reached enqueue() blocks until enough writes
+ * have finished, so a disk that cannot keep up slows capture down rather than
+ * exhausting memory.
+ *
+ * FITS frames can optionally be tile compressed with fpack (Rice for integer
+ * images, lossless GZIP for floating point ones). The compression runs in the
+ * writer threads, so several frames are compressed concurrently.
+ *
+ * Frames are implicitly shared QByteArrays. The queue keeps its own reference
+ * until the write is done, so the caller is free to move on to the next frame.
+ */
+class FITSWriteQueue : public QObject
+{
+        Q_OBJECT
+
+    public:
+        typedef enum
+        {
+            /** Leave flushing to the operating system. */
+            SYNC_NONE,
+            /** Flush the file contents to disk before the write is reported done. */
+            SYNC_DATA,
+            /** As SYNC_DATA, and also flush the directory so the new entry survives a power cut. */
+            SYNC_FULL
+        } SyncPolicy;
+
+        struct Settings
+        {
+            /** Bytes of frames that may be waiting to be written. */
+            qint64 maxQueuedBytes { 1024 * 1024 * 1024LL };
+            /** Frames written at the same time. */
+            int maxParallelWrites { 3 };
+            SyncPolicy sync { SYNC_NONE };
+            /** Tile compress FITS frames, a .fz suffix is added to their filename. */
+            bool compress { false };
+        };
+
+        explicit FITSWriteQueue(QObject *parent = nullptr);
+        /** @brief Waits for all queued frames to be written. */
+        ~FITSWriteQueue() override;
+
+        void setSettings(const Settings &settings);
+        Settings settings() const;
+
+        /**
+         * @brief enqueue Queue a frame for writing. Blocks while the queue is full.
+         * @param filename Destination. Any existing file is overwritten.
+         * @param buffer Frame contents.
+         * @param isFITS Only FITS frames are compressed.
+         * @return The name the frame will be written to, including the .fz suffix when compressed.
+         * Failures are reported later through writeFailed().
+         */
+        QString enqueue(const QString &filename, const QByteArray &buffer, bool isFITS = true);
+
+        /** @brief waitForFinished Block until all queued frames are written. */
+        void waitForFinished();
+
+        /** @brief queuedBytes Bytes of frames not yet written. */
+        qint64 queuedBytes() const;
+
+        /**
+         * @brief writeFile Write buffer to filename as is.
+         * @return true on success.
+         */
+        static bool writeFile(const QString &filename, const QByteArray &buffer, SyncPolicy sync = SYNC_NONE);
+
+        /**
+         * @brief compressFile Write the FITS file in buffer to filename with all image HDUs tile compressed.
+         * @return true on success.
+         */
+        static bool compressFile(const QString &filename, const QByteArray &buffer, SyncPolicy sync = SYNC_NONE);
+
+    signals:
+        /** @brief Emitted from a writer thread once a frame is on disk. */
+        void written(const QString &filename, qint64 bytes, qint64 milliseconds);
+        /** @brief Emitted from a writer thread if a frame could not be written. */
+        void writeFailed(const QString &filename);
+
+    private:
+        void write(const QString &filename, const QByteArray &buffer, bool compress, SyncPolicy sync);
+
+        mutable QMutex m_Mutex;
+        QWaitCondition m_Drained;
+        QThreadPool m_Pool;
+        Settings m_Settings;
+        qint64 m_QueuedBytes { 0 };
+        int m_Pending { 0 };
+};
@@ -384,6 +384,7 @@ void HIPSManager::removeTimer(pixCacheKey_t &key)
 {
     m_downloadMap.remove(key);
     sender()->deleteLater();
+    m_tileGeneration++;
     emit sigRepaint();
 }
 
@@ -400,6 +401,7 @@ void HIPSManager::addToMemoryCache(pixCacheKey_t &key, pixCacheItem_t *item)
     int cost = item->image->sizeInBytes();
 
     m_cache.add(key, item, cost);
+    m_tileGeneration++;
 }
 
 pixCacheItem_t *HIPSManager::getCacheItem(pixCacheKey_t &key)
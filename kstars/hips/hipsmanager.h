@@ -95,6 +95,11 @@ class HIPSManager : public QObject
         {
             return m_uid;
         }
+        /** Changes whenever a tile was loaded or a failed tile may be requested again. */
+        quint64 getTileGeneration() const
+        {
+            return m_tileGeneration;
+        }
         void setOfflineLevels(const QStringList &value);
 
     public slots:
@@ -133,6 +138,7 @@ class HIPSManager : public QObject
 
         // Handy shortcuts
         qint64 m_uid { 0 };
+        quint64 m_tileGeneration { 0 };
         QString m_currentFormat;
         HIPSFrame m_currentFrame { HIPS_OTHER_FRAME };
         uint8_t m_currentOrder { 0 };
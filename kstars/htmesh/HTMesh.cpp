@@ -1,3 +1,4 @@
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 
@@ -100,16 +101,158 @@ bool HTMesh::performIntersection(RangeConvex *convex, BufNum bufNum)
     return true;
 }
 
+/******************************************************************************
+ * The circle is by far the most common intersection, every draw covers the
+ * visible sky with one.  Going through RangeConvex for it allocates a SkipList
+ * and an HtmRange on every call, so the circle walks the trixel tree itself:
+ * each trixel is rejected, taken in full with all its children, or split
+ * further until the mesh level is reached.  Nothing is allocated, the result
+ * goes straight into the buffer in the same ascending order as before.
+ *****************************************************************************/
+
+namespace
+{
+// SpatialVector also carries ra and dec around, a plain vector is enough here.
+struct Vec
+{
+    double x, y, z;
+};
+
+inline double dot(const Vec &a, const Vec &b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Vec cross(const Vec &a, const Vec &b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+inline Vec midPoint(const Vec &a, const Vec &b)
+{
+    Vec m        = { a.x + b.x, a.y + b.y, a.z + b.z };
+    double scale = 1.0 / std::sqrt(dot(m, m));
+    return { m.x * scale, m.y * scale, m.z * scale };
+}
+
+// The circle is the cap of all v with a * v >= d.
+struct Circle
+{
+    Vec a;
+    double d;
+    int level;
+    Trixel magicNum;
+    MeshBuffer *buffer;
+};
+
+enum Markup
+{
+    REJECT,
+    PARTIAL,
+    FULL
+};
+
+// true if the arc from v1 to v2 crosses the edge of the circle, given that
+// both ends are on the same side of it.
+bool crossesEdge(const Circle &c, const Vec &v1, const Vec &v2, bool inside)
+{
+    // Point of the great circle through v1 and v2 closest to the center, or
+    // farthest from it if the ends are inside.
+    Vec n     = cross(v1, v2);
+    double an = dot(c.a, n) / dot(n, n);
+    Vec p     = { c.a.x - an * n.x, c.a.y - an * n.y, c.a.z - an * n.z };
+    if (inside)
+        p = { -p.x, -p.y, -p.z };
+
+    double len = std::sqrt(dot(p, p));
+    if (len == 0.0)
+        return false;
+
+    // Beyond the ends of the arc the ends themselves are the extremes.
+    if (dot(cross(v1, p), n) < 0.0 || dot(cross(p, v2), n) < 0.0)
+        return false;
+
+    return inside ? -len < c.d : len >= c.d;
+}
+
+inline bool contains(const Vec &v0, const Vec &v1, const Vec &v2, const Vec &p)
+{
+    return dot(cross(v0, v1), p) >= 0.0 && dot(cross(v1, v2), p) >= 0.0 && dot(cross(v2, v0), p) >= 0.0;
+}
+
+Markup markup(const Circle &c, const Vec &v0, const Vec &v1, const Vec &v2)
+{
+    int corners = (dot(c.a, v0) >= c.d) + (dot(c.a, v1) >= c.d) + (dot(c.a, v2) >= c.d);
+    if (corners == 1 || corners == 2)
+        return PARTIAL;
+
+    bool inside = corners == 3;
+    if (crossesEdge(c, v0, v1, inside) || crossesEdge(c, v1, v2, inside) || crossesEdge(c, v2, v0, inside))
+        return PARTIAL;
+
+    // Either the circle lies within the trixel or, for circles larger than a
+    // hemisphere, the part of the sky outside of it does.
+    if (inside)
+        return (c.d > -1.0 && contains(v0, v1, v2, { -c.a.x, -c.a.y, -c.a.z })) ? PARTIAL : FULL;
+    return contains(v0, v1, v2, c.a) ? PARTIAL : REJECT;
+}
+
+void cover(const Circle &c, Trixel id, int level, const Vec &v0, const Vec &v1, const Vec &v2)
+{
+    Markup mark = markup(c, v0, v1, v2);
+    if (mark == REJECT)
+        return;
+
+    if (level == c.level)
+    {
+        c.buffer->append(id - c.magicNum);
+        return;
+    }
+
+    if (mark == FULL)
+    {
+        int shift = 2 * (c.level - level);
+        c.buffer->append((id << shift) - c.magicNum, 1 << shift);
+        return;
+    }
+
+    // Same children as SpatialIndex::makeNewLayer()
+    Vec w0 = midPoint(v1, v2);
+    Vec w1 = midPoint(v0, v2);
+    Vec w2 = midPoint(v0, v1);
+    id <<= 2;
+    cover(c, id, level + 1, v0, w2, w1);
+    cover(c, id + 1, level + 1, v1, w0, w2);
+    cover(c, id + 2, level + 1, v2, w1, w0);
+    cover(c, id + 3, level + 1, w0, w1, w2);
+}
+
+// The octahedron of SpatialIndex: S0..S3, N0..N3 are the trixels 8..15
+const Vec rootVertex[6] = { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 }, { -1, 0, 0 }, { 0, -1, 0 }, { 0, 0, -1 } };
+
+const int rootNode[8][3] = { { 1, 5, 2 }, { 2, 5, 3 }, { 3, 5, 4 }, { 4, 5, 1 },
+                             { 1, 0, 4 }, { 4, 0, 3 }, { 3, 0, 2 }, { 2, 0, 1 } };
+}
+
 // CIRCLE
 void HTMesh::intersect(double ra, double dec, double radius, BufNum bufNum)
 {
-    double d = cos(radius * degree2Rad);
-    SpatialConstraint c(SpatialVector(ra, dec), d);
-    RangeConvex convex;
-    convex.add(c); // [ed:RangeConvex::add]
-
-    if (!performIntersection(&convex, bufNum))
+    if (!validBufNum(bufNum))
+    {
         printf("In intersect(%f, %f, %f)\n", ra, dec, radius);
+        return;
+    }
+
+    SpatialVector center(ra, dec);
+    Circle circle = { { center.x(), center.y(), center.z() }, cos(radius * degree2Rad), m_level, magicNum,
+                      m_meshBuffer[bufNum] };
+
+    circle.buffer->reset();
+    for (int i = 0; i < 8; i++)
+    {
+        cover(circle, 8 + i, 0, rootVertex[rootNode[i][0]], rootVertex[rootNode[i][1]],
+              rootVertex[rootNode[i][2]]);
+    }
 }
 
 // TRIANGLE
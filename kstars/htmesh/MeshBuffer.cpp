@@ -34,6 +34,22 @@ int MeshBuffer::append(Trixel trixel)
     return 1;
 }
 
+int MeshBuffer::append(Trixel first, int count)
+{
+    if (m_size + count > maxSize)
+    {
+        m_error += m_size + count - maxSize;
+        count = maxSize - m_size;
+    }
+    Trixel *buffer = m_buffer + m_size;
+    for (int i = 0; i < count; i++)
+    {
+        buffer[i] = first + i;
+    }
+    m_size += count;
+    return count;
+}
+
 void MeshBuffer::fill()
 {
     for (Trixel i = 0; i < (int)maxSize; i++)
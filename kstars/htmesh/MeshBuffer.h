@@ -35,6 +35,10 @@ class MeshBuffer
          */
     int append(Trixel trixel);
 
+    /** @short add count consecutive trixels starting at first
+         */
+    int append(Trixel first, int count);
+
     /** @short the location of the buffer for reading
          */
     const Trixel *buffer() const { return m_buffer; }
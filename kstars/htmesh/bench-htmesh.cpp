@@ -0,0 +1,140 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: BSD-3-Clause AND GPL-2.0-or-later
+*/
+
+// Micro-benchmark of the circle intersection, the aperture of every draw.  It
+// times HTMesh::intersect() against the RangeConvex intersection it replaced
+// and compares the trixels both find.  They agree exactly up to a hemisphere,
+// beyond that RangeConvex also keeps some trixels which lie in the uncovered
+// part of the sky, so these show up as missing.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#include "HTMesh.h"
+#include "MeshIterator.h"
+
+#include "SpatialVector.h"
+#include "SpatialIndex.h"
+#include "RangeConvex.h"
+#include "HtmRange.h"
+#include "HtmRangeIterator.h"
+
+struct Aperture
+{
+    double ra, dec, radius;
+};
+
+// The intersection as HTMesh::intersect() used to do it
+static void rangeConvexCover(const SpatialIndex &index, int level, const Aperture &a, std::vector<Trixel> &trixels)
+{
+    SpatialConstraint c(SpatialVector(a.ra, a.dec), cos(a.radius * M_PI / 180.0));
+    RangeConvex convex;
+    convex.add(c);
+    convex.setOlevel(level);
+
+    HtmRange range;
+    convex.intersect(&index, &range);
+    HtmRangeIterator iterator(&range);
+
+    Trixel magicNum = 8 << (2 * level);
+    trixels.clear();
+    while (iterator.hasNext())
+        trixels.push_back((Trixel)iterator.next() - magicNum);
+}
+
+static void meshCover(HTMesh &mesh, const Aperture &a, std::vector<Trixel> &trixels)
+{
+    mesh.intersect(a.ra, a.dec, a.radius);
+
+    MeshIterator iterator(&mesh);
+    trixels.clear();
+    while (iterator.hasNext())
+        trixels.push_back(iterator.next());
+}
+
+template <typename Cover>
+static double timeCovers(const std::vector<Aperture> &apertures, int rounds, Cover cover)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        for (const Aperture &a : apertures)
+            cover(a);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (rounds * apertures.size());
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 20;
+
+    // Zoomed in to all sky, the draw adds a degree to the field of view
+    const double radii[] = { 1.5, 5.0, 20.0, 46.0, 91.0, 181.0 };
+    std::vector<Aperture> apertures;
+    srand(42);
+    for (double radius : radii)
+    {
+        for (int i = 0; i < 50; i++)
+        {
+            double ra  = 360.0 * rand() / RAND_MAX;
+            double dec = 180.0 / M_PI * asin(2.0 * rand() / RAND_MAX - 1.0);
+            apertures.push_back({ ra, dec, radius });
+        }
+    }
+
+    printf("%6s %8s %10s %12s %12s %8s %8s\n", "level", "radius", "trixels", "convex [us]", "mesh [us]", "extra",
+           "missing");
+
+    std::vector<Trixel> expected, found, difference;
+    for (int level : { 3, 5, 7 })
+    {
+        SpatialIndex index(level, level);
+        HTMesh mesh(level, level);
+
+        for (double radius : radii)
+        {
+            std::vector<Aperture> subset;
+            for (const Aperture &a : apertures)
+            {
+                if (a.radius == radius)
+                    subset.push_back(a);
+            }
+
+            long trixels = 0, extra = 0, missing = 0;
+            for (const Aperture &a : subset)
+            {
+                rangeConvexCover(index, level, a, expected);
+                meshCover(mesh, a, found);
+                trixels += found.size();
+
+                difference.clear();
+                std::set_difference(found.begin(), found.end(), expected.begin(), expected.end(),
+                                    std::back_inserter(difference));
+                extra += difference.size();
+
+                difference.clear();
+                std::set_difference(expected.begin(), expected.end(), found.begin(), found.end(),
+                                    std::back_inserter(difference));
+                missing += difference.size();
+            }
+
+            double convexTime =
+                timeCovers(subset, rounds, [&](const Aperture &a) { rangeConvexCover(index, level, a, expected); });
+            double meshTime = timeCovers(subset, rounds, [&](const Aperture &a) { meshCover(mesh, a, found); });
+
+            printf("%6d %8.1f %10ld %12.2f %12.2f %8ld %8ld\n", level, radius, trixels / (long)subset.size(),
+                   convexTime, meshTime, extra, missing);
+        }
+    }
+
+    return 0;
+}
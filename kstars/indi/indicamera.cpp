@@ -23,6 +23,8 @@
 #include <knotification.h>
 #include "auxiliary/ksmessagebox.h"
 #include "ksnotification.h"
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QImageReader>
 #include <QFileInfo>
 #include <QStatusBar>
@@ -32,6 +34,9 @@
 
 const QStringList RAWFormats = { "cr2", "cr3", "crw", "nef", "raf", "dng", "arw", "orf" };
 
+// Light frames that may be loading in the background before processBLOB() waits for the oldest one.
+constexpr int MAX_PENDING_LOADS = 2;
+
 const QString getFITSModeStringString(FITSMode mode)
 {
     return FITSModes[mode].toString();
@@ -49,16 +54,26 @@ Camera::Camera(GenericDevice *parent) : ConcreteDevice(parent)
 
     connect(m_Parent->getClientManager(), &ClientManager::newBLOBManager, this, &Camera::setBLOBManager, Qt::UniqueConnection);
     m_LastNotificationTS = QDateTime::currentDateTime();
+
+    updateWriteSettings();
+    connect(&m_WriteQueue, &FITSWriteQueue::written, this, [](const QString & filename, qint64 bytes, qint64 ms)
+    {
+        qCDebug(KSTARS_INDI) << "Wrote" << filename << "(" << bytes << "bytes) in" << ms << "ms";
+    });
+    connect(&m_WriteQueue, &FITSWriteQueue::writeFailed, this, [this](const QString & filename)
+    {
+        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to write file:" << filename;
+        emit error(ERROR_SAVE);
+    });
 }
 
 Camera::~Camera()
 {
     if (m_ImageViewerWindow)
         m_ImageViewerWindow->close();
-    if (fileWriteThread.isRunning())
-        fileWriteThread.waitForFinished();
-    if (fileWriteBuffer != nullptr)
-        delete [] fileWriteBuffer;
+    for (auto &frame : m_PendingFrames)
+        frame.load.waitForFinished();
+    m_WriteQueue.waitForFinished();
 }
 
 void Camera::setBLOBManager(const char *device, INDI::Property prop)
@@ -518,13 +533,15 @@ void Camera::setWSBLOB(const QByteArray &message, const QString &extension)
     auto bvp = primaryCCDBLOB.getBLOB();
     auto bp = bvp->at(0);
 
-    bp->setBlob(const_cast<char *>(message.data()));
+    m_WSFrame = message;
+    bp->setBlob(const_cast<char *>(m_WSFrame.constData()));
     bp->setSize(message.size());
     bp->setFormat(extension.toLatin1().constData());
     processBLOB(primaryCCDBLOB);
 
     // Disassociate
     bp->setBlob(nullptr);
+    m_WSFrame.clear();
 }
 
 void Camera::processStream(INDI::Property prop)
@@ -560,59 +577,44 @@ void Camera::processStream(INDI::Property prop)
     emit showVideoFrame(prop, streamW, streamH);
 }
 
-void ISD::Camera::updateFileBuffer(INDI::Property prop, bool is_fits)
+QByteArray ISD::Camera::fileBuffer(INDI::Property prop)
 {
-    if (is_fits)
-    {
-        // Check if the last write is still ongoing, and if so wait.
-        // It is using the fileWriteBuffer.
-        if (fileWriteThread.isRunning())
-        {
-            fileWriteThread.waitForFinished();
-        }
-    }
+    auto bp = prop.getBLOB()->at(0);
 
-    // Will write blob data in a separate thread, and can't depend on the blob
-    // memory, so copy it first.
+    // A websocket message is already ours and implicitly shared, no need to copy it.
+    if (!m_WSFrame.isEmpty() && bp->getBlob() == m_WSFrame.constData())
+        return m_WSFrame;
 
-    auto bp = prop.getBLOB()->at(0);
-    // Check buffer size.
-    if (fileWriteBufferSize != bp->getBlobLen())
-    {
-        if (fileWriteBuffer != nullptr)
-            delete [] fileWriteBuffer;
-        fileWriteBufferSize = bp->getBlobLen();
-        fileWriteBuffer = new char[fileWriteBufferSize];
-    }
+    // The INDI client reuses the blob memory for the next frame, so copy it once. The copy
+    // is never modified afterwards: FITSData reads it in place and pending writes keep their
+    // own reference, so neither has to wait for the other.
+    return QByteArray(static_cast<const char *>(bp->getBlob()), bp->getBlobLen());
+}
 
-    // Copy memory, and write file on a separate thread.
-    // Probably too late to return an error if the file couldn't write.
-    memcpy(fileWriteBuffer, bp->getBlob(), bp->getBlobLen());
+void Camera::updateWriteSettings()
+{
+    FITSWriteQueue::Settings settings;
+    settings.maxQueuedBytes = static_cast<qint64>(Options::captureWriteQueueSize()) * 1024 * 1024;
+    settings.maxParallelWrites = Options::captureParallelWrites();
+    settings.sync = static_cast<FITSWriteQueue::SyncPolicy>(Options::captureWriteSync());
+    settings.compress = Options::captureCompressFITS();
+    m_WriteQueue.setSettings(settings);
 }
 
 bool Camera::saveCurrentImage(QString &filename)
 {
+    // The frame last published, whose newImage() receivers are saving it
+    const QByteArray buffer = m_FrameBuffer;
+    const BlobType type = BType;
+
     // TODO: Not yet threading the writes for non-fits files.
     // Would need to deal with the raw conversion, etc.
-    if (BType == BLOB_FITS)
+    if (type == BLOB_FITS)
     {
-        // Check if the last write is still ongoing, and if so wait.
-        // It is using the fileWriteBuffer.
-        if (fileWriteThread.isRunning())
-        {
-            fileWriteThread.waitForFinished();
-        }
-
-        // Wait until the file is written before overwritting the filename.
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        fileWriteThread = QtConcurrent::run(&ISD::Camera::WriteImageFileInternal, this, filename, fileWriteBuffer,
-                                            fileWriteBufferSize);
-#else
-        fileWriteThread = QtConcurrent::run(this, &ISD::Camera::WriteImageFileInternal, filename, fileWriteBuffer,
-                                            fileWriteBufferSize);
-#endif
+        // Returns once the frame is queued, or blocks while the queue is over its memory bound.
+        filename = m_WriteQueue.enqueue(filename, buffer);
     }
-    else if (!WriteImageFileInternal(filename, static_cast<char*>(fileWriteBuffer), fileWriteBufferSize))
+    else if (!FITSWriteQueue::writeFile(filename, buffer, m_WriteQueue.settings().sync))
         return false;
 
     return true;
@@ -625,7 +627,8 @@ bool Camera::processBLOB(INDI::Property prop)
     if (bvp->getPermission() == IP_WO || bvp->at(0)->getSize() == 0)
         return false;
 
-    BType = BLOB_OTHER;
+    // BType is the type of the published frame, this one may still wait behind others.
+    BlobType blobType = BLOB_OTHER;
 
     auto bp = bvp->at(0);
 
@@ -646,15 +649,15 @@ bool Camera::processBLOB(INDI::Property prop)
 
     // If it's not FITS or an image, don't process it.
     if ((QImageReader::supportedImageFormats().contains(shortFormat.toLatin1())))
-        BType = BLOB_IMAGE;
+        blobType = BLOB_IMAGE;
     else if (format.contains("fits"))
-        BType = BLOB_FITS;
+        blobType = BLOB_FITS;
     else if (format.contains("xisf"))
-        BType = BLOB_XISF;
+        blobType = BLOB_XISF;
     else if (RAWFormats.contains(shortFormat))
-        BType = BLOB_RAW;
+        blobType = BLOB_RAW;
 
-    if (BType == BLOB_OTHER)
+    if (blobType == BLOB_OTHER)
         return false;
 
     CameraChip *targetChip = nullptr;
@@ -668,11 +671,15 @@ bool Camera::processBLOB(INDI::Property prop)
                              bp->getSize();
     }
 
+    QElapsedTimer received;
+    received.start();
+
     // Create temporary name if ANY of the following conditions are met:
     // 1. file is preview or batch mode is not enabled
     // 2. file type is not FITS_NORMAL (focus, guide..etc)
     // create the file buffer only, saving the image file must be triggered from outside.
-    updateFileBuffer(prop, BType == BLOB_FITS);
+    const QByteArray buffer = fileBuffer(prop);
+    const qint64 copyMs = received.elapsed();
 
     // Don't spam, just one notification per 3 seconds
     if (QDateTime::currentDateTime().secsTo(m_LastNotificationTS) <= -3)
@@ -681,36 +688,114 @@ bool Camera::processBLOB(INDI::Property prop)
         m_LastNotificationTS = QDateTime::currentDateTime();
     }
 
-    QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<char *>(bp->getBlob()), bp->getSize());
     QSharedPointer<FITSData> imageData;
     imageData.reset(new FITSData(targetChip->getCaptureMode()), &QObject::deleteLater);
     imageData->setExtension(shortFormat);
 
+    // Add metadata
+    imageData->setProperty("device", getDeviceName());
+    imageData->setProperty("blobVector", prop.getName());
+    imageData->setProperty("blobElement", bp->getName());
+    imageData->setProperty("chip", targetChip->getType());
+
+    PendingFrame frame;
+    frame.data = imageData;
+    frame.chip = targetChip;
+    frame.format = QString(bp->getFormat()).toLower();
+    frame.buffer = buffer;
+    frame.type = blobType;
+    frame.copyMs = copyMs;
+    frame.received = received;
+
     // JM 2024.12.25: Only load from buffer if we need the imageData.
     // When neither FITS Viewer nor Summary view is used, and when the type is FITS_NORMAL in batch mode, then we save to disk directly
     // so that we do not incur delays in loading from buffer that may delay the sequence unnecessairly.
-    if ((Options::useFITSViewer() || Options::useSummaryPreview() || targetChip->getCaptureMode() != FITS_NORMAL
-            || !targetChip->isBatchMode()) &&
-            !imageData->loadFromBuffer(buffer))
+    const bool needsLoad = Options::useFITSViewer() || Options::useSummaryPreview() || targetChip->getCaptureMode() != FITS_NORMAL
+                           || !targetChip->isBatchMode();
+
+    if (needsLoad && targetChip->getCaptureMode() == FITS_NORMAL)
     {
-        emit error(ERROR_LOAD);
+        // The frame is safely ours now. Load it in the background so the next BLOB (or the
+        // next exposure with fast exposure enabled) is not held up by the FITS load, statistics
+        // and debayering. Frames are still published in the order they arrived.
+        emit propertyUpdated(prop);
+
+        // Back-pressure: never keep more than a couple of full frames in flight.
+        publishPendingFrames(MAX_PENDING_LOADS - 1);
+
+        frame.load = QtConcurrent::run([imageData, buffer]()
+        {
+            return imageData->loadFromBuffer(buffer);
+        });
+        auto watcher = new QFutureWatcher<bool>(this);
+        connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher]()
+        {
+            watcher->deleteLater();
+            publishPendingFrames(MAX_PENDING_LOADS);
+        });
+        watcher->setFuture(frame.load);
+        m_PendingFrames.append(frame);
         return true;
     }
 
-    // Add metadata
-    imageData->setProperty("device", getDeviceName());
-    imageData->setProperty("blobVector", prop.getName());
-    imageData->setProperty("blobElement", bp->getName());
-    imageData->setProperty("chip", targetChip->getType());
+    // Frames still loading in the background arrived before this one.
+    publishPendingFrames(0);
 
-    // Retain a copy
-    targetChip->setImageData(imageData);
+    if (needsLoad && !imageData->loadFromBuffer(buffer))
+    {
+        emit error(ERROR_LOAD);
+        return true;
+    }
+
+    frame.loadMs = received.elapsed() - copyMs;
     emit propertyUpdated(prop);
-    emit newImage(imageData, QString(bp->getFormat()).toLower());
+    publishFrame(frame);
 
     return true;
 }
 
+void Camera::publishPendingFrames(int maxPending)
+{
+    // Publishing may end up back here through nested event processing, the outer call
+    // will pick up whatever is left.
+    if (m_PublishingFrames)
+        return;
+    m_PublishingFrames = true;
+
+    while (!m_PendingFrames.isEmpty())
+    {
+        if (!m_PendingFrames.first().load.isFinished())
+        {
+            if (m_PendingFrames.size() <= maxPending)
+                break;
+            m_PendingFrames.first().load.waitForFinished();
+        }
+
+        PendingFrame frame = m_PendingFrames.takeFirst();
+        frame.loadMs = frame.received.elapsed() - frame.copyMs;
+        if (frame.load.result())
+            publishFrame(frame);
+        else
+            emit error(ERROR_LOAD);
+    }
+
+    m_PublishingFrames = false;
+}
+
+void Camera::publishFrame(const PendingFrame &frame)
+{
+    // Handed on with the image so the capture module can log the whole chain per frame.
+    frame.data->setProperty("receiveLatency", QString("copy %1ms, ready %2ms").arg(frame.copyMs).arg(frame.loadMs));
+
+    // Receivers of newImage() may save the frame right away, see saveCurrentImage().
+    m_FrameBuffer = frame.buffer;
+    BType = frame.type;
+
+    // Retain a copy
+    frame.chip->setImageData(frame.data);
+    emit newImage(frame.data, frame.format);
+}
+
 void Camera::StreamWindowHidden()
 {
     if (isConnected())
@@ -1594,37 +1679,6 @@ bool Camera::setScopeInfo(double focalLength, double aperture)
     return true;
 }
 
-// Internal function to write an image blob to disk.
-bool Camera::WriteImageFileInternal(const QString &filename, char *buffer, const size_t size)
-{
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly))
-    {
-        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to open write file: " <<
-                                filename;
-        return false;
-    }
-    int n = 0;
-    QDataStream out(&file);
-    bool ok = true;
-    for (size_t nr = 0; nr < size; nr += n)
-    {
-        n = out.writeRawData(buffer + nr, size - nr);
-        if (n < 0)
-        {
-            ok = false;
-            break;
-        }
-    }
-    ok = file.flush() && ok;
-    file.close();
-    file.setPermissions(QFileDevice::ReadUser |
-                        QFileDevice::WriteUser |
-                        QFileDevice::ReadGroup |
-                        QFileDevice::ReadOther);
-    return ok;
-}
-
 QString Camera::getCaptureFormat() const
 {
     if (m_CaptureFormatIndex < 0 || m_CaptureFormats.isEmpty() || m_CaptureFormatIndex >= m_CaptureFormats.size())
@@ -13,7 +13,9 @@
 #include "wsmedia.h"
 #include "auxiliary/imageviewer.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitswritequeue.h"
 
+#include <QElapsedTimer>
 #include <QStringList>
 #include <QPointer>
 #include <QtConcurrent>
@@ -242,6 +244,12 @@ class Camera : public ConcreteDevice
          */
         bool saveCurrentImage(QString &filename);
 
+        /**
+         * @brief updateWriteSettings Apply the capture write options to the queue saving the
+         * frames. Called on creation and whenever the capture settings change.
+         */
+        void updateWriteSettings();
+
 
     public slots:
         void StreamWindowHidden();
@@ -274,7 +282,6 @@ class Camera : public ConcreteDevice
 
     private:
         void processStream(INDI::Property prop);
-        bool WriteImageFileInternal(const QString &filename, char *buffer, const size_t size);
 
         bool HasGuideHead { false };
         bool HasCooler { false };
@@ -326,10 +333,39 @@ class Camera : public ConcreteDevice
         QPair<double, double> m_ExposurePresetsMinMax;
 
         // Used when writing the image fits file to disk in a separate thread.
-        void updateFileBuffer(INDI::Property prop, bool is_fits);
-        char *fileWriteBuffer { nullptr };
-        int fileWriteBufferSize { 0 };
-        QString fileWriteFilename;
-        QFuture<void> fileWriteThread;
+        QByteArray fileBuffer(INDI::Property prop);
+        // The BLOB of the frame last published with newImage(), which saveCurrentImage()
+        // writes out. Each BLOB is copied once out of the INDI client buffer. It is shared,
+        // never modified, by FITSData and by any write still queued, and freed when the
+        // last of them lets go of it.
+        QByteArray m_FrameBuffer;
+        // Set while setWSBLOB() feeds a websocket message through processBLOB(), so that
+        // the message is shared instead of copied.
+        QByteArray m_WSFrame;
+        FITSWriteQueue m_WriteQueue;
+
+        // Light frames whose FITS load runs in the background, oldest first.
+        struct PendingFrame
+        {
+            QSharedPointer<FITSData> data;
+            CameraChip *chip { nullptr };
+            QString format;
+            // Made current by publishFrame() so the frame is saved with its own bytes.
+            QByteArray buffer;
+            BlobType type { BLOB_OTHER };
+            QFuture<bool> load;
+            QElapsedTimer received;
+            qint64 copyMs { 0 };
+            qint64 loadMs { 0 };
+        };
+        /**
+         * @brief publishPendingFrames Publish loaded frames in arrival order. Blocks on the
+         * oldest load until no more than maxPending frames are left in flight.
+         */
+        void publishPendingFrames(int maxPending);
+        /** @brief publishFrame Attach the frame to its chip and emit newImage(). */
+        void publishFrame(const PendingFrame &frame);
+        QList<PendingFrame> m_PendingFrames;
+        bool m_PublishingFrames { false };
 };
 }
@@ -245,7 +245,8 @@ bool StreamWG::queryDebayerParameters()
     if (targetChip->getBayerInfo(offsetX, offsetY, pattern) == false)
         return false;
 
-    m_DebayerParams.method = DC1394_BAYER_METHOD_NEAREST;
+    // Live video only needs a preview, the 2x2 super pixel is the cheapest color decode.
+    m_DebayerParams.method = DC1394_BAYER_METHOD_DOWNSAMPLE;
     m_DebayerParams.filter = DC1394_COLOR_FILTER_RGGB;
 
     if (pattern == "GBRG")
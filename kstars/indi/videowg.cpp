@@ -6,6 +6,7 @@
 
 #include "videowg.h"
 #include "collimationoverlaytypes.h"
+#include "fitsviewer/bayerdemosaic.h"
 
 #include "kstars_debug.h"
 #include "kstarsdata.h"
@@ -19,6 +20,8 @@
 #include <QSqlRecord>
 #include <QtMath>
 
+#include <cstring>
+
 VideoWG::VideoWG(QWidget *parent) : QLabel(parent)
 {
     streamImage.reset(new QImage());
@@ -140,10 +143,9 @@ void VideoWG::mouseReleaseEvent(QMouseEvent *event)
 
 bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
 {
-    uint32_t rgb_size = streamW * streamH * 3;
-    auto * destinationBuffer = new uint8_t[rgb_size];
-
-    if (destinationBuffer == nullptr)
+    // Decode straight into the image, it owns its pixels so no temporary buffer is needed.
+    QSharedPointer<QImage> image(new QImage(streamW, streamH, QImage::Format_RGB888));
+    if (image->isNull())
     {
         qCCritical(KSTARS) << "Unable to allocate memory for temporary bayer buffer.";
         return false;
@@ -156,37 +158,36 @@ bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
     {
         dc1394_source += streamW;
         ds1394_height--;
+        memset(image->scanLine(streamH - 1), 0, image->bytesPerLine());
     }
     if (params.offsetX == 1)
     {
         dc1394_source++;
     }
-    dc1394error_t error_code = dc1394_bayer_decoding_8bit(dc1394_source, destinationBuffer, streamW, ds1394_height,
-                               params.filter, params.method);
+
+    BayerDemosaic::Target target;
+    target.layout = BayerDemosaic::Target::Interleaved;
+    target.rowStride = image->bytesPerLine();
+
+    dc1394error_t error_code = BayerDemosaic::decode(dc1394_source, image->bits(), streamW, ds1394_height,
+                               params, target);
 
     if (error_code != DC1394_SUCCESS)
     {
         qCCritical(KSTARS) << "Debayer failed" << error_code;
-        delete[] destinationBuffer;
         return false;
     }
 
-    streamImage.reset(new QImage(destinationBuffer, streamW, streamH, QImage::Format_RGB888));
-    bool rc = !streamImage->isNull();
-
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
+    streamImage = image;
+    kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
 
-        paintOverlay(kPix);
+    paintOverlay(kPix);
 
-        setPixmap(kPix);
-    }
+    setPixmap(kPix);
 
     emit imageChanged(streamImage);
 
-    delete[] destinationBuffer;
-    return rc;
+    return true;
 }
 
 void VideoWG::paintOverlay(QPixmap &imagePix)
@@ -43,6 +43,16 @@
 
 namespace
 {
+// Intervals in days between the updates done in updateTime().
+// Precession and nutation change slowly.
+const double NUM_UPDATE_INTERVAL = 1.0;
+// Planets, asteroids and comets. The latter two are computed in the background.
+const double PLANET_UPDATE_INTERVAL = 0.01;
+// Moon moves ~30 arcmin/hr, so update its position every minute.
+const double MOON_UPDATE_INTERVAL = 0.00069444;
+// Alt/Az coordinates, divided by the zoom factor.
+const double SKY_UPDATE_SCALE = 0.1;
+
 // Report fatal error during data loading to user
 // Calls QApplication::exit
 void fatalErrorMessage(QString fname)
@@ -275,7 +285,7 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
 
     KSNumbers num(ut().djd());
 
-    if (std::abs(ut().djd() - LastNumUpdate.djd()) > 1.0)
+    if (std::abs(ut().djd() - LastNumUpdate.djd()) > NUM_UPDATE_INTERVAL)
     {
         LastNumUpdate = KStarsDateTime(ut().djd());
         m_preUpdateNumID++;
@@ -283,14 +293,13 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         skyComposite()->update(&num);
     }
 
-    if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > 0.01)
+    if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > PLANET_UPDATE_INTERVAL)
     {
         LastPlanetUpdate = KStarsDateTime(ut().djd());
         skyComposite()->updateSolarSystemBodies(&num);
     }
 
-    // Moon moves ~30 arcmin/hr, so update its position every minute.
-    if (std::abs(ut().djd() - LastMoonUpdate.djd()) > 0.00069444)
+    if (std::abs(ut().djd() - LastMoonUpdate.djd()) > MOON_UPDATE_INTERVAL)
     {
         LastMoonUpdate = ut();
         skyComposite()->updateMoons(&num);
@@ -298,7 +307,7 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
 
     //Update Alt/Az coordinates.  Timescale varies with zoom level
     //If Clock is in Manual Mode, always update. (?)
-    if (std::abs(ut().djd() - LastSkyUpdate.djd()) > 0.1 / Options::zoomFactor() || clock()->isManualMode())
+    if (std::abs(ut().djd() - LastSkyUpdate.djd()) > SKY_UPDATE_SCALE / Options::zoomFactor() || clock()->isManualMode())
     {
         LastSkyUpdate = ut();
         m_preUpdateID++;
@@ -309,6 +318,12 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
     }
 }
 
+void KStarsData::publishSkyUpdate()
+{
+    m_preUpdateID++;
+    emit skyUpdate(false);
+}
+
 void KStarsData::syncUpdateIDs()
 {
     m_updateID = m_preUpdateID;
@@ -390,6 +390,12 @@ class KStarsData : public QObject
         }
         void syncUpdateIDs();
 
+        /**
+         * @short Bump the updateID and request a redraw once positions computed in the
+         * background have been copied over to the sky objects.
+         */
+        void publishSkyUpdate();
+
     signals:
         /** Signal that specifies the text that should be drawn in the KStarsSplash window. */
         void progressText(const QString &text);
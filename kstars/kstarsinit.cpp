@@ -926,7 +926,7 @@ void KStars::datainitFinished()
 
     connect(data()->clock(), &SimClock::scaleChanged, map(), &SkyMap::slotClockSlewing);
 
-    connect(data(), &KStarsData::skyUpdate, map(), &SkyMap::forceUpdateNow);
+    connect(data(), &KStarsData::skyUpdate, map(), &SkyMap::forceTimeUpdateNow);
     connect(m_TimeStepBox, &TimeStepBox::scaleChanged, data(), &KStarsData::setTimeDirection);
     connect(m_TimeStepBox, &TimeStepBox::scaleChanged, data()->clock(), &SimClock::setClockScale);
 
@@ -80,6 +80,7 @@ bool AsteroidsComponent::selected()
  */
 void AsteroidsComponent::loadDataFromText()
 {
+    cancelUpdate();
     clear();
     objectNames(SkyObject::ASTEROID).clear();
     objectLists(SkyObject::ASTEROID).clear();
@@ -97,61 +98,83 @@ void AsteroidsComponent::loadDataFromText()
     try
     {
         KSUtils::JPLParser ast_parser(filepath_txt);
-        auto fieldMap = ast_parser.fieldMap();
-        bool isString = fieldMap.count("epoch_mjd") == 1;
+
+        // JM 2022.08.26: Try to check if the file is in the new format
+        // where epoch_mjd field is a string
+        const bool isString  = ast_parser.column("epoch_mjd") >= 0;
+        const int cFullName  = ast_parser.column("full_name");
+        const int cEpoch     = ast_parser.column(isString ? "epoch_mjd" : "epoch.mjd");
+        const int cPeriod    = ast_parser.column(isString ? "per_y" : "per.y");
+        const int cQ         = ast_parser.column("q");
+        const int cA         = ast_parser.column("a");
+        const int cE         = ast_parser.column("e");
+        const int cI         = ast_parser.column("i");
+        const int cW         = ast_parser.column("w");
+        const int cN         = ast_parser.column("om");
+        const int cM         = ast_parser.column("ma");
+        const int cOrbitID   = ast_parser.column("orbit_id");
+        const int cH         = ast_parser.column("H");
+        const int cG         = ast_parser.column("G");
+        const int cNEO       = ast_parser.column("neo");
+        const int cDiameter  = ast_parser.column("diameter");
+        const int cExtent    = ast_parser.column("extent");
+        const int cAlbedo    = ast_parser.column("albedo");
+        const int cRotPeriod = ast_parser.column("rot_per");
+        const int cMOID      = ast_parser.column("moid");
+        const int cClass     = ast_parser.column("class");
+
+        // Translated once, not once per asteroid.
+        const QString europa   = i18nc("Asteroid name (optional)", "Europa");
+        const QString io       = i18nc("Asteroid name (optional)", "Io");
+        const QString asterope = i18nc("Asteroid name (optional)", "Asterope");
+        const QString pluto    = i18nc("Asteroid name (optional)", "Pluto");
+        const QString suffix   = i18n(" (Asteroid)");
+
+        if (ast_parser.count() > 0)
+        {
+            m_ObjectList.reserve(ast_parser.count());
+            objectNames(SkyObject::ASTEROID).reserve(ast_parser.count());
+            objectLists(SkyObject::ASTEROID).reserve(ast_parser.count());
+        }
 
         ast_parser.for_each(
             [&](const auto & get)
         {
-            full_name = get("full_name").toString();
-            full_name = full_name.trimmed();
-            int catN  = full_name.section(' ', 0, 0).toInt();
-            name      = full_name.section(' ', 1, -1);
+            full_name = get(cFullName).toString().trimmed();
+            const int space = full_name.indexOf(' ');
+            int catN  = (space < 0 ? full_name : full_name.left(space)).toInt();
+            name      = space < 0 ? QString() : full_name.mid(space + 1);
 
             //JM temporary hack to avoid Europa,Io, and Asterope duplication
-            if (name == i18nc("Asteroid name (optional)", "Europa") ||
-                    name == i18nc("Asteroid name (optional)", "Io") ||
-                    name == i18nc("Asteroid name (optional)", "Asterope"))
-                name += i18n(" (Asteroid)");
-
-            // JM 2022.08.26: Try to check if the file is in the new format
-            // where epoch_mjd field is a string
-            if (isString)
-            {
-                mJD         = get("epoch_mjd").toString().toInt();
-                period      = get("per_y").toString().toDouble();
-            }
-            // If not fall back to old behavior
-            else
-            {
-                mJD         = get("epoch.mjd").toInt();
-                period      = get("per.y").toDouble();
-            }
-
-            q           = get("q").toString().toDouble();
-            a           = get("a").toString().toDouble();
-            e           = get("e").toString().toDouble();
-            dble_i      = get("i").toString().toDouble();
-            dble_w      = get("w").toString().toDouble();
-            dble_N      = get("om").toString().toDouble();
-            dble_M      = get("ma").toString().toDouble();
-            orbit_id    = get("orbit_id").toString();
-            H           = get("H").toString().toDouble();
-            G           = get("G").toString().toDouble();
-            neo         = get("neo").toString() == "Y";
-            diameter    = get("diameter").toString().toFloat();
-            dimensions  = get("extent").toString();
-            albedo      = get("albedo").toString().toFloat();
-            rot_period  = get("rot_per").toString().toFloat();
-            earth_moid  = get("moid").toString().toDouble();
-            orbit_class = get("class").toString();
+            if (name == europa || name == io || name == asterope)
+                name += suffix;
+
+            mJD         = get(cEpoch).toInt();
+            period      = get(cPeriod).toFloat();
+            q           = get(cQ).toDouble();
+            a           = get(cA).toDouble();
+            e           = get(cE).toDouble();
+            dble_i      = get(cI).toDouble();
+            dble_w      = get(cW).toDouble();
+            dble_N      = get(cN).toDouble();
+            dble_M      = get(cM).toDouble();
+            orbit_id    = get(cOrbitID).toString();
+            H           = get(cH).toDouble();
+            G           = get(cG).toDouble();
+            neo         = get(cNEO).toString() == "Y";
+            diameter    = get(cDiameter).toFloat();
+            dimensions  = get(cExtent).toString();
+            albedo      = get(cAlbedo).toFloat();
+            rot_period  = get(cRotPeriod).toFloat();
+            earth_moid  = get(cMOID).toDouble();
+            orbit_class = get(cClass).toString();
 
             JD = static_cast<double>(mJD) + 2400000.5;
 
             KSAsteroid *new_asteroid = nullptr;
 
             // Diameter is missing from JPL data
-            if (name == i18nc("Asteroid name (optional)", "Pluto"))
+            if (name == pluto)
                 diameter = 2390;
 
             new_asteroid =
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <QBuffer>
 #include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
+#include <QFileInfo>
 
 #include "listcomponent.h"
 #include "binarylistcomponent.h"
@@ -34,6 +37,11 @@
  * This is a concession to the already present architecture.
  *
  * File paths are determent by the means of KSPaths::writableLocation.
+ *
+ * The binary starts with a small header holding a format version, the object type, the
+ * object count and the size and modification time of the text file it was built from.
+ * A binary whose header does not match, e.g. because the text file was updated or an
+ * older KStars wrote it, is rebuilt from text. The binary is memory mapped for loading.
  */
 template <class T, typename Component>
 class BinaryListComponent
@@ -134,11 +142,35 @@ protected:
      */
     virtual void clearData();
 
+    /**
+     * @brief isBinaryCurrent
+     * @return True if the binary exists, has the current format and was built from the
+     * current text file (or the text file is gone).
+     */
+    bool isBinaryCurrent() const;
+
     QString filepath_txt;
     QString filepath_bin;
 
 // Don't allow the children to mess with the Binary Version!
 private:
+    struct Header
+    {
+        quint32 magic { 0 };
+        quint32 format { 0 };
+        qint32 type { -1 };
+        qint64 sourceSize { -1 };
+        qint64 sourceModified { -1 };
+        quint32 count { 0 };
+    };
+
+    // Bump whenever the layout of the header or of the serialized objects changes.
+    static constexpr quint32 binaryMagic = 0x4B53424C; // "KSBL"
+    static constexpr quint32 binaryFormat = 2;
+
+    Header sourceHeader() const;
+    static bool readHeader(QDataStream &in, Header &header);
+
     QDataStream::Version binversion = QDataStream::Qt_5_5;
     Component* parent;
 };
@@ -170,7 +202,7 @@ void  BinaryListComponent<T, Component>::loadData(bool dropBinaryFile)
         dropBinary();
 
     QFile binfile(filepath_bin);
-    if (binfile.exists()) {
+    if (isBinaryCurrent()) {
         loadDataFromBinary(binfile);
     } else {
         loadDataFromText();
@@ -191,14 +223,37 @@ void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
     // Open our binary file and create a Stream
     if (binfile.open(QIODevice::ReadOnly))
     {
-        QDataStream in(&binfile);
+        // Read straight from the page cache rather than through QFile's buffer.
+        QByteArray mapped;
+        QBuffer buffer;
+        const uchar *data = binfile.size() > 0 ? binfile.map(0, binfile.size()) : nullptr;
+        if (data)
+        {
+            mapped = QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<int>(binfile.size()));
+            buffer.setBuffer(&mapped);
+            buffer.open(QIODevice::ReadOnly);
+        }
+        QDataStream in(data ? static_cast<QIODevice *>(&buffer) : &binfile);
 
         // Use the specified binary version
         // TODO: Place this into the config
         in.setVersion(binversion);
         in.setFloatingPointPrecision(QDataStream::DoublePrecision);
 
-        while(!in.atEnd()){
+        Header header;
+        if (!readHeader(in, header))
+        {
+            qWarning() << "Ignoring binary data of unknown format in" << binfile.fileName();
+            binfile.close();
+            return;
+        }
+
+        parent->m_ObjectList.reserve(header.count);
+        parent->objectNames(T::TYPE).reserve(header.count);
+        parent->objectLists(T::TYPE).reserve(header.count);
+
+        for (quint32 i = 0; i < header.count && !in.atEnd(); ++i)
+        {
             T *new_object = nullptr;
             in >> new_object;
 
@@ -207,6 +262,8 @@ void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
             parent->objectNames(T::TYPE).append(new_object->name());
             parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
         }
+
+        buffer.close();
         binfile.close();
     }
     else qWarning() << "Failed loading binary data from" << binfile.fileName();
@@ -223,11 +280,19 @@ template<class T, typename Component>
 void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
 {
     // Open our file and create a stream
-    binfile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    if (!binfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Failed writing binary data to" << binfile.fileName();
+        return;
+    }
     QDataStream out(&binfile);
     out.setVersion(binversion);
     out.setFloatingPointPrecision(QDataStream::DoublePrecision);
 
+    Header header = sourceHeader();
+    header.count = parent->m_ObjectList.size();
+    out << header.magic << header.format << header.type << header.sourceSize << header.sourceModified << header.count;
+
     // Now just dump out everything
     for(auto object : parent->m_ObjectList){
          out << *((T*)object);
@@ -236,6 +301,53 @@ void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
     binfile.close();
 }
 
+template<class T, typename Component>
+typename BinaryListComponent<T, Component>::Header BinaryListComponent<T, Component>::sourceHeader() const
+{
+    Header header;
+    header.magic = binaryMagic;
+    header.format = binaryFormat;
+    header.type = T::TYPE;
+
+    const QFileInfo source(filepath_txt);
+    if (source.exists())
+    {
+        header.sourceSize = source.size();
+        header.sourceModified = source.lastModified().toMSecsSinceEpoch();
+    }
+    return header;
+}
+
+template<class T, typename Component>
+bool BinaryListComponent<T, Component>::readHeader(QDataStream &in, Header &header)
+{
+    in >> header.magic >> header.format >> header.type >> header.sourceSize >> header.sourceModified >> header.count;
+    return in.status() == QDataStream::Ok && header.magic == binaryMagic && header.format == binaryFormat &&
+           header.type == T::TYPE;
+}
+
+template<class T, typename Component>
+bool BinaryListComponent<T, Component>::isBinaryCurrent() const
+{
+    QFile binfile(filepath_bin);
+    if (!binfile.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&binfile);
+    in.setVersion(binversion);
+
+    Header header;
+    if (!readHeader(in, header))
+        return false;
+
+    // Without the text file there is nothing to rebuild from, keep what we have.
+    const Header current = sourceHeader();
+    if (current.sourceSize < 0)
+        return true;
+
+    return header.sourceSize == current.sourceSize && header.sourceModified == current.sourceModified;
+}
+
 template<class T, typename Component>
 bool  BinaryListComponent<T, Component>::dropBinary()
 {
@@ -129,15 +129,19 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     // galaxies of unknown magnitude, and many of them also of unknown
     // size, remains smooth.
 
-    // Helper lambda to fill the appropriate cache for a given trixel
+    // Helper lambda to fill the appropriate cache for a given trixel,
+    // returns false if the trixel can't be drawn
     auto fillCache = [&](
                          TrixelCache<ObjectList>::element & cacheElement,
                          ObjectList (CatalogsDB::DBManager::*fillFunction)(const int),
                          Trixel trixel
-                     ) -> void
+                     ) -> bool
     {
         if (!cacheElement.is_set())
         {
+            if (m_loadingSuspended > 0)
+                return false;
+
             try
             {
                 cacheElement = (m_db_manager.*fillFunction)(trixel);
@@ -155,6 +159,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
                 throw; // do not silently fail
             }
         }
+
+        return true;
     };
 
     // Helper lambda to JIT update and draw
@@ -201,7 +207,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
         // Fill the cache for this trixel
         auto &objectsKnownMag = m_mainCache[trixel];
-        fillCache(objectsKnownMag, &CatalogsDB::DBManager::get_objects_in_trixel_no_nulls, trixel);
+        if (!fillCache(objectsKnownMag, &CatalogsDB::DBManager::get_objects_in_trixel_no_nulls, trixel))
+            continue;
         drawListKnownMag.clear();
 
         // Filter based on magnitude and size
@@ -246,7 +253,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
             // Fill cache
             auto &objectsUnknownMag = m_unknownMagCache[trixel];
-            fillCache(objectsUnknownMag, &CatalogsDB::DBManager::get_objects_in_trixel_null_mag, trixel);
+            if (!fillCache(objectsUnknownMag, &CatalogsDB::DBManager::get_objects_in_trixel_null_mag, trixel))
+                continue;
 
             // Filter
             QtConcurrent::blockingMap(
@@ -345,7 +353,7 @@ SkyObject *CatalogsComponent::findByName(const QString &name, bool exact)
 
 void CatalogsComponent::objectsInArea(QList<SkyObject *> &list, const SkyRegion &region)
 {
-    if (!selected())
+    if (!selected() || m_loadingSuspended > 0)
         return;
 
     for (SkyRegion::const_iterator it = region.constBegin(); it != region.constEnd();
@@ -374,7 +382,7 @@ void CatalogsComponent::objectsInArea(QList<SkyObject *> &list, const SkyRegion
 
 SkyObject *CatalogsComponent::objectNearest(SkyPoint *p, double &maxrad)
 {
-    if (!selected())
+    if (!selected() || m_loadingSuspended > 0)
         return nullptr;
 
     m_skyMesh->aperture(p, maxrad, OBJ_NEAREST_BUF);
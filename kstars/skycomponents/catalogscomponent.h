@@ -115,6 +115,25 @@ class CatalogsComponent : public SkyComponent
             m_catalog_colors = m_db_manager.get_catalog_colors();
         };
 
+        /**
+         * Stop loading objects from the database until `resumeLoading`
+         * is called, e.g. while a long write transaction on another
+         * connection would make the queries of the sky map fail. The
+         * objects already in the cache are still drawn. The calls nest.
+         */
+        void suspendLoading()
+        {
+            m_loadingSuspended++;
+        };
+
+        /**
+         * Undo a call of `suspendLoading`.
+         */
+        void resumeLoading()
+        {
+            m_loadingSuspended--;
+        };
+
         /**
          * Wether to show the DSOs.
          */
@@ -177,6 +196,11 @@ class CatalogsComponent : public SkyComponent
          */
         CatalogsDB::ColorMap m_catalog_colors;
 
+        /**
+         * The number of `suspendLoading` calls not yet undone.
+         */
+        int m_loadingSuspended{ 0 };
+
         //@{
         /** Helpers */
 
@@ -83,6 +83,7 @@ void CometsComponent::loadData()
     emitProgressText(i18n("Loading comets"));
     qCInfo(KSTARS) << "Loading comets";
 
+    cancelUpdate();
     clear();
     objectNames(SkyObject::COMET).clear();
     objectLists(SkyObject::COMET).clear();
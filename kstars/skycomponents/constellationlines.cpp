@@ -150,6 +150,20 @@ void ConstellationLines::JITupdate(LineList *lineList)
     }
 }
 
+void ConstellationLines::updateStars()
+{
+    if (!selected())
+        return;
+
+    UpdateID updateID = KStarsData::Instance()->updateID();
+
+    for (const auto &lineList : listList())
+    {
+        if (lineList->updateID != updateID)
+            JITupdate(lineList.get());
+    }
+}
+
 void ConstellationLines::reindex(KSNumbers *num)
 {
     if (!num)
@@ -36,6 +36,13 @@ class ConstellationLines : public LineListIndex
 
     void reindex(KSNumbers *num);
 
+    /**
+     * @short Bring the stars joined by the lines up to date. Called before the
+     * stars are drawn on a thread of their own, so that drawing the lines
+     * does not update the same stars at the same time.
+     */
+    void updateStars();
+
     bool selected() override;
 
   protected:
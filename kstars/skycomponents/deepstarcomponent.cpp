@@ -280,9 +280,9 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     m_skyMesh->inDraw(true);
 
     SkyPoint *focus = map->focus();
-    m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
+    m_skyMesh->aperture(focus, radius + 1.0, STAR_DRAW_BUF); // divide by 2 for testing
 
-    MeshIterator region(m_skyMesh, DRAW_BUF);
+    MeshIterator region(m_skyMesh, STAR_DRAW_BUF);
 
     // If we are to hide the fainter stars (eg: while slewing), we set the magnitude limit to hideStarsMag.
     if (hideFaintStars && maglim > hideStarsMag)
@@ -56,15 +56,35 @@ void LineListIndex::removeLine(const std::shared_ptr<LineList> &lineList)
 
         if (m_lineIndex->contains(trixel))
             m_lineIndex->value(trixel)->removeOne(lineList);
+
+        auto segments = m_segmentIndex.find(trixel);
+        if (segments != m_segmentIndex.end())
+        {
+            for (int i = 0; i < segments->size(); i++)
+            {
+                if (segments->at(i).lineList == lineList)
+                {
+                    segments->remove(i);
+                    break;
+                }
+            }
+        }
     }
     m_listList.removeOne(lineList);
+    m_drawSegments.remove(lineList.get());
 }
 
 void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
 {
     const IndexHash &indexHash     = getIndexHash(lineList.get());
+    const SegmentHash &segmentHash = skyMesh()->lineSegments();
     IndexHash::const_iterator iter = indexHash.constBegin();
 
+    // Used if the index does not tell which segments cross a trixel
+    QVector<int> allSegments;
+    for (int i = 1; i < lineList->points()->size(); i++)
+        allSegments.append(i);
+
     while (iter != indexHash.constEnd())
     {
         Trixel trixel = iter.key();
@@ -75,6 +95,7 @@ void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
             m_lineIndex->insert(trixel, std::shared_ptr<LineListList>(new LineListList()));
         }
         m_lineIndex->value(trixel)->append(lineList);
+        m_segmentIndex[trixel].append({ lineList, segmentHash.value(trixel, allSegments) });
     }
     m_listList.append(lineList);
 }
@@ -111,6 +132,8 @@ void LineListIndex::reindexLines()
     DrawID drawID = skyMesh()->incDrawID();
 
     m_lineIndex.reset(new LineListHash());
+    m_segmentIndex.clear();
+    m_listList.clear();
     for (auto &listList : *oldIndex)
     {
         for (auto &item : *listList)
@@ -182,21 +205,56 @@ void LineListIndex::drawLines(SkyPainter *skyp)
     DrawID drawID     = skyMesh()->drawID();
     UpdateID updateID = KStarsData::Instance()->updateID();
 
-    for (auto &lineListList : m_lineIndex->values())
+    if (!drawVisibleTrixelsOnly())
     {
-        for (int i = 0; i < lineListList->size(); i++)
+        for (auto &lineList : m_listList)
         {
-            std::shared_ptr<LineList> lineList = lineListList->at(i);
-
-            if (lineList->drawID == drawID)
-                continue;
-            lineList->drawID = drawID;
-
             if (lineList->updateID != updateID)
                 JITupdate(lineList.get());
 
             skyp->drawSkyPolyline(lineList.get(), skipList(lineList.get()), label());
         }
+        return;
+    }
+
+    // Collect the segments crossing the visible trixels, so that the cost of
+    // a layer of lines scales with the visible area rather than the whole sky.
+    m_drawLists.clear();
+    MeshIterator region(skyMesh(), drawBuffer());
+
+    while (region.hasNext())
+    {
+        auto trixelSegments = m_segmentIndex.constFind(region.next());
+
+        if (trixelSegments == m_segmentIndex.constEnd())
+            continue;
+
+        for (const auto &item : *trixelSegments)
+        {
+            LineList *lineList  = item.lineList.get();
+            QBitArray &segments = m_drawSegments[lineList];
+
+            if (lineList->drawID != drawID)
+            {
+                lineList->drawID = drawID;
+                segments.fill(false, lineList->points()->size());
+                m_drawLists.append(lineList);
+            }
+
+            for (int segment : item.segments)
+            {
+                if (segment < segments.size())
+                    segments.setBit(segment);
+            }
+        }
+    }
+
+    for (LineList *lineList : qAsConst(m_drawLists))
+    {
+        if (lineList->updateID != updateID)
+            JITupdate(lineList);
+
+        skyp->drawSkyPolylineSegments(lineList, m_drawSegments.value(lineList), skipList(lineList), label());
     }
 }
 
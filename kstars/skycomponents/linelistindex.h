@@ -9,7 +9,10 @@
 #include "skycomponent.h"
 #include "skymesh.h"
 
+#include <QBitArray>
+#include <QHash>
 #include <QMutex>
+#include <QVector>
 
 #include <memory>
 #include <set>
@@ -118,10 +121,19 @@ class LineListIndex : public SkyComponent
     void appendBoth(const std::shared_ptr<LineList> &lineList);
 
     /**
-     * @short Draws all the lines in m_listList as simple lines in float mode.
+     * @short Draws the lines in m_listList as simple lines in float mode.
+     * Only the segments in the trixels of drawBuffer() are drawn, unless
+     * drawVisibleTrixelsOnly() is false.
      */
     void drawLines(SkyPainter *skyp);
 
+    /**
+     * @short Whether drawLines() may skip the segments outside of the visible
+     * trixels. Subclasses whose lines move across the sky with time, e.g. the
+     * horizontal grid, are not indexed where they are drawn and return false.
+     */
+    virtual bool drawVisibleTrixelsOnly() const { return true; }
+
     /**
      * @short Draws all the lines in m_listList as filled polygons in float
      * mode.
@@ -146,6 +158,9 @@ class LineListIndex : public SkyComponent
      * trixels that cover lineList.  Overridden by SkipListIndex so it can
      * pass SkyMesh an IndexHash indicating which line segments should not
      * be indexed @param lineList contains the list of points to be covered.
+     * The hash must come from SkyMesh::indexLine() or SkyMesh::indexStarLine()
+     * so that the segments crossing each trixel are known, otherwise all
+     * segments are drawn when any of the trixels is visible.
      */
     virtual const IndexHash &getIndexHash(LineList *lineList);
 
@@ -171,5 +186,19 @@ class LineListIndex : public SkyComponent
 
     LineListList m_listList;
 
+    /** The segments of a line list that cross a trixel */
+    struct TrixelSegments
+    {
+        std::shared_ptr<LineList> lineList;
+        QVector<int> segments;
+    };
+
+    /** The segments of all line lists by trixel, kept along with m_lineIndex */
+    QHash<Trixel, QVector<TrixelSegments>> m_segmentIndex;
+
+    /** Segments drawn by drawLines() in the current draw cycle, by line list */
+    QHash<LineList *, QBitArray> m_drawSegments;
+    QVector<LineList *> m_drawLists;
+
     QMutex mutex;
 };
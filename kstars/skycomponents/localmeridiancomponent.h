@@ -30,4 +30,8 @@ class LocalMeridianComponent : public CoordinateGrid
     void update(KSNumbers *) override;
 
     bool selected() override;
+
+  protected:
+    /** The lines follow the horizon, they are not indexed where they are drawn */
+    bool drawVisibleTrixelsOnly() const override { return false; }
 };
@@ -6,10 +6,11 @@
 
 #include "skylabeler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 
 #include <QPainter>
-#include <QPixmap>
 
 #include "Options.h"
 #include "kstarsdata.h" // MINZOOM
@@ -17,16 +18,36 @@
 #include "projections/projector.h"
 
 //---------------------------------------------------------------------------//
-// A Little data container class
+// Bit ranges of one row of the virtual screen
 //---------------------------------------------------------------------------//
 
-typedef struct LabelRun
+namespace
 {
-    LabelRun(int s, int e) : start(s), end(e) {}
-    int start;
-    int end;
+/// Bits first to last (0-63) of a word
+inline quint64 wordMask(int first, int last)
+{
+    const quint64 high = last == 63 ? ~quint64(0) : (quint64(1) << (last + 1)) - 1;
+    return high & (~quint64(0) << first);
+}
+
+/// Calls f(word, mask) for the words covering bits minX to maxX of row
+template <typename F>
+inline bool forRowBits(quint64 *row, int minX, int maxX, F f)
+{
+    const int first = minX >> 6, last = maxX >> 6;
+    if (first == last)
+        return f(row[first], wordMask(minX & 63, maxX & 63));
 
-} LabelRun;
+    if (!f(row[first], wordMask(minX & 63, 63)))
+        return false;
+    for (int w = first + 1; w < last; w++)
+    {
+        if (!f(row[w], ~quint64(0)))
+            return false;
+    }
+    return f(row[last], wordMask(0, maxX & 63));
+}
+}
 
 //----- Now for the main event ----------------------------------------------//
 
@@ -44,7 +65,7 @@ SkyLabeler *SkyLabeler::Instance()
 void SkyLabeler::setZoomFont()
 {
 #ifndef KSTARS_LITE
-    QFont font(m_p.font());
+    QFont font(m_font);
 #else
     QFont font(m_stdFont);
 #endif
@@ -58,7 +79,7 @@ void SkyLabeler::setZoomFont()
     if (deltaSize)
     {
         font.setPointSize(font.pointSize() - deltaSize);
-        m_p.setFont(font);
+        m_font = font;
     }
 #else
     if (deltaSize)
@@ -81,7 +102,7 @@ double SkyLabeler::ZoomOffset()
 //----- Constructor ---------------------------------------------------------//
 
 SkyLabeler::SkyLabeler()
-    : m_fontMetrics(QFont()), m_picture(-1), labelList(NUM_LABEL_TYPES)
+    : m_fontMetrics(QFont()), labelList(NUM_LABEL_TYPES)
 {
 #ifdef KSTARS_LITE
     //Painter is needed to get default font and we use it only once to have only one warning
@@ -99,14 +120,6 @@ SkyLabeler::SkyLabeler()
 
 SkyLabeler::~SkyLabeler()
 {
-    for (auto &row : screenRows)
-    {
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        delete row;
-    }
 }
 
 bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
@@ -148,12 +161,7 @@ bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
     //psky.drawLine( QPointF( left,  bot ), QPointF( left,  top ) );
 
     // otherwise draw the label and return true
-    m_p.save();
-    m_p.translate(o);
-
-    m_p.rotate(angle); //rotate the coordinate system
-    m_p.drawText(QPointF(-w2, h), text);
-    m_p.restore(); //reset coordinate system
+    placeLabel(o, QPointF(-w2, h), angle, text);
 
     return true;
 }
@@ -176,10 +184,8 @@ bool SkyLabeler::drawNameLabel(SkyObject *obj, const QPointF &_p,
     {
         double factor       = log(Options::zoomFactor() / 750.0);
         double newPointSize = qBound(12.0, factor * m_stdFont.pointSizeF(), 18.0) * (1.0 + 0.7 * Options::labelFontScaling()/100.0);
-        QFont zoomFont(m_p.font());
-        zoomFont.setPointSizeF(newPointSize);
-        m_p.setFont(zoomFont);
-        m_p.drawText(p, sLabel);
+        m_font.setPointSizeF(newPointSize);
+        placeLabel(p, QPointF(), 0, sLabel);
         return true;
     }
 }
@@ -187,7 +193,7 @@ bool SkyLabeler::drawNameLabel(SkyObject *obj, const QPointF &_p,
 void SkyLabeler::setFont(const QFont &font)
 {
 #ifndef KSTARS_LITE
-    m_p.setFont(font);
+    m_font = font;
 #else
     m_drawFont = font;
 #endif
@@ -199,14 +205,14 @@ void SkyLabeler::setPen(const QPen &pen)
 #ifdef KSTARS_LITE
     Q_UNUSED(pen);
 #else
-    m_p.setPen(pen);
+    m_pen = pen;
 #endif
 }
 
 void SkyLabeler::shrinkFont(int delta)
 {
 #ifndef KSTARS_LITE
-    QFont font(m_p.font());
+    QFont font(m_font);
 #else
     QFont font(m_drawFont);
 #endif
@@ -237,8 +243,8 @@ void SkyLabeler::getMargins(const QString &text, float *left, float *right, floa
     winHeight = SkyMapLite::Instance()->height();
     winWidth  = SkyMapLite::Instance()->width();
 #else
-    winHeight = m_p.window().height();
-    winWidth  = m_p.window().width();
+    winHeight = m_screenSize.height();
+    winWidth  = m_screenSize.width();
 #endif
 
     *right = winWidth - sideMargin;
@@ -251,73 +257,23 @@ void SkyLabeler::reset(SkyMap *skyMap)
 {
     // ----- Set up Projector ---
     m_proj = skyMap->projector();
-    // ----- Set up Painter -----
-    if (m_p.isActive())
-        m_p.end();
-    m_picture = QPicture();
-    m_p.begin(&m_picture);
-    //This works around BUG 10496 in Qt
-    m_p.drawPoint(0, 0);
-    m_p.drawPoint(skyMap->width() + 1, skyMap->height() + 1);
+    // ----- Forget the labels of the last frame -----
+    m_labels.clear();
+    m_drawSaved  = false;
+    m_screenSize = skyMap->size();
+    m_font       = QFont();
+    m_pen        = QPen();
     // ----- Set up Zoom Dependent Font -----
 
-    m_stdFont = QFont(m_p.font());
+    m_stdFont = m_font;
     setZoomFont();
-    m_skyFont     = m_p.font();
+    m_skyFont     = m_font;
     m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int) m_fontMetrics.averageCharWidth() * 5;
 
     // ----- Set up Zoom Dependent Offset -----
     m_offset = SkyLabeler::ZoomOffset();
 
-    // ----- Prepare Virtual Screen -----
-    m_yScale = (m_fontMetrics.height() + 1.0);
-
-    int maxY = int(skyMap->height() / m_yScale);
-    if (maxY < 1)
-        maxY = 1; // prevents a crash below?
-
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
-
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        row->clear();
-    }
-
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
-
-    // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
-
-    //----- Clear out labelList -----
-    for (auto &item : labelList)
-    {
-        item.clear();
-    }
+    resetScreen(skyMap->width(), skyMap->height());
 }
 
 #ifdef KSTARS_LITE
@@ -331,79 +287,106 @@ void SkyLabeler::reset()
     setZoomFont();
     m_skyFont     = m_drawFont;
     m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
     // ----- Set up Zoom Dependent Offset -----
     m_offset = ZoomOffset();
 
+    resetScreen(skyMap->width(), skyMap->height());
+}
+#endif
+
+void SkyLabeler::resetScreen(int width, int height)
+{
     // ----- Prepare Virtual Screen -----
     m_yScale = (m_fontMetrics.height() + 1.0);
 
-    int maxY = int(skyMap->height() / m_yScale);
+    int maxY = int(height / m_yScale);
     if (maxY < 1)
         maxY = 1; // prevents a crash below?
 
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
+    m_maxY     = maxY;
+    m_maxX     = std::max(width, 1) - 1;
+    m_rowWords = (m_maxX >> 6) + 1;
+    m_size     = (maxY + 1) * (m_maxX + 1);
 
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        row->clear();
-    }
-
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
+    // Keeps its capacity, so this is a memset unless the sky map grew
+    m_screen.fill(0, (maxY + 1) * m_rowWords);
 
     // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
+    m_marks = m_hits = m_misses = 0;
 
     //----- Clear out labelList -----
-    for (int i = 0; i < labelList.size(); i++)
+    for (auto &item : labelList)
     {
-        labelList[i].clear();
+        item.clear();
     }
 }
-#endif
+
+void SkyLabeler::placeLabel(const QPointF &pos, const QPointF &textPos, qreal angle, const QString &text)
+{
+    PlacedLabel label;
+    label.pos     = pos;
+    label.textPos = textPos;
+    label.angle   = angle;
+    label.text    = text;
+    label.font    = m_font;
+    label.pen     = m_pen;
+    m_labels.append(label);
+}
 
 void SkyLabeler::draw(QPainter &p)
 {
-    //FIXME: need a better soln. Apparently starting a painter
-    //clears the picture.
-    // But it's not like that's something that should be in the docs, right?
-    // No, that's definitely better to leave to people to figure out on their own.
-    if (m_p.isActive())
+    p.save();
+    bool first = true;
+    QFont font;
+    QPen pen;
+    auto paint = [&](const QVector<PlacedLabel> &labels)
     {
-        m_p.end();
-    }
-    m_picture.play(&p); //can't replay while it's being painted on
-    //this is also undocumented btw.
-    //m_p.begin(&m_picture);
+        for (const auto &label : labels)
+        {
+            // Labels come in runs of the same font and pen, only switch between runs
+            if (first || label.font != font)
+                p.setFont(font = label.font);
+            if (first || label.pen != pen)
+                p.setPen(pen = label.pen);
+            first = false;
+
+            if (label.background.isValid())
+                p.fillRect(label.background, QBrush(label.backgroundColor));
+
+            if (label.angle == 0)
+            {
+                p.drawText(label.pos + label.textPos, label.text);
+                continue;
+            }
+            p.save();
+            p.translate(label.pos);
+            p.rotate(label.angle); //rotate the coordinate system
+            p.drawText(label.textPos, label.text);
+            p.restore(); //reset coordinate system
+        }
+    };
+    if (m_drawSaved)
+        paint(m_savedLabels);
+    paint(m_labels);
+    p.restore();
 }
 
-// We use Run Length Encoding to hold the information instead of an array of
-// chars.  This is both faster and smaller but the code is more complicated.
-//
-// This code is easy to break and hard to fix.
+void SkyLabeler::saveLabels()
+{
+    m_savedLabels = m_labels;
+    m_savedScreen = m_screen;
+    m_drawSaved   = true;
+
+    // Labels placed from now on are kept apart, draw() paints both.
+    m_labels.clear();
+}
+
+void SkyLabeler::restoreLabels()
+{
+    if (m_savedScreen.size() == m_screen.size())
+        m_screen = m_savedScreen;
+    m_drawSaved = true;
+}
 
 bool SkyLabeler::markText(const QPointF &p, const QString &text, qreal padding_factor)
 {
@@ -440,6 +423,15 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
         minX = int(right);
     }
 
+    if (minX < 0)
+        minX = 0;
+    if (minX > m_maxX)
+        minX = m_maxX;
+    if (maxX < 0)
+        maxX = 0;
+    if (maxX > m_maxX)
+        maxX = m_maxX;
+
     // setup y coordinates
     int maxY = int(bot / m_yScale);
     int minY = int(top / m_yScale);
@@ -462,16 +454,15 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
 
     // check to see if we overlap any existing label
     // We must check all rows before we start marking
+    quint64 *screen = m_screen.data();
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-        int i;
-        for (i = 0; i < row->size(); i++)
+        const bool free = forRowBits(screen + y * m_rowWords, minX, maxX, [](quint64 &word, quint64 mask)
+        {
+            return (word & mask) == 0;
+        });
+        if (!free)
         {
-            if (row->at(i)->end < minX)
-                continue; // skip past these
-            if (row->at(i)->start > maxX)
-                break;
             m_misses++;
             return false;
         }
@@ -480,95 +471,14 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
     m_hits++;
     m_marks += (maxX - minX + 1) * (maxY - minY + 1);
 
-    // Okay, there was no overlap so let's insert the current rectangle into
-    // screenRows.
-
+    // Okay, there was no overlap so let's mark the current rectangle.
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-
-        // Simplest case: an empty row
-        if (row->size() < 1)
-        {
-            row->append(new LabelRun(minX, maxX));
-            m_elements++;
-            continue;
-        }
-
-        // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
-
-        // i now points to first label PAST ours
-
-        // if we are first, append or merge at start of list
-        if (i == 0)
-        {
-            if (row->at(0)->start - maxX < m_minDeltaX)
-            {
-                row->at(0)->start = minX;
-            }
-            else
-            {
-                row->insert(0, new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we are past the last label, merge or append at end
-        else if (i == row->size())
-        {
-            if (minX - row->at(i - 1)->end < m_minDeltaX)
-            {
-                row->at(i - 1)->end = maxX;
-            }
-            else
-            {
-                row->append(new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we got here, we must insert or merge the new label
-        //  between [i-1] and [i]
-
-        bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
-        bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
-
-        // double merge => combine all 3 into one
-        if (mergeHead && mergeTail)
+        forRowBits(screen + y * m_rowWords, minX, maxX, [](quint64 &word, quint64 mask)
         {
-            row->at(i - 1)->end = row->at(i)->end;
-            delete row->at(i);
-            row->removeAt(i);
-            m_elements--;
-        }
-
-        // Merge label with [i-1]
-        else if (mergeHead)
-        {
-            row->at(i - 1)->end = maxX;
-        }
-
-        // Merge label with [i]
-        else if (mergeTail)
-        {
-            row->at(i)->start = minX;
-        }
-
-        // insert between the two
-        else
-        {
-            row->insert(i, new LabelRun(minX, maxX));
-            m_elements++;
-        }
+            word |= mask;
+            return true;
+        });
     }
 
     return true;
@@ -595,7 +505,7 @@ void SkyLabeler::drawQueuedLabels()
     KStarsData *data = KStarsData::Instance();
 
     resetFont();
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
+    setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
     drawQueuedLabelsType(PLANET_LABEL);
 
     if (labelList[SATURN_MOON_LABEL].size() > 0)
@@ -616,12 +526,12 @@ void SkyLabeler::drawQueuedLabels()
     drawQueuedLabelsType(ASTEROID_LABEL);
     drawQueuedLabelsType(COMET_LABEL);
 
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("SatLabelColor")));
+    setPen(QColor(data->colorScheme()->colorNamed("SatLabelColor")));
     drawQueuedLabelsType(SATELLITE_LABEL);
 
     // Whelp we're here and we don't have a Rude Label color?
     // Will just set it to Planet color since this is how it used to be!!
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
+    setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
     LabelList list = labelList[RUDE_LABEL];
 
     for (const auto &item : list)
@@ -634,6 +544,13 @@ void SkyLabeler::drawQueuedLabelsType(SkyLabeler::label_t type)
 {
     LabelList list = labelList[type];
 
+    // Brighter objects get the first pick of the free space. Unknown magnitudes go last.
+    std::stable_sort(list.begin(), list.end(), [](const SkyLabel &a, const SkyLabel &b)
+    {
+        const float magA = a.obj->mag(), magB = b.obj->mag();
+        return std::isnan(magB) ? !std::isnan(magA) : magA < magB;
+    });
+
     for (const auto &item : list)
     {
         drawNameLabel(item.obj, item.o);
@@ -648,7 +565,7 @@ void SkyLabeler::drawRudeNameLabel(SkyObject *obj, const QPointF &p)
 {
     QString sLabel = obj->labelString();
     double offset  = obj->labelOffset();
-    QRectF rect    = m_p.fontMetrics().boundingRect(sLabel);
+    QRectF rect    = QFontMetricsF(m_font).boundingRect(sLabel);
     rect.moveTo(p.x() + offset, p.y() + offset);
 
     //Interestingly, the fontMetric boundingRect isn't where you might think...
@@ -659,9 +576,10 @@ void SkyLabeler::drawRudeNameLabel(SkyObject *obj, const QPointF &p)
 
     //FIXME: Implement label background options
     QColor color(KStarsData::Instance()->colorScheme()->colorNamed("SkyColor"));
-    color.setAlpha(m_p.pen().color().alpha()); //same transparency for the text and the background
-    m_p.fillRect(rect2, QBrush(color));
-    m_p.drawText(rect.topLeft(), sLabel);
+    color.setAlpha(m_pen.color().alpha()); //same transparency for the text and the background
+    placeLabel(rect.topLeft(), QPointF(), 0, sLabel);
+    m_labels.last().background      = rect2;
+    m_labels.last().backgroundColor = color;
 }
 
 //----- Diagnostic and information routines -----
@@ -687,8 +605,8 @@ void SkyLabeler::printInfo()
     printf("  hits=%d  misses=%d  ratio=%.1f%%\n", m_hits, m_misses, hitRatio());
     printf("  yScale=%.1f maxY=%d\n", m_yScale, m_maxY);
 
-    printf("  screenRows=%d elements=%d virtualSize=%.1f Kbytes\n", screenRows.size(), m_elements,
-           float(m_size) / 1024.0);
+    printf("  screen=%dx%d labels=%d virtualSize=%.1f Kbytes\n", m_maxX + 1, m_maxY + 1,
+           m_labels.size() + (m_drawSaved ? m_savedLabels.size() : 0), float(m_screen.size() * sizeof(quint64)) / 1024.0);
 
 //    static const char *labelName[NUM_LABEL_TYPES];
 //
@@ -705,29 +623,4 @@ void SkyLabeler::printInfo()
 //    {
 //        printf("  %20ss: %d\n", labelName[i], labelList[i].size());
 //    }
-//
-//    // Check for errors in the data structure
-//    for (int y = 0; y <= m_maxY; y++)
-//    {
-//        LabelRow *row = screenRows[y];
-//        int size      = row->size();
-//        if (size < 2)
-//            continue;
-//
-//        bool error = false;
-//        for (int i = 1; i < size; i++)
-//        {
-//            if (row->at(i - 1)->end > row->at(i)->start)
-//                error = true;
-//        }
-//        if (!error)
-//            continue;
-//
-//        printf("ERROR: %3d: ", y);
-//        for (int i = 0; i < row->size(); i++)
-//        {
-//            printf("(%d, %d) ", row->at(i)->start, row->at(i)->end);
-//        }
-//        printf("\n");
-//    }
 }
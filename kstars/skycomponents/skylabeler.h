@@ -7,21 +7,18 @@
 
 #include "skylabel.h"
 
+#include <QColor>
 #include <QFontMetricsF>
 #include <QList>
 #include <QVector>
 #include <QPainter>
-#include <QPicture>
+#include <QPen>
 #include <QFont>
 
 class QString;
 class QPointF;
 class SkyMap;
 class Projector;
-struct LabelRun;
-
-typedef QList<LabelRun *> LabelRow;
-typedef QVector<LabelRow *> ScreenRows;
 
 /**
  *@class SkyLabeler
@@ -35,21 +32,16 @@ typedef QVector<LabelRow *> ScreenRows;
  * and return true.
  *
  * Since we need to check for overlap for every label every time it is
- * potentially drawn on the screen, efficiency is essential.  So instead of
- * having a 2-dimensional array of boolean values we use Run Length Encoding
- * and store the virtual array in a QVector of QLists.  Each element of the
- * vector, a LabelRow, corresponds to a horizontal strip of pixels on the actual
- * screen.  How many vertical pixels are in each strip is controlled by
- * m_yDensity.  The higher the density, the fewer vertical pixels per strip and
- * hence a larger number of strips are needed to cover the screen.  As
- * m_yDensity increases so does the density of the strips.
+ * potentially drawn on the screen, efficiency is essential.  The virtual
+ * screen is a bitset with one bit per pixel in the X-dimension.  Each row of
+ * bits corresponds to a horizontal strip of pixels on the actual screen that
+ * is one font height tall.  A label covers a few strips and a few 64 bit words
+ * in each of them, so checking and marking it takes about the same time no
+ * matter how many labels are already on the screen.
  *
- * The information in the X-dimension is completed run length encoded. A
- * consecutive run of pixels in one strip that are covered by one or more labels
- * is stored in a LabelRun object that merely stores the start pixel and the end
- * pixel.  A LabelRow is a list of LabelRun's stored in ascending order.  This
- * saves a lot of space over an explicit array and it also makes checking for
- * overlaps faster and even makes inserting new overlaps faster on average.
+ * Labels are not drawn right away.  The text, position, font and pen of every
+ * label that got a place are kept in a list and draw() paints them all on top
+ * of the finished sky.
  *
  * Synopsis:
  *
@@ -76,7 +68,7 @@ typedef QVector<LabelRow *> ScreenRows;
  * Each type of label has its own buffer which lets us control the font and
  * color as well as the priority.  The priority is now manually set in the
  * draw() routine by adjusting the order in which the various buffers get
- * drawn.
+ * drawn.  Within a buffer the brightest objects get their labels first.
  *
  * Finally, even though this code was written to be very efficient, we might
  * want to take some care in how many labels we throw at it.  Sending it
@@ -287,6 +279,22 @@ class SkyLabeler
          */
     bool markRegion(qreal left, qreal right, qreal top, qreal bot);
 
+    //----- Keeping Labels -----//
+
+    /**
+         * @short Keep the labels drawn since reset() along with the regions
+         * they mark.  Used when the sky map keeps the image of layers that do
+         * not change with time, so that their labels can be put back with
+         * restoreLabels() instead of drawing those layers again.
+         */
+    void saveLabels();
+
+    /**
+         * @short Draw the labels kept by saveLabels() again and mark their
+         * regions.  Must be called right after reset().
+         */
+    void restoreLabels();
+
     //----- Diagnostics and Information -----//
 
     /**
@@ -325,16 +333,35 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
-    ScreenRows screenRows;
+    /// A label that got a place on the screen, painted by draw()
+    struct PlacedLabel
+    {
+        QPointF pos;
+        /// Position of the text relative to pos, in the coordinates rotated by angle
+        QPointF textPos;
+        qreal angle { 0 };
+        QString text;
+        QFont font;
+        QPen pen;
+        /// Filled before the text is drawn if valid
+        QRectF background;
+        QColor backgroundColor;
+    };
+
+    /// Clears the virtual screen and sizes it for a sky map of width x height pixels
+    void resetScreen(int width, int height);
+    void placeLabel(const QPointF &pos, const QPointF &textPos, qreal angle, const QString &text);
+
+    /// One row of m_rowWords words for every strip of the screen
+    QVector<quint64> m_screen;
+    QVector<quint64> m_savedScreen;
+    int m_rowWords { 0 };
     int m_maxX { 0 };
     int m_maxY { 0 };
     int m_size { 0 };
-    /// When to merge two adjacent regions
-    int m_minDeltaX { 30 };
     int m_marks { 0 };
     int m_hits { 0 };
     int m_misses { 0 };
-    int m_elements { 0 };
     int m_errors { 0 };
     qreal m_yScale { 0 };
     double m_offset { 0 };
@@ -344,8 +371,12 @@ class SkyLabeler
 #ifdef KSTARS_LITE
     QFont m_drawFont;
 #endif
-    QPainter m_p;
-    QPicture m_picture;
+    QFont m_font;
+    QPen m_pen;
+    QVector<PlacedLabel> m_labels;
+    QVector<PlacedLabel> m_savedLabels;
+    bool m_drawSaved { false };
+    QSize m_screenSize;
     QVector<LabelList> labelList;
     const Projector *m_proj { nullptr };
     static SkyLabeler *pinstance;
@@ -52,6 +52,7 @@
 #endif
 
 #include <QApplication>
+#include <QtConcurrent>
 
 #include <kstars_debug.h>
 
@@ -244,6 +245,86 @@ void SkyMapComposite::updateMoons(KSNumbers *num)
 void SkyMapComposite::draw(SkyPainter *skyp)
 {
     Q_UNUSED(skyp)
+#ifndef KSTARS_LITE
+    if (!beginDraw())
+        return;
+
+    for (int layer = 0; layer < NUM_SKY_LAYERS; layer++)
+        drawLayer(skyp, static_cast<SkyLayer>(layer));
+
+    // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
+    // -jbb uncomment these to see trixel outlines:
+    /*
+        QPainter *psky = dynamic_cast< QPainter *>( skyp );
+        if( psky ) {
+            qCDebug(KSTARS) << "Drawing trixel boundaries for debugging.";
+            psky->setPen(  QPen( QBrush( QColor( "yellow" ) ), 1, Qt::SolidLine ) );
+            m_skyMesh->draw( *psky, OBJ_NEAREST_BUF );
+            SkyMesh *p;
+            if( p = SkyMesh::Instance( 6 ) ) {
+                qCDebug(KSTARS) << "We have a deep sky mesh to draw";
+                p->draw( *psky, OBJ_NEAREST_BUF );
+            }
+
+            psky->setPen( QPen( QBrush( QColor( "green" ) ), 1, Qt::SolidLine ) );
+            m_skyMesh->draw( *psky, NO_PRECESS_BUF );
+            if( p )
+                p->draw( *psky, NO_PRECESS_BUF );
+        }
+        */
+#endif
+}
+
+void SkyMapComposite::drawLayers(SkyPainter *skyp, bool redrawStatic,
+                                 const std::function<void(SkyLayer)> &selectLayer, SkyPainter *starPainter)
+{
+    Q_UNUSED(skyp)
+    Q_UNUSED(redrawStatic)
+    Q_UNUSED(selectLayer)
+    Q_UNUSED(starPainter)
+#ifndef KSTARS_LITE
+    if (!beginDraw())
+        return;
+
+    QFuture<void> stars;
+    if (redrawStatic)
+    {
+        if (starPainter)
+        {
+            m_CLines->updateStars();
+            stars = QtConcurrent::run([this, starPainter]()
+            {
+                drawLayer(starPainter, STAR_LAYER);
+            });
+        }
+
+        for (SkyLayer layer : { BACKGROUND_LAYER, CATALOG_LAYER, STAR_LAYER })
+        {
+            if (layer == STAR_LAYER && starPainter)
+                continue;
+            selectLayer(layer);
+            drawLayer(skyp, layer);
+        }
+        m_skyLabeler->saveLabels();
+    }
+    else
+        m_skyLabeler->restoreLabels();
+
+    selectLayer(LOCAL_GRID_LAYER);
+    drawLayer(skyp, LOCAL_GRID_LAYER);
+
+    // The foreground draws the star names, and planet moons are sized like the stars.
+    stars.waitForFinished();
+    if (redrawStatic && starPainter)
+        skyp->setSizeMagLimit(starPainter->sizeMagLimit());
+
+    selectLayer(FOREGROUND_LAYER);
+    drawLayer(skyp, FOREGROUND_LAYER);
+#endif
+}
+
+bool SkyMapComposite::beginDraw()
+{
 #ifndef KSTARS_LITE
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
@@ -269,19 +350,17 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     if (m_skyMesh->inDraw())
     {
         printf("Warning: aborting concurrent SkyMapComposite::draw()\n");
-        return;
+        return false;
     }
 
     m_skyMesh->inDraw(true);
     SkyPoint *focus = map->focus();
     m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
+    m_skyMesh->aperture(focus, radius + 1.0, STAR_DRAW_BUF);
 
-    // create the no-precess aperture if needed
-    if (Options::showEquatorialGrid() || Options::showHorizontalGrid() ||
-            Options::showEquator())
-    {
-        m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
-    }
+    // create the no-precess aperture, the equatorial grid and the equator
+    // only draw the lines in its trixels
+    m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
 
     // clear marks from old labels and prep fonts
     m_skyLabeler->reset(map);
@@ -307,102 +386,110 @@ void SkyMapComposite::draw(SkyPainter *skyp)
                 SkyLabeler::AddLabel(o, SkyLabeler::RUDE_LABEL);
             }
     }
+#endif
+    return true;
+}
+
+void SkyMapComposite::drawLayer(SkyPainter *skyp, SkyLayer layer)
+{
+    Q_UNUSED(skyp)
+#ifndef KSTARS_LITE
+    SkyMap *map      = SkyMap::Instance();
+    KStarsData *data = KStarsData::Instance();
 
-    m_MilkyWay->draw(skyp);
+    switch (layer)
+    {
+        case BACKGROUND_LAYER:
+            m_MilkyWay->draw(skyp);
 
-    // Draw HIPS after milky way but before everything else
-    m_HiPS->draw(skyp);
+            // Draw HIPS after milky way but before everything else
+            m_HiPS->draw(skyp);
 
-    if (Options::showImageOverlaysBelowCatalogs())
-        // Draw fits overlay.
-        m_ImageOverlay->draw(skyp);
+            if (Options::showImageOverlaysBelowCatalogs())
+                // Draw fits overlay.
+                m_ImageOverlay->draw(skyp);
 
-    m_EquatorialCoordinateGrid->draw(skyp);
-    m_HorizontalCoordinateGrid->draw(skyp);
-    m_LocalMeridianComponent->draw(skyp);
+            m_EquatorialCoordinateGrid->draw(skyp);
+            break;
 
-    //Draw constellation boundary lines only if we draw western constellations
-    if (m_Cultures->current() == "Western")
-    {
-        m_CBoundLines->draw(skyp);
-        m_ConstellationArt->draw(skyp);
-    }
-    else if (m_Cultures->current() == "Inuit")
-    {
-        m_ConstellationArt->draw(skyp);
-    }
+        case LOCAL_GRID_LAYER:
+            m_HorizontalCoordinateGrid->draw(skyp);
+            m_LocalMeridianComponent->draw(skyp);
+            break;
+
+        case CATALOG_LAYER:
+            //Draw constellation boundary lines only if we draw western constellations
+            if (m_Cultures->current() == "Western")
+            {
+                m_CBoundLines->draw(skyp);
+                m_ConstellationArt->draw(skyp);
+            }
+            else if (m_Cultures->current() == "Inuit")
+            {
+                m_ConstellationArt->draw(skyp);
+            }
 
-    m_CLines->draw(skyp);
+            m_CLines->draw(skyp);
 
-    m_Equator->draw(skyp);
+            m_Equator->draw(skyp);
 
-    m_Ecliptic->draw(skyp);
+            m_Ecliptic->draw(skyp);
 
-    m_Catalogs->draw(skyp);
+            m_Catalogs->draw(skyp);
+            break;
 
-    m_Stars->draw(skyp);
+        case STAR_LAYER:
+            m_Stars->draw(skyp);
+            break;
 
-    m_SolarSystem->drawTrails(skyp);
-    m_SolarSystem->draw(skyp);
+        case FOREGROUND_LAYER:
+            m_SolarSystem->drawTrails(skyp);
+            m_SolarSystem->draw(skyp);
 
-    m_Satellites->draw(skyp);
+            m_Satellites->draw(skyp);
 
-    m_Supernovae->draw(skyp);
+            m_Supernovae->draw(skyp);
 
-    map->drawObjectLabels(labelObjects());
+            map->drawObjectLabels(labelObjects());
 
-    m_skyLabeler->drawQueuedLabels();
-    m_CNames->draw(skyp);
-    m_Stars->drawLabels();
+            m_skyLabeler->drawQueuedLabels();
+            m_CNames->draw(skyp);
+            m_Stars->drawLabels();
 
-    m_ObservingList->pen =
-        QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
-    m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
-    m_ObservingList->draw(skyp);
+            m_ObservingList->pen =
+                QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
+            m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
+            m_ObservingList->draw(skyp);
 
-    m_Flags->draw(skyp);
+            m_Flags->draw(skyp);
 
-    m_StarHopRouteList->pen =
-        QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
-    m_StarHopRouteList->draw(skyp);
+            m_StarHopRouteList->pen =
+                QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
+            m_StarHopRouteList->draw(skyp);
 
-    if (!Options::showImageOverlaysBelowCatalogs())
-        // Draw fits overlay before mosaic and terrain/horizon, but after most things.
-        m_ImageOverlay->draw(skyp);
+            if (!Options::showImageOverlaysBelowCatalogs())
+                // Draw fits overlay before mosaic and terrain/horizon, but after most things.
+                m_ImageOverlay->draw(skyp);
 
 #ifdef HAVE_INDI
-    m_Mosaic->draw(skyp);
+            m_Mosaic->draw(skyp);
 #endif
 
-    m_ArtificialHorizon->draw(skyp);
+            m_ArtificialHorizon->draw(skyp);
 
-    m_Horizon->draw(skyp);
+            m_Horizon->draw(skyp);
 
-    m_skyMesh->inDraw(false);
+            m_skyMesh->inDraw(false);
 
-    // Draw terrain at the end.
-    m_Terrain->draw(skyp);
+            // Draw terrain at the end.
+            m_Terrain->draw(skyp);
+            break;
 
-    // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
-    // -jbb uncomment these to see trixel outlines:
-    /*
-        QPainter *psky = dynamic_cast< QPainter *>( skyp );
-        if( psky ) {
-            qCDebug(KSTARS) << "Drawing trixel boundaries for debugging.";
-            psky->setPen(  QPen( QBrush( QColor( "yellow" ) ), 1, Qt::SolidLine ) );
-            m_skyMesh->draw( *psky, OBJ_NEAREST_BUF );
-            SkyMesh *p;
-            if( p = SkyMesh::Instance( 6 ) ) {
-                qCDebug(KSTARS) << "We have a deep sky mesh to draw";
-                p->draw( *psky, OBJ_NEAREST_BUF );
-            }
-
-            psky->setPen( QPen( QBrush( QColor( "green" ) ), 1, Qt::SolidLine ) );
-            m_skyMesh->draw( *psky, NO_PRECESS_BUF );
-            if( p )
-                p->draw( *psky, NO_PRECESS_BUF );
-        }
-        */
+        default:
+            break;
+    }
+#else
+    Q_UNUSED(layer)
 #endif
 }
 
@@ -15,6 +15,7 @@
 #include "config-kstars.h"
 #include <QList>
 
+#include <functional>
 #include <memory>
 
 class QPolygonF;
@@ -112,6 +113,48 @@ class SkyMapComposite : public QObject, public SkyComposite
              */
         void draw(SkyPainter *skyp) override;
 
+        /**
+         * @short Layers of the sky map that can be drawn to separate devices, in the order they are stacked.
+         *
+         * Static layers only depend on the view and on the equinox of date, so while the view
+         * is fixed in equatorial coordinates their image can be kept as the clock runs.
+         */
+        enum SkyLayer
+        {
+            /** Milky Way, HiPS, image overlays below the catalogs and equatorial grid. Static. */
+            BACKGROUND_LAYER,
+            /** Horizontal grid and local meridian. */
+            LOCAL_GRID_LAYER,
+            /** Constellations, equator, ecliptic and deep-sky catalogs. Static. */
+            CATALOG_LAYER,
+            /** Stars. Static, star names are drawn with the labels of the foreground. */
+            STAR_LAYER,
+            /** Solar system, satellites, supernovae, labels, markers, horizon and terrain. */
+            FOREGROUND_LAYER,
+            NUM_SKY_LAYERS
+        };
+
+        static bool isStaticLayer(SkyLayer layer)
+        {
+            return layer == BACKGROUND_LAYER || layer == CATALOG_LAYER || layer == STAR_LAYER;
+        }
+
+        /**
+         * @short Draw the sky map layer by layer.
+         *
+         * Static layers are drawn first, so that the labels they place can be kept by the
+         * SkyLabeler and put back when the static layers are reused.
+         * @p skyp painter used for all layers
+         * @p redrawStatic if false the static layers are skipped, the caller reuses their last image
+         * @p selectLayer called before each layer is drawn to point skyp at the device of that layer
+         * @p starPainter if set, the stars are drawn with it on a worker thread while the other
+         * static layers are drawn with skyp. It must be active on a device of its own, e.g. a QImage.
+         * The stars do not share any state with the other static layers, they use the
+         * STAR_DRAW_BUF of the sky mesh and keep their labels until the foreground is drawn.
+         */
+        void drawLayers(SkyPainter *skyp, bool redrawStatic, const std::function<void(SkyLayer)> &selectLayer,
+                        SkyPainter *starPainter = nullptr);
+
         /**
              * @return the object nearest a given point in the sky.
              * @param p The point to find an object near
@@ -273,6 +316,10 @@ class SkyMapComposite : public QObject, public SkyComposite
         void progressText(const QString &message);
 
     private:
+        /** Set up the aperture and the labeler for a draw cycle. Returns false if a draw is already running. */
+        bool beginDraw();
+        void drawLayer(SkyPainter *skyp, SkyLayer layer);
+
         QHash<int, QStringList> &getObjectNames() override;
         QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists() override;
 
@@ -15,6 +15,7 @@
 #include "projections/projector.h"
 #include "skyobjects/starobject.h"
 
+#include <QMutexLocker>
 #include <QPainter>
 #include <QPolygonF>
 #include <QPointF>
@@ -56,9 +57,19 @@ SkyMesh::SkyMesh(int level)
 void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
 {
     KStarsData *data = KStarsData::Instance();
+    long double now  = data->updateNum()->julianDay();
+    double ra        = p0->ra().Degrees();
+    double dec       = p0->dec().Degrees();
+
+    MeshBuffer *buffer = meshBuffer((BufNum)bufNum);
+    if (buffer != nullptr && copyAperture(ra, dec, radius, now, buffer))
+    {
+        m_drawID++;
+        return;
+    }
+
     // FIXME: simple copying leads to incorrect results because RA0 && dec0 are both zero sometimes
     SkyPoint p1(p0->ra(), p0->dec());
-    long double now = data->updateNum()->julianDay();
     p1.catalogueCoord(now);
 
     if (radius == 1.0)
@@ -68,9 +79,49 @@ void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
     }
 
     HTMesh::intersect(p1.ra().Degrees(), p1.dec().Degrees(), radius, (BufNum)bufNum);
+    if (buffer != nullptr)
+        keepAperture(ra, dec, radius, now, buffer);
     m_drawID++;
 }
 
+bool SkyMesh::copyAperture(double ra, double dec, double radius, long double jd, MeshBuffer *buffer)
+{
+    QMutexLocker locker(&m_apertureMutex);
+
+    for (ApertureCover &cover : m_apertures)
+    {
+        if (cover.ra != ra || cover.dec != dec || cover.radius != radius || cover.jd != jd)
+            continue;
+
+        buffer->reset();
+        for (Trixel trixel : cover.trixels)
+            buffer->append(trixel);
+        cover.lastUsed = ++m_apertureUses;
+        return true;
+    }
+
+    return false;
+}
+
+void SkyMesh::keepAperture(double ra, double dec, double radius, long double jd, const MeshBuffer *buffer)
+{
+    QMutexLocker locker(&m_apertureMutex);
+
+    ApertureCover *cover = &m_apertures[0];
+    for (ApertureCover &other : m_apertures)
+    {
+        if (other.lastUsed < cover->lastUsed)
+            cover = &other;
+    }
+
+    cover->ra       = ra;
+    cover->dec      = dec;
+    cover->radius   = radius;
+    cover->jd       = jd;
+    cover->lastUsed = ++m_apertureUses;
+    cover->trixels.assign(buffer->buffer(), buffer->buffer() + buffer->size());
+}
+
 Trixel SkyMesh::index(const SkyPoint *p)
 {
     return HTMesh::index(p->ra0().Degrees(), p->dec0().Degrees());
@@ -133,6 +184,7 @@ const IndexHash &SkyMesh::indexStarLine(SkyList *points)
     SkyPoint *pThis, *pLast;
 
     indexHash.clear();
+    segmentHash.clear();
 
     if (points->isEmpty())
         return indexHash;
@@ -147,7 +199,9 @@ const IndexHash &SkyMesh::indexStarLine(SkyList *points)
 
         while (region.hasNext())
         {
-            indexHash[region.next()] = true;
+            Trixel trixel = region.next();
+            indexHash[trixel] = true;
+            segmentHash[trixel].append(i);
         }
         pLast = pThis;
     }
@@ -159,6 +213,7 @@ const IndexHash &SkyMesh::indexLine(SkyList *points, IndexHash *skip)
     SkyPoint *pThis, *pLast;
 
     indexHash.clear();
+    segmentHash.clear();
 
     if (points->isEmpty())
         return indexHash;
@@ -191,7 +246,9 @@ const IndexHash &SkyMesh::indexLine(SkyList *points, IndexHash *skip)
         {
             while (region.hasNext())
             {
-                indexHash[region.next()] = true;
+                Trixel trixel = region.next();
+                indexHash[trixel] = true;
+                segmentHash[trixel].append(i);
             }
         }
         pLast = pThis;
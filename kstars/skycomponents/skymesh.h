@@ -11,12 +11,17 @@
 #include "htmesh/HTMesh.h"
 
 #include <QMap>
+#include <QMutex>
+
+#include <atomic>
+#include <vector>
 
 class QPainter;
 class QPointF;
 class QPolygonF;
 
 class KSNumbers;
+class MeshBuffer;
 class SkyPoint;
 class StarObject;
 
@@ -33,6 +38,7 @@ enum MeshBufNum_t
     NO_PRECESS_BUF  = 1,
     OBJ_NEAREST_BUF = 2,
     IN_CONSTELL_BUF = 3,
+    STAR_DRAW_BUF   = 4, // the stars may be drawn on a thread of their own
     NUM_MESH_BUF
 };
 
@@ -107,6 +113,10 @@ class SkyMesh : public HTMesh
          * drawing extended objects.  Typically a safety factor of about one
          * degree is added to the radius to account for proper motion,
          * refraction and other imperfections.
+         *
+         * Several components ask for the same aperture in every draw, so the
+         * last few apertures are kept and copied into the buffer when the
+         * same center, radius and time come up again.
          *@param center Center of the aperture
          *@param radius Radius of the aperture in degrees
          *@param bufNum Buffer to use
@@ -247,6 +257,12 @@ class SkyMesh : public HTMesh
          */
     const IndexHash &indexPoly(const QPolygonF *points);
 
+    /** @short returns, for each trixel found by the last indexLine() or
+         * indexStarLine(), the line segments that cross it.  Segment i joins
+         * points i - 1 and i.
+         */
+    const SegmentHash &lineSegments() const { return segmentHash; }
+
     /** @}*/
 
     /** @short Returns the debug level.  This is used as a global debug level
@@ -283,14 +299,42 @@ class SkyMesh : public HTMesh
     void inDraw(bool inDraw) { m_inDraw = inDraw; }
 
   private:
-    DrawID m_drawID;
+    struct ApertureCover
+    {
+        double ra { 0 };
+        double dec { 0 };
+        double radius { -1 };
+        long double jd { 0 };
+        quint64 lastUsed { 0 };
+        std::vector<Trixel> trixels;
+    };
+
+    /** @short copies the trixels of a kept aperture into buffer.
+         * @return false if the aperture is not kept
+         */
+    bool copyAperture(double ra, double dec, double radius, long double jd, MeshBuffer *buffer);
+
+    /** @short keeps the aperture found in buffer in place of the least
+         * recently used one.
+         */
+    void keepAperture(double ra, double dec, double radius, long double jd, const MeshBuffer *buffer);
+
+    // The stars may be drawn on a thread of their own while the rest of the sky is drawn.
+    std::atomic<DrawID> m_drawID;
     int errLimit { 0 };
     int m_debug { 0 };
 
     IndexHash indexHash;
+    SegmentHash segmentHash;
     KSNumbers m_KSNumbers;
 
-    bool m_inDraw { false };
+    std::atomic<bool> m_inDraw { false };
+
+    // One for the draw, one for objectNearest() and some to spare
+    static const int NUM_APERTURES = 4;
+    ApertureCover m_apertures[NUM_APERTURES];
+    quint64 m_apertureUses { 0 };
+    QMutex m_apertureMutex;
     static int defaultLevel;
     static QMap<int, SkyMesh *> pinstances;
 };
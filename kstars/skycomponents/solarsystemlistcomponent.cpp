@@ -7,24 +7,33 @@
 #include "solarsystemlistcomponent.h"
 
 #include "kstarsdata.h"
+#include "ksnumbers.h"
 #include "Options.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
 #include "solarsystemcomposite.h"
+#include "skyobjects/ksasteroid.h"
+#include "skyobjects/kscomet.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/ksplanetbase.h"
+#include "skyobjects/kssun.h"
 
 #include <KLocalizedString>
 
 #include <QPen>
+#include <QVector>
+#include <QtConcurrent>
 
-SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p) : ListComponent(p), m_Earth(p->earth())
+SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p)
+    : ListComponent(p), m_Earth(p->earth()), m_Sun(p->sun())
 {
 }
 
 SolarSystemListComponent::~SolarSystemListComponent()
 {
+    cancelUpdate();
+    delete m_UpdateWatcher;
     //Object deletes handled by parent class (ListComponent)
 }
 
@@ -49,18 +58,147 @@ void SolarSystemListComponent::updateSolarSystemBodies(KSNumbers *num)
     if (selected())
     {
         KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *o, m_ObjectList)
+        const CachingDms *lat = data->geo()->lat();
+        const CachingDms *lst = data->lst();
+
+        QVector<KSPlanetBase *> bodies, trailBodies;
+        sortBodies(&bodies, &trailBodies);
+
+        // Trails format dates and translated strings, they are kept on this thread.
+        for (KSPlanetBase *p : trailBodies)
         {
-            KSPlanetBase *p = (KSPlanetBase *)o;
-            p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
-            p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+            p->findPosition(num, lat, lst, m_Earth);
+            p->EquatorialToHorizontal(lst, lat);
+            p->updateTrail(lst, lat);
+        }
+
+        if (bodies.isEmpty())
+            return;
 
-            if (p->hasTrail())
-                p->updateTrail(data->lst(), data->geo()->lat());
+        // Catch up with the latest epoch once the running update is published.
+        if (m_UpdateWatcher && m_UpdateWatcher->isRunning())
+        {
+            m_PendingNum.reset(new KSNumbers(*num));
+            return;
         }
+
+        startUpdate(num, bodies);
     }
 }
 
+void SolarSystemListComponent::sortBodies(QVector<KSPlanetBase *> *bodies, QVector<KSPlanetBase *> *trailBodies) const
+{
+    // Sort out the bodies that need work before touching any orbit. Asteroids below the
+    // magnitude limit are skipped entirely, which for the full JPL catalog is most of them.
+    bodies->reserve(m_ObjectList.size());
+    for (SkyObject *o : m_ObjectList)
+    {
+        KSPlanetBase *p = static_cast<KSPlanetBase *>(o);
+
+        if (o->type() == SkyObject::ASTEROID && !static_cast<KSAsteroid *>(p)->toCalculate())
+            continue;
+
+        if (!p->hasTrail())
+            bodies->append(p);
+        else if (trailBodies)
+            trailBodies->append(p);
+    }
+}
+
+void SolarSystemListComponent::startUpdate(KSNumbers *num, const QVector<KSPlanetBase *> &bodies)
+{
+    // Shadows are kept from one update to the next, only bodies that just became visible need one.
+    QHash<KSPlanetBase *, KSPlanetBase *> shadows;
+    shadows.reserve(bodies.size());
+    m_Updating.clear();
+    m_Updating.reserve(bodies.size());
+    for (KSPlanetBase *p : bodies)
+    {
+        KSPlanetBase *shadow = m_Shadows.take(p);
+        if (shadow == nullptr)
+            shadow = static_cast<KSPlanetBase *>(p->clone());
+        shadows.insert(p, shadow);
+        m_Updating.append(qMakePair(p, shadow));
+    }
+    qDeleteAll(m_Shadows);
+    m_Shadows = shadows;
+
+    // The workers must not read the Earth and the Sun while the GUI thread updates them.
+    m_EarthSnapshot.reset(m_Earth->clone());
+    m_SunSnapshot.reset(Options::useRelativistic() ? m_Sun->clone() : nullptr);
+
+    if (m_UpdateWatcher == nullptr)
+    {
+        m_UpdateWatcher = new QFutureWatcher<void>();
+        QObject::connect(m_UpdateWatcher, &QFutureWatcher<void>::finished, KStarsData::Instance(), [this]()
+        {
+            publishUpdate();
+        });
+    }
+
+    KStarsData *data = KStarsData::Instance();
+    const QVector<QPair<KSPlanetBase *, KSPlanetBase *>> updating = m_Updating;
+    const KSPlanet *earth = m_EarthSnapshot.get();
+    const KSSun *sun = m_SunSnapshot.get();
+    const KSNumbers epoch(*num);
+    const CachingDms lat(*data->geo()->lat());
+    const CachingDms lst(*data->lst());
+    m_UpdateWatcher->setFuture(QtConcurrent::run([updating, earth, sun, epoch, lat, lst]()
+    {
+        // Every shadow only writes to itself. Its position and phase are found with the
+        // Earth snapshot, light is bent around the Sun snapshot.
+        QtConcurrent::blockingMap(updating, [&](const QPair<KSPlanetBase *, KSPlanetBase *> &body)
+        {
+            SkyPoint::setBendLightSun(sun);
+            body.second->findPosition(&epoch, &lat, &lst, earth);
+            body.second->EquatorialToHorizontal(&lst, &lat);
+            SkyPoint::setBendLightSun(nullptr);
+        });
+    }));
+}
+
+void SolarSystemListComponent::publishUpdate()
+{
+    if (m_Updating.isEmpty())
+        return;
+
+    for (const auto &body : qAsConst(m_Updating))
+    {
+        // A trail was added meanwhile, the body is updated along with its trail from now on.
+        if (body.first->hasTrail())
+            continue;
+
+        if (body.first->type() == SkyObject::ASTEROID)
+            *static_cast<KSAsteroid *>(body.first) = *static_cast<const KSAsteroid *>(body.second);
+        else if (body.first->type() == SkyObject::COMET)
+            *static_cast<KSComet *>(body.first) = *static_cast<const KSComet *>(body.second);
+    }
+    m_Updating.clear();
+
+    KStarsData::Instance()->publishSkyUpdate();
+
+    // The bodies with a trail are at the pending epoch already.
+    if (m_PendingNum)
+    {
+        std::unique_ptr<KSNumbers> num = std::move(m_PendingNum);
+        QVector<KSPlanetBase *> bodies;
+        if (selected())
+            sortBodies(&bodies);
+        if (!bodies.isEmpty())
+            startUpdate(num.get(), bodies);
+    }
+}
+
+void SolarSystemListComponent::cancelUpdate()
+{
+    if (m_UpdateWatcher)
+        m_UpdateWatcher->waitForFinished();
+    m_Updating.clear();
+    m_PendingNum.reset();
+    qDeleteAll(m_Shadows);
+    m_Shadows.clear();
+}
+
 void SolarSystemListComponent::drawTrails(SkyPainter *skyp)
 {
     //FIXME: here for all objects trails are drawn this could be source of inefficiency
@@ -8,12 +8,30 @@
 
 #include "listcomponent.h"
 
+#include <QFutureWatcher>
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+#include <memory>
+
+class KSNumbers;
 class KSPlanet;
+class KSPlanetBase;
+class KSSun;
 class SolarSystemComposite;
 
 /**
  * @class SolarSystemListComponent
  *
+ * Asteroids and comets are propagated on worker threads, so that the clock tick and the
+ * sky map never wait for the ephemeris of thousands of bodies. Each body has a shadow copy
+ * that the workers compute the new epoch into. Once all are done, the shadows are copied
+ * over the bodies on the GUI thread in one go and a redraw is requested, so a frame never
+ * shows a half updated list. Updates requested while one is still running are coalesced
+ * into a single update to the latest epoch. Bodies with a trail are still updated on the
+ * GUI thread, since their trail is updated along with them.
+ *
  * @author Jason Harris
  * @version 1.0
  */
@@ -38,6 +56,28 @@ class SolarSystemListComponent : public ListComponent
   protected:
     void drawTrails(SkyPainter *skyp) override;
 
+    /**
+     * @short Wait for a running background update and drop its results.
+     *
+     * Must be called before bodies are deleted, e.g. before reloading the list.
+     */
+    void cancelUpdate();
+
   private:
+    /** @short Collect the bodies to update in the background and, if given, those with a trail. */
+    void sortBodies(QVector<KSPlanetBase *> *bodies, QVector<KSPlanetBase *> *trailBodies = nullptr) const;
+    void startUpdate(KSNumbers *num, const QVector<KSPlanetBase *> &bodies);
+    void publishUpdate();
+
     KSPlanet *m_Earth { nullptr };
+    KSSun *m_Sun { nullptr };
+
+    // Background update: the bodies being updated paired with their shadow copies.
+    QFutureWatcher<void> *m_UpdateWatcher { nullptr };
+    QHash<KSPlanetBase *, KSPlanetBase *> m_Shadows;
+    QVector<QPair<KSPlanetBase *, KSPlanetBase *>> m_Updating;
+    std::unique_ptr<KSPlanet> m_EarthSnapshot;
+    std::unique_ptr<KSSun> m_SunSnapshot;
+    // Latest epoch requested while an update was running.
+    std::unique_ptr<KSNumbers> m_PendingNum;
 };
@@ -251,6 +251,11 @@ float StarComponent::zoomMagnitudeLimit()
 void StarComponent::draw(SkyPainter *skyp)
 {
 #ifndef KSTARS_LITE
+    // Labels are kept until the next draw, the sky map may draw them again without
+    // drawing the stars when it reuses the image of the star layer.
+    for (auto &list : m_labelList)
+        list->clear();
+
     if (!selected())
         return;
 
@@ -301,7 +306,7 @@ void StarComponent::draw(SkyPainter *skyp)
 
     //Loop for drawing star images
 
-    MeshIterator region(m_skyMesh, DRAW_BUF);
+    MeshIterator region(m_skyMesh, STAR_DRAW_BUF);
     magLim = maglim;
 
     // If we are hiding faint stars, then maglim is really the brighter of hideStarsMag and maglim
@@ -391,7 +396,6 @@ void StarComponent::drawLabels()
         {
             labeler->drawNameLabel(item.obj, item.o);
         }
-        list->clear();
     }
 }
 
@@ -47,6 +47,7 @@ typedef unsigned short BufNum;
 
 typedef QVector<std::shared_ptr<SkyPoint>> SkyList;
 typedef QHash<Trixel, bool> IndexHash;
+typedef QHash<Trixel, QVector<int>> SegmentHash;
 typedef QHash<Trixel, bool> SkyRegion;
 typedef QList<StarObject *> StarList;
 typedef QVector<StarList *> StarIndex;
@@ -464,9 +464,9 @@ void SkyMap::slotUpdateSky(bool now)
     if (now)
         QTimer::singleShot(
             0, this,
-            SLOT(forceUpdateNow())); // Why is it done this way rather than just calling forceUpdateNow()? -- asimha // --> Opening a neww thread? -- Valentin
+            SLOT(forceTimeUpdateNow())); // Why is it done this way rather than just calling forceUpdateNow()? -- asimha // --> Opening a neww thread? -- Valentin
     else
-        forceUpdate();
+        forceTimeUpdate();
 }
 
 void SkyMap::slotDSS()
@@ -1182,6 +1182,12 @@ void SkyMap::setZoomFactor(double factor)
 // if now=true, SkyMap::paintEvent() is run immediately, rather than being added to the event queue
 // also, determine new coordinates of mouse cursor.
 void SkyMap::forceUpdate(bool now)
+{
+    computeStaticLayers = true;
+    forceTimeUpdate(now);
+}
+
+void SkyMap::forceTimeUpdate(bool now)
 {
     QPoint mp(mapFromGlobal(QCursor::pos()));
     if (!projector()->unusablePoint(mp))
@@ -380,9 +380,23 @@ class SkyMap : public QGraphicsView
             forceUpdate(true);
         }
 
+        /** Like forceUpdate(), for updates that only reflect the passing of time.
+             * Layers of the sky map that do not change with time may be reused if the view did not change.
+             * @param now if true, paintEvent() is run immediately.  Otherwise, it is added to the event queue
+             */
+        void forceTimeUpdate(bool now = false);
+
+        /** @short Convenience function; simply calls forceTimeUpdate(true).
+             * @see forceTimeUpdate()
+             */
+        void forceTimeUpdateNow()
+        {
+            forceTimeUpdate(true);
+        }
+
         /**
-             * @short Update the focus point and call forceUpdate()
-             * @param now is passed on to forceUpdate()
+             * @short Update the focus point and call forceTimeUpdate()
+             * @param now is passed on to forceTimeUpdate()
              */
         void slotUpdateSky(bool now);
 
@@ -726,6 +740,9 @@ class SkyMap : public QGraphicsView
         //if false only old pixmap will repainted with bitBlt(), this
         // saves a lot of cpu usage
         bool computeSkymap { false };
+        // if false the layers of the sky map that do not change with time may be reused,
+        // only forceUpdate() sets it
+        bool computeStaticLayers { true };
         // True if we are either looking for angular distance or star hopping directions
         bool rulerMode { false };
         // True only if we are looking for star hopping directions. If
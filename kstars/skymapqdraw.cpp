@@ -8,15 +8,20 @@
 #include "skymapcomposite.h"
 #include "skyqpainter.h"
 #include "skymap.h"
+#include "Options.h"
+#include "hips/hipsmanager.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
 #include "kstars_debug.h"
 #include <QPainterPath>
 
+#include <cmath>
+
 SkyMapQDraw::SkyMapQDraw(SkyMap *sm) : QWidget(sm), SkyMapDrawAbstract(sm)
 {
     m_SkyPixmap = new QPixmap(width(), height());
     m_SkyPainter.reset(new SkyQPainter(this, m_SkyPixmap));
+    m_StarPainter.reset(new SkyQPainter(this, m_SkyPixmap));
 }
 
 SkyMapQDraw::~SkyMapQDraw()
@@ -60,6 +65,55 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     m_SkyMap->updateInfoBoxes();
     m_SkyMap->setupProjector();
 
+    // Layers only pay off if the view stays the same for the next update as well,
+    // draw in one pass as long as it keeps changing.
+    const LayerKey key = layerKey();
+    const bool fixedView = !Options::useAltAz() && sameView(key, m_LayerKey);
+    if (m_SkyMap->computeStaticLayers || !fixedView || groundMoved(key))
+        m_StaticLayersValid = false;
+    m_SkyMap->computeStaticLayers = false;
+    m_LayerKey = key;
+
+    if (fixedView)
+    {
+        if (!m_StaticLayersValid)
+            m_StaticLST = key.lst;
+        drawSkyLayers(!m_StaticLayersValid);
+    }
+    else
+    {
+        m_Layers.clear();
+        drawSky();
+    }
+
+    QPainter psky2;
+    psky2.begin(this);
+    psky2.drawLine(0, 0, 1, 1); // Dummy op.
+    psky2.drawPixmap(0, 0, *m_SkyPixmap);
+    drawOverlays(psky2);
+    psky2.end();
+
+    if (m_SkyMap->m_previewLegend)
+    {
+        m_SkyMap->m_legend.paintLegend(m_SkyPixmap);
+    }
+
+    m_SkyMap->computeSkymap = false; // use forceUpdate() to compute new skymap else old pixmap will be shown
+
+    setDrawLock(false);
+}
+
+void SkyMapQDraw::resizeEvent(QResizeEvent *e)
+{
+    Q_UNUSED(e)
+    delete m_SkyPixmap;
+    m_SkyPixmap = new QPixmap(width(), height());
+    m_Layers.clear();
+    m_StaticLayersValid = false;
+}
+
+void SkyMapQDraw::drawSky()
+{
     m_SkyPixmap->fill(Qt::black);
     m_SkyPainter->setPaintDevice(m_SkyPixmap);
     m_SkyPainter->setSize(m_SkyPixmap->width(), m_SkyPixmap->height());
@@ -80,27 +134,114 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     m_KStarsData->skyComposite()->draw(m_SkyPainter.data());
     //Finish up
     m_SkyPainter->end();
+}
 
-    QPainter psky2;
-    psky2.begin(this);
-    psky2.drawLine(0, 0, 1, 1); // Dummy op.
-    psky2.drawPixmap(0, 0, *m_SkyPixmap);
-    drawOverlays(psky2);
-    psky2.end();
+void SkyMapQDraw::drawSkyLayers(bool redrawStatic)
+{
+    const QSize size = m_SkyPixmap->size();
+    if (m_Layers.size() != SkyMapComposite::NUM_SKY_LAYERS || m_Layers.first().size() != size)
+    {
+        m_Layers.fill(QImage(), SkyMapComposite::NUM_SKY_LAYERS);
+        for (auto &layer : m_Layers)
+            layer = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        redrawStatic = true;
+    }
 
-    if (m_SkyMap->m_previewLegend)
+    for (int i = 0; i < m_Layers.size(); i++)
     {
-        m_SkyMap->m_legend.paintLegend(m_SkyPixmap);
+        if (redrawStatic || !SkyMapComposite::isStaticLayer(static_cast<SkyMapComposite::SkyLayer>(i)))
+            m_Layers[i].fill(Qt::transparent);
     }
 
-    m_SkyMap->computeSkymap = false; // use forceUpdate() to compute new skymap else old pixmap will be shown
+    m_SkyPainter->setSize(size.width(), size.height());
 
-    setDrawLock(false);
+    QPainterPath path;
+    path.addPolygon(m_SkyMap->projector()->clipPoly());
+
+    // The stars are drawn on a worker thread, to an image of their own, while the GUI thread
+    // draws the other static layers.
+    SkyQPainter *starPainter = nullptr;
+    if (redrawStatic && Options::parallelSkyLayers())
+    {
+        starPainter = m_StarPainter.data();
+        starPainter->setPaintDevice(&m_Layers[SkyMapComposite::STAR_LAYER]);
+        starPainter->setSize(size.width(), size.height());
+        starPainter->begin();
+        starPainter->setClipPath(path);
+        starPainter->setClipping(true);
+    }
+
+    m_KStarsData->skyComposite()->drawLayers(m_SkyPainter.data(), redrawStatic,
+            [&](SkyMapComposite::SkyLayer layer)
+    {
+        if (m_SkyPainter->isActive())
+            m_SkyPainter->end();
+        m_SkyPainter->setPaintDevice(&m_Layers[layer]);
+        m_SkyPainter->begin();
+        m_SkyPainter->setClipPath(path);
+        m_SkyPainter->setClipping(true);
+        if (layer == SkyMapComposite::BACKGROUND_LAYER)
+            m_SkyPainter->drawSkyBackground();
+    }, starPainter);
+
+    if (m_SkyPainter->isActive())
+        m_SkyPainter->end();
+    if (starPainter)
+        starPainter->end();
+
+    if (redrawStatic)
+        m_StaticLayerRedraws++;
+    else
+        m_StaticLayerReuses++;
+    m_StaticLayersValid = true;
+
+    m_SkyPixmap->fill(Qt::black);
+    QPainter p(m_SkyPixmap);
+    for (const auto &layer : qAsConst(m_Layers))
+        p.drawImage(0, 0, layer);
 }
 
-void SkyMapQDraw::resizeEvent(QResizeEvent *e)
+SkyMapQDraw::LayerKey SkyMapQDraw::layerKey() const
 {
-    Q_UNUSED(e)
-    delete m_SkyPixmap;
-    m_SkyPixmap = new QPixmap(width(), height());
+    const Projector *proj = m_SkyMap->projector();
+    const ViewParams vp   = proj->viewParams();
+
+    LayerKey key;
+    key.focusRA     = vp.focus->ra().Degrees();
+    key.focusDec    = vp.focus->dec().Degrees();
+    key.zoomFactor  = vp.zoomFactor;
+    key.rotation    = vp.rotationAngle.Degrees();
+    key.latitude    = m_KStarsData->geo()->lat()->Degrees();
+    key.lst         = m_KStarsData->lst()->radians();
+    key.width       = width();
+    key.height      = height();
+    key.projection  = proj->type();
+    key.mirror      = vp.mirror;
+    key.fillGround  = vp.fillGround;
+    key.slewing     = m_SkyMap->isSlewing();
+    key.updateNumID = m_KStarsData->updateNumID();
+    key.hipsTiles   = Options::showHIPS() ? HIPSManager::Instance()->getTileGeneration() : 0;
+    return key;
+}
+
+bool SkyMapQDraw::sameView(const LayerKey &a, const LayerKey &b) const
+{
+    return a.focusRA == b.focusRA && a.focusDec == b.focusDec && a.zoomFactor == b.zoomFactor &&
+           a.rotation == b.rotation && a.latitude == b.latitude && a.width == b.width &&
+           a.height == b.height && a.projection == b.projection && a.mirror == b.mirror &&
+           a.fillGround == b.fillGround && a.slewing == b.slewing && a.updateNumID == b.updateNumID &&
+           a.hipsTiles == b.hipsTiles;
+}
+
+bool SkyMapQDraw::groundMoved(const LayerKey &key) const
+{
+    // Objects below the horizon are skipped when the ground is filled, so objects that rise
+    // must show up within a pixel. Otherwise the static layers do not depend on time.
+    if (!key.fillGround)
+        return false;
+
+    double delta = std::abs(key.lst - m_StaticLST);
+    if (delta > M_PI)
+        delta = 2 * M_PI - delta;
+    return delta * key.zoomFactor >= 1.0;
 }
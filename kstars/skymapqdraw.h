@@ -9,11 +9,25 @@
 
 #include "skymapdrawabstract.h"
 
+#include <QImage>
+#include <QVector>
 #include <QWidget>
 
 /**
  *@short This class draws the SkyMap using native QPainter. It
  * implements SkyMapDrawAbstract
+ *
+ * While the view stays fixed in equatorial coordinates, the sky is drawn in the layers of
+ * SkyMapComposite::SkyLayer, each to an image of its own. Updates caused by the running
+ * clock (SkyMap::forceTimeUpdate()) then only redraw the layers that change with time and
+ * composite them over the kept images of the static layers. Any other update, a change of
+ * the view, of the equinox of date or newly loaded HiPS tiles redraw all layers. While the
+ * view keeps changing, e.g. when slewing or in horizontal coordinates, the sky is drawn
+ * straight to a single pixmap as layers would not be reused anyway.
+ *
+ * When the static layers are redrawn, the star layer is drawn on a worker thread with a
+ * painter of its own while the other static layers are drawn on the GUI thread
+ * (Options::parallelSkyLayers()). Labels are still placed in the usual order with the foreground.
  *@version 1.0
  *@author Akarsh Simha <akarsh.simha@kdemail.net>
  */
@@ -33,6 +47,12 @@ class SkyMapQDraw : public QWidget, public SkyMapDrawAbstract
          */
     ~SkyMapQDraw() override;
 
+    /** @return how many times the static layers were drawn since the sky map was created */
+    int staticLayerRedraws() const { return m_StaticLayerRedraws; }
+
+    /** @return how many times the images of the static layers were reused */
+    int staticLayerReuses() const { return m_StaticLayerReuses; }
+
   protected:
     void paintEvent(QPaintEvent *e) override;
 
@@ -41,6 +61,46 @@ class SkyMapQDraw : public QWidget, public SkyMapDrawAbstract
     QPixmap *m_SkyPixmap;
 
     QScopedPointer<SkyQPainter> m_SkyPainter;
+
+    /** Draws the star layer on a worker thread */
+    QScopedPointer<SkyQPainter> m_StarPainter;
+
+  private:
+    /** Everything the image of the static layers depends on, apart from explicit updates */
+    struct LayerKey
+    {
+        double focusRA { 0 };
+        double focusDec { 0 };
+        double zoomFactor { 0 };
+        double rotation { 0 };
+        double latitude { 0 };
+        double lst { 0 };
+        int width { 0 };
+        int height { 0 };
+        int projection { -1 };
+        bool mirror { false };
+        bool fillGround { false };
+        bool slewing { false };
+        unsigned int updateNumID { 0 };
+        quint64 hipsTiles { 0 };
+    };
+
+    LayerKey layerKey() const;
+    bool sameView(const LayerKey &a, const LayerKey &b) const;
+    /** True if the horizon moved by a pixel or more since the static layers were drawn */
+    bool groundMoved(const LayerKey &key) const;
+
+    /** Draw all of the sky to m_SkyPixmap in one pass */
+    void drawSky();
+    /** Draw the sky layer by layer and composite the layers to m_SkyPixmap */
+    void drawSkyLayers(bool redrawStatic);
+
+    QVector<QImage> m_Layers;
+    LayerKey m_LayerKey;
+    double m_StaticLST { 0 };
+    bool m_StaticLayersValid { false };
+    int m_StaticLayerRedraws { 0 };
+    int m_StaticLayerReuses { 0 };
 };
 
 #endif
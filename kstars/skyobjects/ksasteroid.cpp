@@ -24,11 +24,27 @@ KSAsteroid::KSAsteroid(int _catN, const QString &s, const QString &imfile, long
     : KSPlanetBase(s, imfile), catN(_catN), JD(_JD), a(_a), e(_e), i(_i), w(_w), M(_M), N(_Node), H(_H), G(_G)
 {
     setType(SkyObject::ASTEROID);
-    setMag(H);
+    setMag(brightestMagnitude());
     //Compute the orbital Period from Kepler's 3rd law:
     P = 365.2568984 * pow(a, 1.5); //period in days
 }
 
+double KSAsteroid::brightestMagnitude() const
+{
+    // Earth is never further than its aphelion from the Sun and the asteroid never closer than
+    // its perihelion, so for orbits that stay outside the Earth's we have
+    // rsun * rearth >= q * (q - Q_earth). The phase term only makes the asteroid fainter as
+    // long as G is within [0, 1]. This bound does not depend on time, it lets toCalculate()
+    // reject most of the catalog before a single position has been computed.
+    const double earthAphelion = 1.0167;
+    const double perihelion    = a * (1.0 - e);
+
+    if (e >= 1.0 || perihelion <= earthAphelion || G < 0.0 || G > 1.0)
+        return H;
+
+    return H + 5.0 * log10(perihelion * (perihelion - earthAphelion));
+}
+
 KSAsteroid *KSAsteroid::clone() const
 {
     Q_ASSERT(typeid(this) ==
@@ -140,7 +156,10 @@ bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase
     // So we have to precess as well
     setRA0(ra());
     setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
+    if (num->julianDay() == lastPrecessJD)
+        apparentCoord(J2000, num);
+    else
+        apparentCoord(J2000, lastPrecessJD);
     //nutate(num);
     //aberrate(num);
 
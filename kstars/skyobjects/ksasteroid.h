@@ -193,6 +193,13 @@ class KSAsteroid : public KSPlanetBase
      */
     bool toCalculate();
 
+    /**
+     * @brief brightestMagnitude
+     * @return the brightest magnitude the asteroid can reach seen from Earth, or H
+     * if the orbit comes close enough to the Earth's for no useful bound to exist.
+     */
+    double brightestMagnitude() const;
+
   protected:
     /** Calculate the geocentric RA, Dec coordinates of the Asteroid.
         	*@note reimplemented from KSPlanetBase
@@ -288,7 +288,10 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     // So we have to precess as well
     setRA0(ra());
     setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
+    if (num->julianDay() == lastPrecessJD)
+        apparentCoord(J2000, num);
+    else
+        apparentCoord(J2000, lastPrecessJD);
     findPhysicalParameters();
 
     return true;
@@ -113,6 +113,7 @@ void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, con
     lastPrecessJD = num->julianDay();
 
     findGeocentricPosition(num, Earth); //private function, reimplemented in each subclass
+    EarthRsun = Earth ? Earth->rsun() : NaN::d;
     findPhase();
     setAngularSize(findAngularSize()); //angular size in arcmin
 
@@ -287,7 +288,8 @@ void KSPlanetBase::findPhase()
         return;
     }
     /* Compute the phase of the planet in degrees */
-    double earthSun = KStarsData::Instance()->skyComposite()->earth()->rsun();
+    // The Earth the position was found with, which need not be the one of the sky composite
+    double earthSun = std::isfinite(EarthRsun) ? EarthRsun : KStarsData::Instance()->skyComposite()->earth()->rsun();
     double cosPhase = (rsun() * rsun() + rearth() * rearth() - earthSun * earthSun) / (2 * rsun() * rearth());
 
     Phase           = acos(cosPhase) * 180.0 / dms::PI;
@@ -258,6 +258,8 @@ class KSPlanetBase : public TrailObject
     EclipticPosition helEcPos;
     double Rearth {NaN::d};
     double Phase {NaN::d};
+    // Distance of the Earth given to findPosition() from the Sun, used by findPhase().
+    double EarthRsun {NaN::d};
     QImage m_image;
 
   private:
@@ -48,6 +48,7 @@ double SkyPoint::cpuTime_EqToHz     = 0.;
 #endif
 
 KSSun *SkyPoint::m_Sun         = nullptr;
+thread_local const KSSun *SkyPoint::m_ThreadSun = nullptr;
 const double SkyPoint::altCrit = -1.0;
 
 SkyPoint::SkyPoint()
@@ -424,22 +425,36 @@ bool SkyPoint::checkBendLight()
     // 0.06".  Assuming min. sun-earth distance is 200 solar radii.
     static const dms maxAngle(1.75 * (30.0 / 200.0) / dms::DegToRad);
 
+    const KSSun *sun = bendLightSun();
+    if (sun == nullptr)
+        return false;
+
+    // TODO: This can be optimized further. We only need a ballpark estimate of the distance to the sun to start with.
+    return (fabs(angularDistanceTo(static_cast<const SkyPoint *>(sun)).Degrees()) <=
+            maxAngle.Degrees()); // NOTE: dynamic_cast is slow and not important here.
+}
+
+void SkyPoint::setBendLightSun(const KSSun *sun)
+{
+    m_ThreadSun = sun;
+}
+
+const KSSun *SkyPoint::bendLightSun()
+{
+    if (m_ThreadSun)
+        return m_ThreadSun;
+
     if (!m_Sun)
     {
         SkyComposite *skycomopsite = KStarsData::Instance()->skyComposite();
 
         if (skycomopsite == nullptr)
-            return false;
+            return nullptr;
 
         m_Sun = dynamic_cast<KSSun *>(skycomopsite->findByName(i18n("Sun")));
-
-        if (m_Sun == nullptr)
-            return false;
     }
 
-    // TODO: This can be optimized further. We only need a ballpark estimate of the distance to the sun to start with.
-    return (fabs(angularDistanceTo(static_cast<const SkyPoint *>(m_Sun)).Degrees()) <=
-            maxAngle.Degrees()); // NOTE: dynamic_cast is slow and not important here.
+    return m_Sun;
 }
 
 bool SkyPoint::bendlight()
@@ -459,13 +474,14 @@ bool SkyPoint::bendlight()
     // the case. When the sun is not correctly initialized, rearth()
     // is not computed, so we just assume it is nominally equal to 1
     // AU to get a reasonable estimate.
-    Q_ASSERT(m_Sun);
-    double corr_sec = 1.75 * m_Sun->physicalSize() /
-                      ((std::isfinite(m_Sun->rearth()) ? m_Sun->rearth() : 1) * AU_KM *
-                       angularDistanceTo(static_cast<const SkyPoint *>(m_Sun)).sin());
+    const KSSun *sun = bendLightSun();
+    Q_ASSERT(sun);
+    double corr_sec = 1.75 * sun->physicalSize() /
+                      ((std::isfinite(sun->rearth()) ? sun->rearth() : 1) * AU_KM *
+                       angularDistanceTo(static_cast<const SkyPoint *>(sun)).sin());
     Q_ASSERT(corr_sec > 0);
 
-    SkyPoint sp = moveAway(*m_Sun, corr_sec);
+    SkyPoint sp = moveAway(*sun, corr_sec);
     setRA(sp.ra());
     setDec(sp.dec());
     return true;
@@ -727,6 +743,23 @@ void SkyPoint::apparentCoord(long double jd0, long double jdf)
     aberrate(&num);
 }
 
+void SkyPoint::apparentCoord(long double jd0, const KSNumbers *num)
+{
+    if (jd0 == J2000L)
+    {
+        RA  = RA0;
+        Dec = Dec0;
+        if (num->julianDay() != J2000L)
+            precess(num);
+    }
+    else
+        precessFromAnyEpoch(jd0, num->julianDay());
+    nutate(num);
+    if (Options::useRelativistic() && checkBendLight())
+        bendlight();
+    aberrate(num);
+}
+
 SkyPoint SkyPoint::catalogueCoord(long double jdf)
 {
     KSNumbers num(jdf);
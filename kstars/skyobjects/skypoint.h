@@ -423,6 +423,16 @@ class SkyPoint
          */
         void apparentCoord(long double jd0, long double jdf);
 
+        /**
+         * Same as apparentCoord(jd0, jdf) with jdf = num->julianDay(), but uses the
+         * time-dependent values already held by num instead of computing them again.
+         * Solar system bodies call this once per body on every update.
+         *
+         * @param jd0 Julian Day which identifies the original epoch
+         * @param num pointer to KSNumbers object for the final epoch
+         */
+        void apparentCoord(long double jd0, const KSNumbers *num);
+
         /**
          * Computes the J2000.0 catalogue coordinates for this SkyPoint using the epoch
          * removing aberration, nutation and precession
@@ -464,6 +474,13 @@ class SkyPoint
          */
         bool bendlight();
 
+        /**
+         * @short Bend light around sun instead of the Sun of the sky composite on the
+         * calling thread. Used to compute positions on worker threads while the Sun is
+         * updated. Pass nullptr to go back to the Sun of the sky composite.
+         */
+        static void setBendLightSun(const KSSun *sun);
+
         /**
          * @short Obtain a Skypoint with RA0 and Dec0 set from the RA, Dec
          * of this skypoint. Also set the RA0, Dec0 of this SkyPoint if not
@@ -804,6 +821,10 @@ class SkyPoint
         CachingDms RA, Dec;   //current true sky coordinates
         dms Alt, Az;
         static KSSun *m_Sun;
+        static thread_local const KSSun *m_ThreadSun;
+
+        /** @return the Sun to bend light around, nullptr if there is none. */
+        static const KSSun *bendLightSun();
 
 
         // long version of these epochs
@@ -289,7 +289,7 @@ void StarObject::updateCoords(const KSNumbers *num, bool, const CachingDms *, co
 
 bool StarObject::getIndexCoords(const double julianMillenia, CachingDms &ra, CachingDms &dec) const
 {
-    static double pmms;
+    double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
@@ -408,7 +408,7 @@ bool StarObject::getIndexCoords(const double julianMillenia, CachingDms &ra, Cac
 
 bool StarObject::getIndexCoords(const double julianMillenia, double *ra, double *dec) const
 {
-    static double pmms;
+    double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
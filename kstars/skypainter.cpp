@@ -22,6 +22,13 @@ SkyPainter::SkyPainter()
 {
 }
 
+void SkyPainter::drawSkyPolylineSegments(LineList *list, const QBitArray &segments, SkipHashList *skipList,
+                                         LineListLabel *label)
+{
+    Q_UNUSED(segments)
+    drawSkyPolyline(list, skipList, label);
+}
+
 void SkyPainter::setSizeMagLimit(float sizeMagLim)
 {
     m_sizeMagLim = sizeMagLim;
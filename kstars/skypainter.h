@@ -10,6 +10,7 @@
 #include "skycomponents/typedef.h"
 #include "config-kstars.h"
 
+#include <QBitArray>
 #include <QList>
 #include <QPainter>
 
@@ -51,6 +52,7 @@ class SkyPainter
 
         //FIXME: find a better way to do this.
         void setSizeMagLimit(float sizeMagLim);
+        float sizeMagLimit() const { return m_sizeMagLim; }
 
         /**
          * Begin painting.
@@ -96,6 +98,18 @@ class SkyPainter
         virtual void drawSkyPolyline(LineList *list, SkipHashList *skipList = nullptr,
                                      LineListLabel *label = nullptr) = 0;
 
+        /**
+         * @short Draw some of the segments of a polyline in the sky.
+         * @param list a list of points in the sky
+         * @param segments the segments to draw, segment i joins points i - 1 and i.
+         * Points that only belong to segments that are not drawn need not be projected.
+         * @param skipList a SkipList object used to control skipping line segments
+         * @param label a pointer to the label for this line
+         * @note the default implementation draws the whole polyline.
+         */
+        virtual void drawSkyPolylineSegments(LineList *list, const QBitArray &segments,
+                                             SkipHashList *skipList = nullptr, LineListLabel *label = nullptr);
+
         /**
          * @short Draw a polygon in the sky.
          * @param list a list of points in the sky
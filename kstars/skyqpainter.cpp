@@ -86,6 +86,11 @@ const int nSPclasses = 7;
 // These pixmaps are never deallocated. Not really good...
 QPixmap *imageCache[nSPclasses][nStarSizes] = { { nullptr } };
 
+// The same star images for painters that draw to a QImage. Pixmaps must not be used outside
+// of the GUI thread, where the star layer may be drawn, and an image is drawn to an image
+// without any conversion.
+QImage starImageCache[nSPclasses][nStarSizes];
+
 std::unique_ptr<QPixmap> visibleSatPixmap, invisibleSatPixmap;
 } // namespace
 
@@ -105,6 +110,7 @@ void SkyQPainter::releaseImageCache()
                 delete pmap[size];
 
             pmap[size] = nullptr;
+            starImageCache[harvardToIndex(color)][size] = QImage();
         }
     }
 }
@@ -152,6 +158,7 @@ void SkyQPainter::begin()
     setRenderHint(QPainter::Antialiasing, aa);
     setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform | QPainter::TextAntialiasing, aa);
     m_proj = SkyMap::Instance()->projector();
+    m_imageStars = m_pd->devType() == QInternal::Image;
 }
 
 void SkyQPainter::end()
@@ -357,6 +364,7 @@ void SkyQPainter::initStarImages()
                 pmap[size] = new QPixmap();
             *pmap[size] = BigImage.scaled(size, size, Qt::KeepAspectRatio,
                                           Qt::SmoothTransformation);
+            starImageCache[harvardToIndex(color)][size] = pmap[size]->toImage();
         }
     }
     starColorMode = Options::starColorMode();
@@ -395,56 +403,70 @@ void SkyQPainter::drawSkyLine(SkyPoint * a, SkyPoint * b)
 
 void SkyQPainter::drawSkyPolyline(LineList * list, SkipHashList * skipList,
                                   LineListLabel * label)
+{
+    drawPolylineRuns(list, nullptr, skipList, label);
+}
+
+void SkyQPainter::drawSkyPolylineSegments(LineList * list, const QBitArray &segments,
+        SkipHashList * skipList, LineListLabel * label)
+{
+    drawPolylineRuns(list, &segments, skipList, label);
+}
+
+void SkyQPainter::drawPolylineRuns(LineList * list, const QBitArray * segments,
+                                   SkipHashList * skipList, LineListLabel * label)
 {
     SkyList *points = list->points();
-    bool isVisible, isVisibleLast;
+    const int n     = points->size();
 
-    if (points->size() == 0)
+    if (n == 0)
         return;
-    QPointF oLast = m_proj->toScreen(points->first().get(), true, &isVisibleLast);
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(points->first().get());
-    QPointF oThis, oThis2;
 
-    for (int j = 1; j < points->size(); j++)
+    // Project the whole list first, then draw each run of visible segments with one call.
+    m_Polyline.resize(n);
+    m_PolylineVisible.resize(n);
+    for (int j = 0; j < n; j++)
     {
-        SkyPoint *pThis = points->at(j).get();
-
-        oThis2 = oThis = m_proj->toScreen(pThis, true, &isVisible);
-        // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
-        bool doSkip = false;
-        if (skipList)
+        // Points of segments that are not drawn are not needed
+        if (segments && !segments->testBit(j) && (j + 1 == n || !segments->testBit(j + 1)))
         {
-            doSkip = skipList->skip(j);
+            m_PolylineVisible[j] = false;
+            continue;
         }
 
-        bool pointsVisible = false;
-        //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
-        if (SkyMap::Instance()->projector()->type() == Projector::Gnomonic)
-        {
-            if (isVisible && isVisibleLast)
-                pointsVisible = true;
-        }
-        else
+        SkyPoint *p = points->at(j).get();
+        bool isVisible;
+        m_Polyline[j] = m_proj->toScreen(p, true, &isVisible);
+        // & with the result of checkVisibility to clip away things below horizon
+        m_PolylineVisible[j] = isVisible && m_proj->checkVisibility(p);
+    }
+
+    //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
+    const bool gnomonic = m_proj->type() == Projector::Gnomonic;
+
+    int runStart = -1;
+    for (int j = 1; j < n; j++)
+    {
+        const bool isVisible = m_PolylineVisible[j], isVisibleLast = m_PolylineVisible[j - 1];
+        const bool pointsVisible = gnomonic ? (isVisible && isVisibleLast) : (isVisible || isVisibleLast);
+        const bool doSkip = (skipList && skipList->skip(j)) || (segments && !segments->testBit(j));
+
+        if (pointsVisible && !doSkip)
         {
-            if (isVisible || isVisibleLast)
-                pointsVisible = true;
+            if (runStart < 0)
+                runStart = j - 1;
+            if (label)
+                label->updateLabelCandidates(m_Polyline[j].x(), m_Polyline[j].y(), list, j);
         }
-
-        if (!doSkip)
+        else if (runStart >= 0)
         {
-            if (pointsVisible)
-            {
-                drawLine(oLast, oThis);
-                if (label)
-                    label->updateLabelCandidates(oThis.x(), oThis.y(), list, j);
-            }
+            drawPolyline(m_Polyline.constData() + runStart, j - runStart);
+            runStart = -1;
         }
-
-        oLast         = oThis2;
-        isVisibleLast = isVisible;
     }
+
+    if (runStart >= 0)
+        drawPolyline(m_Polyline.constData() + runStart, n - runStart);
 }
 
 void SkyQPainter::drawSkyPolygon(LineList * list, bool forceClip)
@@ -739,9 +761,18 @@ void SkyQPainter::drawPointSource(const QPointF &pos, float size, char sp)
     if (!m_vectorStars || starColorMode == 0)
     {
         // Draw stars as bitmaps, either because we were asked to, or because we're painting real colors
-        QPixmap *im  = imageCache[harvardToIndex(sp)][isize];
-        float offset = 0.5 * im->width();
-        drawPixmap(QPointF(pos.x() - offset, pos.y() - offset), *im);
+        if (m_imageStars)
+        {
+            const QImage &im = starImageCache[harvardToIndex(sp)][isize];
+            float offset     = 0.5 * im.width();
+            drawImage(QPointF(pos.x() - offset, pos.y() - offset), im);
+        }
+        else
+        {
+            QPixmap *im  = imageCache[harvardToIndex(sp)][isize];
+            float offset = 0.5 * im->width();
+            drawPixmap(QPointF(pos.x() - offset, pos.y() - offset), *im);
+        }
     }
     else
     {
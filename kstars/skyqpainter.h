@@ -12,6 +12,8 @@
 
 #include <QColor>
 #include <QMap>
+#include <QPolygonF>
+#include <QVector>
 
 class Projector;
 class QWidget;
@@ -86,6 +88,8 @@ class SkyQPainter : public SkyPainter, public QPainter
         void drawSkyLine(SkyPoint *a, SkyPoint *b) override;
         void drawSkyPolyline(LineList *list, SkipHashList *skipList = nullptr,
                              LineListLabel *label = nullptr) override;
+        void drawSkyPolylineSegments(LineList *list, const QBitArray &segments, SkipHashList *skipList = nullptr,
+                                     LineListLabel *label = nullptr) override;
         void drawSkyPolygon(LineList *list, bool forceClip = true) override;
         bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') override;
         bool drawCatalogObject(const CatalogObject &obj) override;
@@ -116,13 +120,21 @@ class SkyQPainter : public SkyPainter, public QPainter
 
     private:
         QColor skyColor() const;
+        /** Draws the runs of visible segments of list, only those set in segments if given */
+        void drawPolylineRuns(LineList *list, const QBitArray *segments, SkipHashList *skipList,
+                              LineListLabel *label);
         QPaintDevice *m_pd{ nullptr };
         const Projector *m_proj{ nullptr };
         bool m_vectorStars{ false };
+        /** Draw stars from the image cache, set by begin() when painting to a QImage */
+        bool m_imageStars{ false };
         HIPSRenderer *m_hipsRender{ nullptr };
         TerrainRenderer *m_terrainRender{ nullptr };
         QSize m_size;
         QScopedPointer<QImage> m_HiPSImage;
+        /** Projection of the line list being drawn by drawSkyPolyline(), kept to avoid reallocations */
+        QPolygonF m_Polyline;
+        QVector<bool> m_PolylineVisible;
         static int starColorMode;
         static QColor m_starColor;
         static QMap<char, QColor> ColorMap;